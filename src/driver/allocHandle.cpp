@@ -66,8 +66,9 @@ SQLRETURN SQL_API SQLAllocHandle(SQLSMALLINT HandleType,
       }
       WriteLog(LL_TRACE, "  Constructing statement handle");
       Connection* connection = reinterpret_cast<Connection*>(InputHandle);
-      Statement* statement   = new Statement(connection->connectionConfig);
-      *OutputHandle          = reinterpret_cast<SQLHANDLE>(statement);
+      Statement* statement =
+          connection->statementPool.acquire(connection->connectionConfig);
+      *OutputHandle = reinterpret_cast<SQLHANDLE>(statement);
       return SQL_SUCCESS;
     }
 
@@ -32,12 +32,16 @@ SQLRETURN SQL_API SQLBindCol(SQLHSTMT StatementHandle,
   WriteLog(LL_TRACE, "Entering SQLBindCol");
   WriteLog(LL_TRACE, "  Column Number is: " + std::to_string(ColumnNumber));
   WriteLog(LL_TRACE, "  Target Type is: " + std::to_string(TargetType));
-  Statement* statement  = reinterpret_cast<Statement*>(StatementHandle);
-  DescriptorField field = statement->getRowDescriptor()->getField(ColumnNumber);
-  field.bufferCDataType = TargetType;
-  field.bufferPtr       = TargetValuePtr;
-  field.bufferLength    = BufferLength;
-  field.bufferStrLenOrIndPtr = StrLen_or_Ind;
-  statement->getRowDescriptor()->setField(ColumnNumber, field);
+  Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+  DescriptorBinding& binding =
+      statement->getRowDescriptor()->editBinding(ColumnNumber);
+  binding.bufferCDataType      = TargetType;
+  binding.bufferPtr            = TargetValuePtr;
+  binding.bufferLength         = BufferLength;
+  binding.bufferStrLenOrIndPtr = StrLen_or_Ind;
+  if (TargetValuePtr and ColumnNumber > 0) {
+    statement->trinoQuery->markColumnInUse(ColumnNumber - 1);
+  }
   return SQL_SUCCESS;
 }
@@ -2,6 +2,8 @@
 #include <sql.h>
 #include <sqlext.h>
 
+#include <string>
+
 #include "../util/writeLog.hpp"
 #include "handles/statementHandle.hpp"
 
@@ -15,9 +17,49 @@ SQLRETURN SQL_API SQLBindParameter(SQLHSTMT StatementHandle,
                                    SQLPOINTER rgbValue,
                                    SQLLEN cbValueMax,
                                    SQLLEN* pcbValue) {
+  /*
+  Binding a parameter works a lot like binding a column with SQLBindCol,
+  just in the other direction. The application's buffers are recorded
+  in the parameter descriptor, and read when the statement executes.
+
+  fCType is the C type of the application's buffer, and fSqlType is
+  the SQL type the value should have in the statement. cbColDef and
+  ibScale are the column size and decimal digits of that SQL type.
+  */
   WriteLog(LL_TRACE, "Entering SQLBindParameter");
+  if (!StatementHandle) {
+    WriteLog(LL_ERROR, "  ERROR: Invalid statement handle");
+    return SQL_INVALID_HANDLE;
+  }
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
-  // This could probably look a lot like the SQLBindCol function.
-  WriteLog(LL_ERROR, "  ERROR: SQLBindParameter is unimplemented");
-  return SQL_ERROR;
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+  WriteLog(LL_TRACE, "  Parameter Number is: " + std::to_string(ipar));
+
+  if (ipar < 1) {
+    ErrorInfo errorInfo("Invalid descriptor index", "07009");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  }
+  // Trino has no output parameters, so only input is meaningful.
+  if (fParamType != SQL_PARAM_INPUT) {
+    WriteLog(LL_ERROR, "  ERROR: Only input parameters are supported");
+    ErrorInfo errorInfo("Optional feature not implemented", "HYC00");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  }
+
+  Descriptor* paramDescriptor  = statement->getParamDescriptor();
+  DescriptorBinding& binding   = paramDescriptor->editBinding(ipar);
+  binding.bufferCDataType      = fCType;
+  binding.odbcDataType         = fSqlType;
+  binding.bufferPtr            = rgbValue;
+  binding.bufferLength         = cbValueMax;
+  binding.bufferStrLenOrIndPtr = pcbValue;
+  binding.scale                = static_cast<SQLCHAR>(ibScale);
+  paramDescriptor->editMetadata(ipar).length =
+      static_cast<SQLINTEGER>(cbColDef);
+  if (ipar > paramDescriptor->Field_Count) {
+    paramDescriptor->Field_Count = ipar;
+  }
+  return SQL_SUCCESS;
 }
@@ -8,12 +8,15 @@
 SQLRETURN SQL_API SQLCancel(SQLHSTMT StatementHandle) {
   WriteLog(LL_TRACE, "Entering SQLCancel");
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
   WriteLog(LL_INFO, "  Canceling current trino query");
   // It seems like statement->trinoQuery->cancel() would make more sense
-  // here, but in my testing, terminating the query seemed
-  // to behave better. It stopped it instantly, and showed
+  // here, but in my testing, a DELETE to the nextUri, as terminate
+  // sends, behaved better. It stopped the query instantly, and showed
   // USER_CANCELED as the status in the Trino UI.
-  statement->terminate();
+  // This is safe to call while another thread is using the statement,
+  // and doesn't wait for that thread to notice.
+  statement->cancel();
   WriteLog(LL_INFO, "  Query cancellation completed");
   return SQL_SUCCESS;
 }
@@ -16,7 +16,8 @@ SQLRETURN SQL_API SQLCancelHandle(SQLSMALLINT HandleType,
       // write the code anyway.
       WriteLog(LL_WARN, "  Canceling statement handle");
       Statement* statement = reinterpret_cast<Statement*>(InputHandle);
-      statement->terminate();
+      LogLevelScope logScope(statement->connectionConfig->logLevel);
+      statement->cancel();
       break;
     }
     case SQL_HANDLE_DBC: {
@@ -8,6 +8,15 @@
 SQLRETURN SQL_API SQLCloseCursor(SQLHSTMT StatementHandle) {
   WriteLog(LL_TRACE, "Entering SQLCloseCursor");
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
-  WriteLog(LL_ERROR, "  ERROR: SQLCloseCursor is unimplemented");
-  return SQL_ERROR;
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+  // Unlike SQLFreeStmt with SQL_CLOSE, this is an error without an open
+  // cursor.
+  if (not statement->executed) {
+    WriteLog(LL_ERROR, "  ERROR: SQLCloseCursor called with no open cursor");
+    ErrorInfo errorInfo("Invalid cursor state", "24000");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  }
+  statement->closeCursor();
+  return SQL_SUCCESS;
 }
@@ -1,7 +1,9 @@
 #include "../util/windowsLean.hpp"
 #include <sql.h>
 #include <sqlext.h>
+#include <sqlucode.h>
 
+#include <optional>
 #include <string>
 
 #include "../util/valuePtrHelper.hpp"
@@ -9,47 +11,24 @@
 #include "handles/statementHandle.hpp"
 #include "mappings/typeMappings.hpp"
 
-#pragma warning(push)
 /*
-The CharacterAttributePtr and NumericAttributePtr fields may
-be unused if they aren't relevant to the requested attribute/column.
-This is a documented expectation for these out parameters, so we'll
-disable the warning about returning uninitialized memory in an out
-parameter.
-https://learn.microsoft.com/en-us/sql/odbc/reference/syntax/sqlcolattribute-function
+Look up a column attribute. Numeric attributes are written directly to
+NumericAttributePtr. String attributes are handed back through
+stringAttribute, since the narrow and wide entry points encode them
+differently.
 */
-#pragma warning(disable : 6101)
-
-/*
- The signature of this function differs between 64-bit and 32-bit
- targets. For 32-bit, NumericAttributePtr is a SQLPOINTER, but for
- 64-bit, its a SQLLEN*.
- */
-#if defined(_WIN64)
-SQLRETURN SQL_API SQLColAttribute(SQLHSTMT StatementHandle,
-                                  SQLUSMALLINT ColumnNumber,
-                                  SQLUSMALLINT FieldIdentifier,
-                                  _Out_writes_bytes_opt_(BufferLength)
-                                      SQLPOINTER CharacterAttributePtr,
-                                  SQLSMALLINT BufferLength,
-                                  _Out_opt_ SQLSMALLINT* StringLengthPtr,
-                                  _Out_opt_ SQLLEN* NumericAttributePtr) {
-#else
-SQLRETURN SQL_API SQLColAttribute(SQLHSTMT StatementHandle,
-                                  SQLUSMALLINT ColumnNumber,
-                                  SQLUSMALLINT FieldIdentifier,
-                                  _Out_writes_bytes_opt_(BufferLength)
-                                      SQLPOINTER CharacterAttributePtr,
-                                  SQLSMALLINT BufferLength,
-                                  _Out_opt_ SQLSMALLINT* StringLengthPtr,
-                                  _Out_opt_ SQLPOINTER NumericAttributePtr) {
-#endif
-#pragma warning(pop)
-  WriteLog(LL_TRACE, "Entering SQLColAttribute");
+static SQLRETURN
+getColumnAttribute(SQLHSTMT StatementHandle,
+                   SQLUSMALLINT ColumnNumber,
+                   SQLUSMALLINT FieldIdentifier,
+                   SQLPOINTER NumericAttributePtr,
+                   std::optional<std::string>& stringAttribute) {
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
 
-  Descriptor* ird            = statement->impRowDesc;
-  DescriptorField columnInfo = ird->getField(ColumnNumber);
+  Descriptor* ird                      = statement->impRowDesc;
+  const DescriptorBinding& binding     = ird->getBinding(ColumnNumber);
+  const DescriptorMetadata& columnInfo = ird->getMetadata(ColumnNumber);
 
   switch (FieldIdentifier) {
     case SQL_DESC_CONCISE_TYPE: { // 2
@@ -73,9 +52,7 @@ SQLRETURN SQL_API SQLColAttribute(SQLHSTMT StatementHandle,
     }
     case SQL_COLUMN_TYPE_NAME: { // 14
       WriteLog(LL_TRACE, "  Getting SQL column name");
-      std::string columnTypeName = columnInfo.trinoRawTypeName;
-      writeNullTermStringToPtr(
-          CharacterAttributePtr, columnTypeName, StringLengthPtr);
+      stringAttribute = columnInfo.trinoRawTypeName;
       break;
     }
     case SQL_DESC_NUM_PREC_RADIX: { // 32
@@ -97,14 +74,14 @@ SQLRETURN SQL_API SQLColAttribute(SQLHSTMT StatementHandle,
     case SQL_DESC_PRECISION: { // 1005
       WriteLog(LL_TRACE, "  Getting SQL column precision");
       if (NumericAttributePtr) {
-        *((SQLINTEGER*)NumericAttributePtr) = columnInfo.precision;
+        *((SQLINTEGER*)NumericAttributePtr) = binding.precision;
       }
       break;
     }
     case SQL_DESC_SCALE: { // 1006
       WriteLog(LL_TRACE, "  Getting SQL column scale");
       if (NumericAttributePtr) {
-        *((SQLINTEGER*)NumericAttributePtr) = columnInfo.scale;
+        *((SQLINTEGER*)NumericAttributePtr) = binding.scale;
       }
       break;
     }
@@ -117,9 +94,7 @@ SQLRETURN SQL_API SQLColAttribute(SQLHSTMT StatementHandle,
     }
     case SQL_DESC_NAME: { // 1011
       WriteLog(LL_TRACE, "  Getting SQL column name");
-      std::string columnName = columnInfo.columnName;
-      writeNullTermStringToPtr(
-          CharacterAttributePtr, columnName, StringLengthPtr);
+      stringAttribute = columnInfo.columnName;
       break;
     }
     case SQL_DESC_UNNAMED: { // 1012
@@ -149,3 +124,99 @@ SQLRETURN SQL_API SQLColAttribute(SQLHSTMT StatementHandle,
 
   return SQL_SUCCESS;
 }
+
+#pragma warning(push)
+/*
+The CharacterAttributePtr and NumericAttributePtr fields may
+be unused if they aren't relevant to the requested attribute/column.
+This is a documented expectation for these out parameters, so we'll
+disable the warning about returning uninitialized memory in an out
+parameter.
+https://learn.microsoft.com/en-us/sql/odbc/reference/syntax/sqlcolattribute-function
+*/
+#pragma warning(disable : 6101)
+
+/*
+ The signature of this function differs between 64-bit and 32-bit
+ targets. For 32-bit, NumericAttributePtr is a SQLPOINTER, but for
+ 64-bit, its a SQLLEN*.
+ */
+#if defined(_WIN64)
+SQLRETURN SQL_API SQLColAttribute(SQLHSTMT StatementHandle,
+                                  SQLUSMALLINT ColumnNumber,
+                                  SQLUSMALLINT FieldIdentifier,
+                                  _Out_writes_bytes_opt_(BufferLength)
+                                      SQLPOINTER CharacterAttributePtr,
+                                  SQLSMALLINT BufferLength,
+                                  _Out_opt_ SQLSMALLINT* StringLengthPtr,
+                                  _Out_opt_ SQLLEN* NumericAttributePtr) {
+#else
+SQLRETURN SQL_API SQLColAttribute(SQLHSTMT StatementHandle,
+                                  SQLUSMALLINT ColumnNumber,
+                                  SQLUSMALLINT FieldIdentifier,
+                                  _Out_writes_bytes_opt_(BufferLength)
+                                      SQLPOINTER CharacterAttributePtr,
+                                  SQLSMALLINT BufferLength,
+                                  _Out_opt_ SQLSMALLINT* StringLengthPtr,
+                                  _Out_opt_ SQLPOINTER NumericAttributePtr) {
+#endif
+#pragma warning(pop)
+  WriteLog(LL_TRACE, "Entering SQLColAttribute");
+  std::optional<std::string> stringAttribute;
+  SQLRETURN ret = getColumnAttribute(StatementHandle,
+                                     ColumnNumber,
+                                     FieldIdentifier,
+                                     NumericAttributePtr,
+                                     stringAttribute);
+  if (stringAttribute) {
+    writeNullTermStringToPtr(
+        CharacterAttributePtr, *stringAttribute, StringLengthPtr);
+  }
+  return ret;
+}
+
+#pragma warning(push)
+// See SQLColAttribute for why this warning is disabled.
+#pragma warning(disable : 6101)
+
+#if defined(_WIN64)
+SQLRETURN SQL_API SQLColAttributeW(SQLHSTMT StatementHandle,
+                                   SQLUSMALLINT ColumnNumber,
+                                   SQLUSMALLINT FieldIdentifier,
+                                   _Out_writes_bytes_opt_(BufferLength)
+                                       SQLPOINTER CharacterAttributePtr,
+                                   SQLSMALLINT BufferLength,
+                                   _Out_opt_ SQLSMALLINT* StringLengthPtr,
+                                   _Out_opt_ SQLLEN* NumericAttributePtr) {
+#else
+SQLRETURN SQL_API SQLColAttributeW(SQLHSTMT StatementHandle,
+                                   SQLUSMALLINT ColumnNumber,
+                                   SQLUSMALLINT FieldIdentifier,
+                                   _Out_writes_bytes_opt_(BufferLength)
+                                       SQLPOINTER CharacterAttributePtr,
+                                   SQLSMALLINT BufferLength,
+                                   _Out_opt_ SQLSMALLINT* StringLengthPtr,
+                                   _Out_opt_ SQLPOINTER NumericAttributePtr) {
+#endif
+#pragma warning(pop)
+  /*
+  BufferLength and StringLengthPtr are in bytes for this function, even
+  in the wide variant, so they're converted to and from characters here.
+  */
+  WriteLog(LL_TRACE, "Entering SQLColAttributeW");
+  std::optional<std::string> stringAttribute;
+  SQLRETURN ret = getColumnAttribute(StatementHandle,
+                                     ColumnNumber,
+                                     FieldIdentifier,
+                                     NumericAttributePtr,
+                                     stringAttribute);
+  if (stringAttribute) {
+    SQLLEN bufferChars = BufferLength / static_cast<SQLLEN>(sizeof(SQLWCHAR));
+    size_t chars       = writeNullTermWideStringToPtr(
+        CharacterAttributePtr, *stringAttribute, bufferChars);
+    if (StringLengthPtr) {
+      *StringLengthPtr = static_cast<SQLSMALLINT>(chars * sizeof(SQLWCHAR));
+    }
+  }
+  return ret;
+}
@@ -4,6 +4,7 @@
 
 #include "../util/stringFromChar.hpp"
 #include "../util/writeLog.hpp"
+#include "execution/catalogQuery.hpp"
 #include "handles/statementHandle.hpp"
 
 std::string constructColumnQuery(std::string catalog,
@@ -122,6 +123,7 @@ SQLColumns(SQLHSTMT StatementHandle,
     return SQL_INVALID_HANDLE;
   }
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
 
   std::string catalogName = stringFromChar(CatalogNameChars, NameLength1);
   std::string schemaName  = stringFromChar(SchemaNameChars, NameLength2);
@@ -135,8 +137,24 @@ SQLColumns(SQLHSTMT StatementHandle,
 
   std::string query =
       constructColumnQuery(catalogName, schemaName, tableName, columnName);
-  statement->trinoQuery->setQuery(query);
-  statement->trinoQuery->post();
-  statement->executed = true;
-  return SQL_SUCCESS;
+
+  // Navigators ask for the columns of one table at a time, usually for
+  // every table in a schema. That's the call schema prefetch answers.
+  bool isSingleTable = not catalogName.empty() and not schemaName.empty() and
+                       not tableName.empty() and columnName.empty() and
+                       catalogName.find('%') == std::string::npos and
+                       schemaName.find('%') == std::string::npos and
+                       tableName.find('%') == std::string::npos;
+  if (isSingleTable) {
+    std::string schemaQuery =
+        constructColumnQuery(catalogName, schemaName, "", "");
+    return runSchemaCatalogQuery(
+        statement,
+        query,
+        schemaQuery,
+        [&catalogName, &schemaName](const std::string& siblingName) {
+          return constructColumnQuery(catalogName, schemaName, siblingName, "");
+        });
+  }
+  return runCatalogQuery(statement, query);
 }
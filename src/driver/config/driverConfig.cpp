@@ -2,6 +2,8 @@
 #include "../../util/capitalize.hpp"
 #include "../../util/writeLog.hpp"
 
+#include <charconv>
+
 
 std::vector<std::string> LOG_LEVEL_NAMES = {
     "None", "Error", "Warn", "Info", "Debug", "Trace"};
@@ -57,8 +59,39 @@ std::map<std::string, std::string> DRIVER_CONFIG_DEFAULT_VALUES = {
     std::make_pair("clientSecret", ""),
     std::make_pair("oidcScope", ""),
     std::make_pair("secretEncryptionLevel", "user"),
+    std::make_pair("metadataCacheTTL", "60"),
+    std::make_pair("metadataCacheSize", "256"),
+    std::make_pair("schemaPrefetch", "false"),
+    std::make_pair("resultCacheTTL", "0"),
+    std::make_pair("resultCacheSize", "256"),
+    std::make_pair("resultCacheDir", ""),
+    std::make_pair("statementBufferLimit", "0"),
+    std::make_pair("connectionBufferLimit", "0"),
+    std::make_pair("segmentDownloadThreads", "4"),
+    std::make_pair("spoolingEncoding", "json+zstd,json+lz4,json"),
 };
 
+/*
+Parse a whole number setting. An empty or malformed value, like a DSN
+entry that was cleared, falls back to the setting's default rather
+than throwing out of SQLConnect or SQLDriverConnect.
+*/
+static uint32_t parseNumberSetting(const std::string& name,
+                                   const std::string& value) {
+  uint32_t number  = 0;
+  const char* last = value.data() + value.size();
+
+  std::from_chars_result result = std::from_chars(value.data(), last, number);
+  if (result.ec == std::errc() and result.ptr == last) {
+    return number;
+  }
+  const std::string& defaultValue = DRIVER_CONFIG_DEFAULT_VALUES.at(name);
+  WriteLog(LL_WARN,
+           "  Invalid value for " + name + ": \"" + value +
+               "\". Using the default, " + defaultValue);
+  return static_cast<uint32_t>(std::stoul(defaultValue));
+}
+
 // DSN
 std::string DriverConfig::getDSN() {
   return this->dsn;
@@ -159,6 +192,114 @@ void DriverConfig::setOidcScope(std::string oidcScope) {
   this->oidcScope = oidcScope;
 }
 
+// Metadata Cache TTL
+std::string DriverConfig::getMetadataCacheTTLStr() {
+  return std::to_string(this->metadataCacheTTL);
+}
+uint32_t DriverConfig::getMetadataCacheTTLNum() {
+  return this->metadataCacheTTL;
+}
+void DriverConfig::setMetadataCacheTTL(std::string seconds) {
+  this->metadataCacheTTL = parseNumberSetting("metadataCacheTTL", seconds);
+}
+
+// Metadata Cache Size
+std::string DriverConfig::getMetadataCacheSizeStr() {
+  return std::to_string(this->metadataCacheSize);
+}
+uint32_t DriverConfig::getMetadataCacheSizeNum() {
+  return this->metadataCacheSize;
+}
+void DriverConfig::setMetadataCacheSize(std::string entries) {
+  this->metadataCacheSize = parseNumberSetting("metadataCacheSize", entries);
+}
+
+// Schema Prefetch
+std::string DriverConfig::getSchemaPrefetchStr() {
+  return this->schemaPrefetch ? "true" : "false";
+}
+bool DriverConfig::getSchemaPrefetchBool() {
+  return this->schemaPrefetch;
+}
+void DriverConfig::setSchemaPrefetch(std::string enabled) {
+  std::string casedEnabled = capitalizedCase(enabled);
+  this->schemaPrefetch     = casedEnabled == "True" or casedEnabled == "1";
+}
+
+// Result Cache TTL
+std::string DriverConfig::getResultCacheTTLStr() {
+  return std::to_string(this->resultCacheTTL);
+}
+uint32_t DriverConfig::getResultCacheTTLNum() {
+  return this->resultCacheTTL;
+}
+void DriverConfig::setResultCacheTTL(std::string seconds) {
+  this->resultCacheTTL = parseNumberSetting("resultCacheTTL", seconds);
+}
+
+// Result Cache Size
+std::string DriverConfig::getResultCacheSizeStr() {
+  return std::to_string(this->resultCacheSize);
+}
+uint32_t DriverConfig::getResultCacheSizeNum() {
+  return this->resultCacheSize;
+}
+void DriverConfig::setResultCacheSize(std::string megabytes) {
+  this->resultCacheSize = parseNumberSetting("resultCacheSize", megabytes);
+}
+
+// Result Cache Directory
+std::string DriverConfig::getResultCacheDir() {
+  return this->resultCacheDir;
+}
+void DriverConfig::setResultCacheDir(std::string directory) {
+  this->resultCacheDir = directory;
+}
+
+// Statement Buffer Limit
+std::string DriverConfig::getStatementBufferLimitStr() {
+  return std::to_string(this->statementBufferLimit);
+}
+uint32_t DriverConfig::getStatementBufferLimitNum() {
+  return this->statementBufferLimit;
+}
+void DriverConfig::setStatementBufferLimit(std::string megabytes) {
+  this->statementBufferLimit =
+      parseNumberSetting("statementBufferLimit", megabytes);
+}
+
+// Connection Buffer Limit
+std::string DriverConfig::getConnectionBufferLimitStr() {
+  return std::to_string(this->connectionBufferLimit);
+}
+uint32_t DriverConfig::getConnectionBufferLimitNum() {
+  return this->connectionBufferLimit;
+}
+void DriverConfig::setConnectionBufferLimit(std::string megabytes) {
+  this->connectionBufferLimit =
+      parseNumberSetting("connectionBufferLimit", megabytes);
+}
+
+// Segment Download Threads
+std::string DriverConfig::getSegmentDownloadThreadsStr() {
+  return std::to_string(this->segmentDownloadThreads);
+}
+uint32_t DriverConfig::getSegmentDownloadThreadsNum() {
+  return this->segmentDownloadThreads;
+}
+void DriverConfig::setSegmentDownloadThreads(std::string threads) {
+  this->segmentDownloadThreads =
+      parseNumberSetting("segmentDownloadThreads", threads);
+}
+
+// Spooling Encoding
+std::string DriverConfig::getSpoolingEncoding() {
+  return this->spoolingEncoding;
+}
+void DriverConfig::setSpoolingEncoding(std::string encodings) {
+  this->spoolingEncoding = encodings;
+}
+
 // IsSaved
 bool DriverConfig::getIsSaved() {
   return this->isSaved;
@@ -219,6 +360,66 @@ DriverConfig driverConfigFromKVPs(std::map<std::string, std::string> kvps) {
   if (kvps.count("oidcscope")) {
     config.setOidcScope(kvps.at("oidcscope"));
   }
+  if (kvps.count("metadataCacheTTL")) {
+    config.setMetadataCacheTTL(kvps.at("metadataCacheTTL"));
+  }
+  if (kvps.count("metadatacachettl")) {
+    config.setMetadataCacheTTL(kvps.at("metadatacachettl"));
+  }
+  if (kvps.count("metadataCacheSize")) {
+    config.setMetadataCacheSize(kvps.at("metadataCacheSize"));
+  }
+  if (kvps.count("metadatacachesize")) {
+    config.setMetadataCacheSize(kvps.at("metadatacachesize"));
+  }
+  if (kvps.count("schemaPrefetch")) {
+    config.setSchemaPrefetch(kvps.at("schemaPrefetch"));
+  }
+  if (kvps.count("schemaprefetch")) {
+    config.setSchemaPrefetch(kvps.at("schemaprefetch"));
+  }
+  if (kvps.count("resultCacheTTL")) {
+    config.setResultCacheTTL(kvps.at("resultCacheTTL"));
+  }
+  if (kvps.count("resultcachettl")) {
+    config.setResultCacheTTL(kvps.at("resultcachettl"));
+  }
+  if (kvps.count("resultCacheSize")) {
+    config.setResultCacheSize(kvps.at("resultCacheSize"));
+  }
+  if (kvps.count("resultcachesize")) {
+    config.setResultCacheSize(kvps.at("resultcachesize"));
+  }
+  if (kvps.count("resultCacheDir")) {
+    config.setResultCacheDir(kvps.at("resultCacheDir"));
+  }
+  if (kvps.count("resultcachedir")) {
+    config.setResultCacheDir(kvps.at("resultcachedir"));
+  }
+  if (kvps.count("statementBufferLimit")) {
+    config.setStatementBufferLimit(kvps.at("statementBufferLimit"));
+  }
+  if (kvps.count("statementbufferlimit")) {
+    config.setStatementBufferLimit(kvps.at("statementbufferlimit"));
+  }
+  if (kvps.count("connectionBufferLimit")) {
+    config.setConnectionBufferLimit(kvps.at("connectionBufferLimit"));
+  }
+  if (kvps.count("connectionbufferlimit")) {
+    config.setConnectionBufferLimit(kvps.at("connectionbufferlimit"));
+  }
+  if (kvps.count("segmentDownloadThreads")) {
+    config.setSegmentDownloadThreads(kvps.at("segmentDownloadThreads"));
+  }
+  if (kvps.count("segmentdownloadthreads")) {
+    config.setSegmentDownloadThreads(kvps.at("segmentdownloadthreads"));
+  }
+  if (kvps.count("spoolingEncoding")) {
+    config.setSpoolingEncoding(kvps.at("spoolingEncoding"));
+  }
+  if (kvps.count("spoolingencoding")) {
+    config.setSpoolingEncoding(kvps.at("spoolingencoding"));
+  }
 
   return config;
 }
@@ -257,6 +458,18 @@ std::map<std::string, std::string> driverConfigToKVPs(DriverConfig config) {
   if (!config.getOidcScope().empty()) {
     kvps["oidcScope"] = config.getOidcScope();
   }
+  kvps["metadataCacheTTL"]       = config.getMetadataCacheTTLStr();
+  kvps["metadataCacheSize"]      = config.getMetadataCacheSizeStr();
+  kvps["schemaPrefetch"]         = config.getSchemaPrefetchStr();
+  kvps["resultCacheTTL"]         = config.getResultCacheTTLStr();
+  kvps["resultCacheSize"]        = config.getResultCacheSizeStr();
+  kvps["statementBufferLimit"]   = config.getStatementBufferLimitStr();
+  kvps["connectionBufferLimit"]  = config.getConnectionBufferLimitStr();
+  kvps["segmentDownloadThreads"] = config.getSegmentDownloadThreadsStr();
+  kvps["spoolingEncoding"]       = config.getSpoolingEncoding();
+  if (!config.getResultCacheDir().empty()) {
+    kvps["resultCacheDir"] = config.getResultCacheDir();
+  }
 
   return kvps;
 }
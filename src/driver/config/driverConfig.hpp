@@ -15,16 +15,26 @@ extern std::vector<std::string> AUTH_METHOD_NAMES;
 class DriverConfig {
   private:
     // Actual configuration values.
-    std::string dsn              = "";
-    std::string driver           = "";
-    std::string hostname         = "";
-    uint16_t port                = 0;
-    LogLevel logLevel            = LL_NONE;
-    ApiAuthMethod authMethod     = AM_NO_AUTH;
-    std::string oidcDiscoveryUrl = "";
-    std::string clientId         = "";
-    std::string clientSecret     = "";
-    std::string oidcScope        = "";
+    std::string dsn                 = "";
+    std::string driver              = "";
+    std::string hostname            = "";
+    uint16_t port                   = 0;
+    LogLevel logLevel               = LL_NONE;
+    ApiAuthMethod authMethod        = AM_NO_AUTH;
+    std::string oidcDiscoveryUrl    = "";
+    std::string clientId            = "";
+    std::string clientSecret        = "";
+    std::string oidcScope           = "";
+    uint32_t metadataCacheTTL       = 60;
+    uint32_t metadataCacheSize      = 256;
+    bool schemaPrefetch             = false;
+    uint32_t resultCacheTTL         = 0;
+    uint32_t resultCacheSize        = 256;
+    std::string resultCacheDir      = "";
+    uint32_t statementBufferLimit   = 0;
+    uint32_t connectionBufferLimit  = 0;
+    uint32_t segmentDownloadThreads = 4;
+    std::string spoolingEncoding    = "json+zstd,json+lz4,json";
 
     // Metadata describing the status of this config object.
     bool isSaved = false;
@@ -66,6 +76,57 @@ class DriverConfig {
     std::string getOidcScope();
     void setOidcScope(std::string oidcScope);
 
+    // How long, in seconds, catalog metadata results are reused.
+    std::string getMetadataCacheTTLStr();
+    uint32_t getMetadataCacheTTLNum();
+    void setMetadataCacheTTL(std::string seconds);
+
+    // How many catalog metadata results are kept per connection.
+    std::string getMetadataCacheSizeStr();
+    uint32_t getMetadataCacheSizeNum();
+    void setMetadataCacheSize(std::string entries);
+
+    // Whether SQLColumns loads a table's whole schema at once.
+    std::string getSchemaPrefetchStr();
+    bool getSchemaPrefetchBool();
+    void setSchemaPrefetch(std::string enabled);
+
+    // How long, in seconds, results of read-only queries are reused.
+    std::string getResultCacheTTLStr();
+    uint32_t getResultCacheTTLNum();
+    void setResultCacheTTL(std::string seconds);
+
+    // How many megabytes of results the process keeps in memory.
+    std::string getResultCacheSizeStr();
+    uint32_t getResultCacheSizeNum();
+    void setResultCacheSize(std::string megabytes);
+
+    // Where results are also kept on disk. Empty means nowhere.
+    std::string getResultCacheDir();
+    void setResultCacheDir(std::string directory);
+
+    // How many megabytes of rows a statement buffers before the rest
+    // spill to disk. Zero means there's no limit.
+    std::string getStatementBufferLimitStr();
+    uint32_t getStatementBufferLimitNum();
+    void setStatementBufferLimit(std::string megabytes);
+
+    // The same, for all of a connection's statements together.
+    std::string getConnectionBufferLimitStr();
+    uint32_t getConnectionBufferLimitNum();
+    void setConnectionBufferLimit(std::string megabytes);
+
+    // How many spooled result segments a connection downloads at once.
+    // Zero keeps Trino sending every row through the coordinator.
+    std::string getSegmentDownloadThreadsStr();
+    uint32_t getSegmentDownloadThreadsNum();
+    void setSegmentDownloadThreads(std::string threads);
+
+    // The spooled result encodings to ask for, best first, separated
+    // by commas.
+    std::string getSpoolingEncoding();
+    void setSpoolingEncoding(std::string encodings);
+
     bool getIsSaved();
     void setIsSaved(bool isSaved);
 };
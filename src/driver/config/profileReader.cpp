@@ -42,6 +42,20 @@ DriverConfig readDriverConfigFromProfile(std::string dsn) {
   config.setOidcDiscoveryUrl(readFromPrivateProfile(dsn, "oidcDiscoveryUrl"));
   config.setClientId(readFromPrivateProfile(dsn, "clientId"));
   config.setOidcScope(readFromPrivateProfile(dsn, "oidcScope"));
+  config.setMetadataCacheTTL(readFromPrivateProfile(dsn, "metadataCacheTTL"));
+  config.setMetadataCacheSize(
+      readFromPrivateProfile(dsn, "metadataCacheSize"));
+  config.setSchemaPrefetch(readFromPrivateProfile(dsn, "schemaPrefetch"));
+  config.setResultCacheTTL(readFromPrivateProfile(dsn, "resultCacheTTL"));
+  config.setResultCacheSize(readFromPrivateProfile(dsn, "resultCacheSize"));
+  config.setResultCacheDir(readFromPrivateProfile(dsn, "resultCacheDir"));
+  config.setStatementBufferLimit(
+      readFromPrivateProfile(dsn, "statementBufferLimit"));
+  config.setConnectionBufferLimit(
+      readFromPrivateProfile(dsn, "connectionBufferLimit"));
+  config.setSegmentDownloadThreads(
+      readFromPrivateProfile(dsn, "segmentDownloadThreads"));
+  config.setSpoolingEncoding(readFromPrivateProfile(dsn, "spoolingEncoding"));
 
   std::string secretEncryptionLevel =
       readFromPrivateProfile(dsn, "secretEncryptionLevel");
@@ -1,6 +1,7 @@
 #include "../util/windowsLean.hpp"
 #include <sql.h>
 #include <sqlext.h>
+#include <sqlucode.h>
 
 #include <string>
 
@@ -11,6 +12,21 @@
 #include "../util/writeLog.hpp"
 
 
+static SQLRETURN connectToDsn(Connection* connection, const std::string& dsn) {
+  DriverConfig config = readDriverConfigFromProfile(dsn);
+
+  // It's kind of unfortunate that we can't set the log level of the driver
+  // until we've read the DSN in some way. The connection's own calls log
+  // at its level, and other connections' aren't affected.
+  LogLevelScope logScope(config.getLogLevelEnum());
+  WriteLog(LL_TRACE, "  Log level set");
+
+  WriteLog(LL_TRACE, "  Configuring connection");
+  connection->configure(config);
+
+  return SQL_SUCCESS;
+}
+
 SQLRETURN SQL_API SQLConnect(SQLHDBC ConnectionHandle,
                              _In_reads_(NameLength1) SQLCHAR* DSNChars,
                              SQLSMALLINT NameLength1,
@@ -22,15 +38,25 @@ SQLRETURN SQL_API SQLConnect(SQLHDBC ConnectionHandle,
   WriteLog(LL_TRACE, "Entering SQLConnect");
   std::string dsn        = stringFromChar(DSNChars, NameLength1);
   Connection* connection = reinterpret_cast<Connection*>(ConnectionHandle);
-  DriverConfig config    = readDriverConfigFromProfile(dsn);
-
-  // It's kind of unfortunate that we can't set the log level of the driver
-  // until we've read the DSN in some way.
-  WriteLog(LL_TRACE, "  Setting Log Level");
-  setLogLevel(config.getLogLevelEnum());
-
-  WriteLog(LL_TRACE, "  Configuring connection");
-  connection->configure(config);
+  return connectToDsn(connection, dsn);
+}
 
-  return SQL_SUCCESS;
+SQLRETURN SQL_API SQLConnectW(SQLHDBC ConnectionHandle,
+                              _In_reads_(NameLength1) SQLWCHAR* DSNChars,
+                              SQLSMALLINT NameLength1,
+                              _In_reads_(NameLength2) SQLWCHAR* UserNameChars,
+                              SQLSMALLINT NameLength2,
+                              _In_reads_(NameLength3)
+                                  SQLWCHAR* AuthenticationChars,
+                              SQLSMALLINT NameLength3) {
+  /*
+  The driver manager only treats a driver as a Unicode driver if it
+  exports SQLConnectW, so this needs to exist for any of the other
+  wide entry points to be called directly.
+  */
+  WriteLog(LL_TRACE, "Entering SQLConnectW");
+  std::string dsn =
+      stringFromChar(reinterpret_cast<char16_t*>(DSNChars), NameLength1);
+  Connection* connection = reinterpret_cast<Connection*>(ConnectionHandle);
+  return connectToDsn(connection, dsn);
 }
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <sqlext.h>
+
+/*
+ Driver-defined connection attribute to throw away
+ cached catalog metadata. Setting it to any value
+ makes the next SQLTables or SQLColumns call go
+ back to the server, which is useful after creating
+ or altering tables on a long-lived connection.
+*/
+#define SQL_ATTR_METADATA_CACHE_INVALIDATE (SQL_DRIVER_CONN_ATTR_BASE + 1)
+
+/*
+ Driver-defined connection attributes to read the
+ result cache's hit and miss counts, as SQLULEN.
+ The counts cover every connection in the process,
+ since they all share one result cache.
+*/
+#define SQL_ATTR_RESULT_CACHE_HITS (SQL_DRIVER_CONN_ATTR_BASE + 2)
+#define SQL_ATTR_RESULT_CACHE_MISSES (SQL_DRIVER_CONN_ATTR_BASE + 3)
+
+/*
+ Driver-defined connection attributes to read how many
+ bytes of buffered rows all of the connection's
+ statements hold in memory, and the most they have
+ held at once, as SQLULEN.
+*/
+#define SQL_ATTR_CONNECTION_BUFFERED_BYTES (SQL_DRIVER_CONN_ATTR_BASE + 4)
+#define SQL_ATTR_CONNECTION_PEAK_BUFFERED_BYTES (SQL_DRIVER_CONN_ATTR_BASE + 5)
@@ -23,3 +23,20 @@
  fetch performance independent of poll performance.
 */
 #define SQL_ATTR_DEFAULT_FETCH_POLL_MODE 1002
+
+/*
+ Driver-defined statement attributes to read how many
+ bytes of buffered rows the statement holds in memory,
+ and the most it has held since it was executed, as
+ SQLULEN. Rows spilled to disk don't count, and spooled
+ segments still downloading count at their expected size.
+*/
+#define SQL_ATTR_BUFFERED_BYTES 1003
+#define SQL_ATTR_PEAK_BUFFERED_BYTES 1004
+
+/*
+ Driver-defined statement attribute to read how many
+ bytes of buffered rows the statement has spilled to
+ disk since it was executed, as SQLULEN.
+*/
+#define SQL_ATTR_SPILLED_BYTES 1005
@@ -1,9 +1,11 @@
 #include "../util/windowsLean.hpp"
 #include <sql.h>
 #include <sqlext.h>
+#include <sqlucode.h>
 
 #include <map>
 
+#include "../util/valuePtrHelper.hpp"
 #include "../util/writeLog.hpp"
 #include "handles/statementHandle.hpp"
 #include "mappings/typeMappings.hpp"
@@ -32,41 +34,27 @@ SQLSMALLINT static inferODBCTypeCode(ColumnDescription description) {
   return odbcTypeCode;
 }
 
-SQLRETURN SQL_API SQLDescribeCol(SQLHSTMT StatementHandle,
-                                 SQLUSMALLINT ColumnNumber,
-                                 _Out_writes_opt_(BufferLength)
-                                     SQLCHAR* ColumnName,
-                                 SQLSMALLINT BufferLength,
-                                 _Out_opt_ SQLSMALLINT* NameLength,
-                                 _Out_opt_ SQLSMALLINT* DataType,
-                                 _Out_opt_ SQLULEN* ColumnSize,
-                                 _Out_opt_ SQLSMALLINT* DecimalDigits,
-                                 _Out_opt_ SQLSMALLINT* Nullable) {
-  WriteLog(LL_TRACE, "Entering SQLDescribeCol");
+/*
+Fill in everything except the column name, which the narrow and wide
+entry points write differently. Returns the column name.
+*/
+static std::string describeColumn(Statement* statement,
+                                  SQLUSMALLINT ColumnNumber,
+                                  SQLSMALLINT* DataType,
+                                  SQLULEN* ColumnSize,
+                                  SQLSMALLINT* DecimalDigits,
+                                  SQLSMALLINT* Nullable) {
   WriteLog(LL_TRACE, "  Column index: " + std::to_string(ColumnNumber));
 
-  Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
   std::vector<ColumnDescription> columnDescriptions =
       statement->trinoQuery->getColumnDescriptions();
 
   ColumnDescription thisColumnDescription =
       columnDescriptions.at(ColumnNumber - 1);
 
-  Descriptor* descriptorPtr       = statement->getRowDescriptor();
-  DescriptorField descriptorField = descriptorPtr->getField(ColumnNumber);
-
-  const std::string& columnNameString = thisColumnDescription.getName();
-  SQLSMALLINT copyLength              = std::min<SQLSMALLINT>(
-      BufferLength - 1, static_cast<SQLSMALLINT>(columnNameString.size()));
+  Descriptor* descriptorPtr        = statement->getRowDescriptor();
+  const DescriptorBinding& binding = descriptorPtr->getBinding(ColumnNumber);
 
-  if (ColumnName) {
-    memcpy(ColumnName, columnNameString.c_str(), copyLength);
-    ColumnName[copyLength] = '\0'; // Null-terminate.
-  }
-  if (NameLength) {
-    *NameLength =
-        static_cast<SQLSMALLINT>(thisColumnDescription.getName().size());
-  }
   if (DataType) {
     *DataType = inferODBCTypeCode(thisColumnDescription);
   }
@@ -85,8 +73,65 @@ SQLRETURN SQL_API SQLDescribeCol(SQLHSTMT StatementHandle,
   if (DecimalDigits) {
     // The documentation says the value "0" should be set if the number of
     // digits cannot be determined or is not applicable. That's the default
-    // value of the descriptorField struct's scale.
-    *DecimalDigits = descriptorField.scale;
+    // value of the binding's scale.
+    *DecimalDigits = binding.scale;
+  }
+
+  return thisColumnDescription.getName();
+}
+
+SQLRETURN SQL_API SQLDescribeCol(SQLHSTMT StatementHandle,
+                                 SQLUSMALLINT ColumnNumber,
+                                 _Out_writes_opt_(BufferLength)
+                                     SQLCHAR* ColumnName,
+                                 SQLSMALLINT BufferLength,
+                                 _Out_opt_ SQLSMALLINT* NameLength,
+                                 _Out_opt_ SQLSMALLINT* DataType,
+                                 _Out_opt_ SQLULEN* ColumnSize,
+                                 _Out_opt_ SQLSMALLINT* DecimalDigits,
+                                 _Out_opt_ SQLSMALLINT* Nullable) {
+  WriteLog(LL_TRACE, "Entering SQLDescribeCol");
+
+  Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+  std::string columnNameString = describeColumn(
+      statement, ColumnNumber, DataType, ColumnSize, DecimalDigits, Nullable);
+
+  if (ColumnName and BufferLength > 0) {
+    SQLSMALLINT copyLength = std::min<SQLSMALLINT>(
+        BufferLength - 1, static_cast<SQLSMALLINT>(columnNameString.size()));
+    memcpy(ColumnName, columnNameString.c_str(), copyLength);
+    ColumnName[copyLength] = '\0'; // Null-terminate.
+  }
+  if (NameLength) {
+    *NameLength = static_cast<SQLSMALLINT>(columnNameString.size());
+  }
+
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLDescribeColW(SQLHSTMT StatementHandle,
+                                  SQLUSMALLINT ColumnNumber,
+                                  _Out_writes_opt_(BufferLength)
+                                      SQLWCHAR* ColumnName,
+                                  SQLSMALLINT BufferLength,
+                                  _Out_opt_ SQLSMALLINT* NameLength,
+                                  _Out_opt_ SQLSMALLINT* DataType,
+                                  _Out_opt_ SQLULEN* ColumnSize,
+                                  _Out_opt_ SQLSMALLINT* DecimalDigits,
+                                  _Out_opt_ SQLSMALLINT* Nullable) {
+  // BufferLength and NameLength are counts of characters here.
+  WriteLog(LL_TRACE, "Entering SQLDescribeColW");
+
+  Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+  std::string columnNameString = describeColumn(
+      statement, ColumnNumber, DataType, ColumnSize, DecimalDigits, Nullable);
+
+  size_t nameChars =
+      writeNullTermWideStringToPtr(ColumnName, columnNameString, BufferLength);
+  if (NameLength) {
+    *NameLength = static_cast<SQLSMALLINT>(nameChars);
   }
 
   return SQL_SUCCESS;
@@ -8,6 +8,7 @@
 SQLRETURN SQL_API SQLDisconnect(SQLHDBC ConnectionHandle) {
   WriteLog(LL_TRACE, "Entering SQLDisconnect");
   Connection* connection = reinterpret_cast<Connection*>(ConnectionHandle);
+  LogLevelScope logScope(connection->getLogLevel());
   connection->disconnect();
   return SQL_SUCCESS;
 }
@@ -1,6 +1,7 @@
 #include "../util/windowsLean.hpp"
 #include <sql.h>
 #include <sqlext.h>
+#include <sqlucode.h>
 
 #include <map>
 #include <string>
@@ -10,29 +11,16 @@
 
 #include "../util/delimKvpHelper.hpp"
 #include "../util/stringFromChar.hpp"
+#include "../util/valuePtrHelper.hpp"
 #include "../util/writeLog.hpp"
 
-SQLRETURN SQL_API SQLDriverConnect(SQLHDBC ConnectionHandle,
-                                   SQLHWND Windowhandle,
-                                   _In_reads_(InConnectionChars)
-                                       SQLCHAR* InConnectionChars,
-                                   SQLSMALLINT StringLength1,
-                                   _Out_writes_opt_(OutConnectionChars)
-                                       SQLCHAR* OutConnectionChars,
-                                   SQLSMALLINT BufferLength,
-                                   _Out_opt_ SQLSMALLINT* StringLength2Ptr,
-                                   SQLUSMALLINT DriverCompletion) {
-  WriteLog(LL_TRACE, "Entering SQLDriverConnect");
-  Connection* connection = reinterpret_cast<Connection*>(ConnectionHandle);
-
-  if (InConnectionChars == nullptr) {
-    WriteLog(LL_ERROR, "  ERROR: Connection string input is null");
-    return SQL_ERROR;
-  }
-
-  WriteLog(LL_TRACE, "  Reading input connection string");
-  std::string inputConnStr = stringFromChar(InConnectionChars, StringLength1);
-
+/*
+Configure the connection from a UTF-8 connection string. Writing the
+output connection string is left to the caller, since the narrow and
+wide variants encode it differently.
+*/
+static SQLRETURN connectWithConnectionString(Connection* connection,
+                                             const std::string& inputConnStr) {
   WriteLog(LL_TRACE, "  Input connection string was: " + inputConnStr);
 
   WriteLog(LL_TRACE, "  Parsing input connection string");
@@ -67,39 +55,14 @@ SQLRETURN SQL_API SQLDriverConnect(SQLHDBC ConnectionHandle,
   DriverConfig config = driverConfigFromKVPs(kvps);
 
   // It's kind of unfortunate that we can't set the log level of the driver
-  // until we've read the DSN in some way.
-  WriteLog(LL_TRACE, "  Setting Log Level");
-  setLogLevel(config.getLogLevelEnum());
+  // until we've read the DSN in some way. The connection's own calls log
+  // at its level, and other connections' aren't affected.
+  LogLevelScope logScope(config.getLogLevelEnum());
+  WriteLog(LL_TRACE, "  Log level set");
 
   WriteLog(LL_TRACE, "  Configuring connection");
   try {
     connection->configure(config);
-
-    WriteLog(LL_TRACE,
-             "  Copying input connection string to output connection string");
-    // Check if there's enough space in OutConnectionString
-    if (OutConnectionChars && BufferLength > 0) {
-      if (static_cast<int>(inputConnStr.size() + 1) <= BufferLength) {
-        // Copy the entire string
-        inputConnStr.copy(reinterpret_cast<char*>(OutConnectionChars),
-                          inputConnStr.size());
-        WriteLog(LL_TRACE, "  Connection string copied successfully.");
-        // Ensure null-termination
-        OutConnectionChars[inputConnStr.size()] = '\0';
-      }
-    } else {
-      // OutConnectionString is NULL or BufferLength is 0, just return the
-      // length
-      WriteLog(LL_WARN, "  No output buffer provided.");
-    }
-
-    // If StringLength2Ptr is provided, set it to the length of the connection
-    // string
-    if (StringLength2Ptr) {
-      *StringLength2Ptr = static_cast<SQLSMALLINT>(inputConnStr.size());
-      WriteLog(LL_TRACE, "  Length of connection string set.");
-    }
-
     connection->connected = true;
 
     WriteLog(LL_TRACE, "  Connection ready");
@@ -112,3 +75,92 @@ SQLRETURN SQL_API SQLDriverConnect(SQLHDBC ConnectionHandle,
     return SQL_ERROR;
   }
 }
+
+SQLRETURN SQL_API SQLDriverConnect(SQLHDBC ConnectionHandle,
+                                   SQLHWND Windowhandle,
+                                   _In_reads_(InConnectionChars)
+                                       SQLCHAR* InConnectionChars,
+                                   SQLSMALLINT StringLength1,
+                                   _Out_writes_opt_(OutConnectionChars)
+                                       SQLCHAR* OutConnectionChars,
+                                   SQLSMALLINT BufferLength,
+                                   _Out_opt_ SQLSMALLINT* StringLength2Ptr,
+                                   SQLUSMALLINT DriverCompletion) {
+  WriteLog(LL_TRACE, "Entering SQLDriverConnect");
+  Connection* connection = reinterpret_cast<Connection*>(ConnectionHandle);
+
+  if (InConnectionChars == nullptr) {
+    WriteLog(LL_ERROR, "  ERROR: Connection string input is null");
+    return SQL_ERROR;
+  }
+
+  WriteLog(LL_TRACE, "  Reading input connection string");
+  std::string inputConnStr = stringFromChar(InConnectionChars, StringLength1);
+
+  SQLRETURN ret = connectWithConnectionString(connection, inputConnStr);
+  if (ret != SQL_SUCCESS) {
+    return ret;
+  }
+
+  WriteLog(LL_TRACE,
+           "  Copying input connection string to output connection string");
+  // Check if there's enough space in OutConnectionString
+  if (OutConnectionChars && BufferLength > 0) {
+    if (static_cast<int>(inputConnStr.size() + 1) <= BufferLength) {
+      // Copy the entire string
+      inputConnStr.copy(reinterpret_cast<char*>(OutConnectionChars),
+                        inputConnStr.size());
+      WriteLog(LL_TRACE, "  Connection string copied successfully.");
+      // Ensure null-termination
+      OutConnectionChars[inputConnStr.size()] = '\0';
+    }
+  } else {
+    // OutConnectionString is NULL or BufferLength is 0, just return the
+    // length
+    WriteLog(LL_WARN, "  No output buffer provided.");
+  }
+
+  // If StringLength2Ptr is provided, set it to the length of the connection
+  // string
+  if (StringLength2Ptr) {
+    *StringLength2Ptr = static_cast<SQLSMALLINT>(inputConnStr.size());
+    WriteLog(LL_TRACE, "  Length of connection string set.");
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLDriverConnectW(SQLHDBC ConnectionHandle,
+                                    SQLHWND Windowhandle,
+                                    _In_reads_(InConnectionChars)
+                                        SQLWCHAR* InConnectionChars,
+                                    SQLSMALLINT StringLength1,
+                                    _Out_writes_opt_(OutConnectionChars)
+                                        SQLWCHAR* OutConnectionChars,
+                                    SQLSMALLINT BufferLength,
+                                    _Out_opt_ SQLSMALLINT* StringLength2Ptr,
+                                    SQLUSMALLINT DriverCompletion) {
+  // StringLength1, BufferLength, and StringLength2Ptr count characters.
+  WriteLog(LL_TRACE, "Entering SQLDriverConnectW");
+  Connection* connection = reinterpret_cast<Connection*>(ConnectionHandle);
+
+  if (InConnectionChars == nullptr) {
+    WriteLog(LL_ERROR, "  ERROR: Connection string input is null");
+    return SQL_ERROR;
+  }
+
+  WriteLog(LL_TRACE, "  Reading input connection string");
+  std::string inputConnStr = stringFromChar(
+      reinterpret_cast<char16_t*>(InConnectionChars), StringLength1);
+
+  SQLRETURN ret = connectWithConnectionString(connection, inputConnStr);
+  if (ret != SQL_SUCCESS) {
+    return ret;
+  }
+
+  size_t outputChars = writeNullTermWideStringToPtr(
+      OutConnectionChars, inputConnStr, BufferLength);
+  if (StringLength2Ptr) {
+    *StringLength2Ptr = static_cast<SQLSMALLINT>(outputChars);
+  }
+  return SQL_SUCCESS;
+}
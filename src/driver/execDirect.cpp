@@ -1,12 +1,50 @@
 #include "../util/windowsLean.hpp"
 #include <sql.h>
+#include <sqlucode.h>
 #include <string.h>
 
-#include "../trinoAPIWrapper/trinoQuery.hpp"
+#include "../trinoAPIWrapper/trinoExceptions.hpp"
+#include "../util/parameterMarkers.hpp"
 #include "../util/stringFromChar.hpp"
 #include "../util/writeLog.hpp"
+#include "execution/executeStatement.hpp"
 #include "handles/statementHandle.hpp"
 
+static SQLRETURN executeQueryText(Statement* statement,
+                                  const std::string& queryText) {
+  try {
+    WriteLog(LL_DEBUG, "  Query: " + queryText);
+    // Executing text directly discards any statement prepared on this
+    // handle, along with the columns it described.
+    if (statement->prepared) {
+      statement->clearPrepared();
+    }
+    return executeStatement(
+        statement, queryText, findParameterMarkers(queryText));
+  } catch (const TimeoutError& ex) {
+    WriteLog(LL_ERROR, "  ERROR: " + std::string(ex.what()));
+    ErrorInfo errorInfo("Timeout expired", "HYT00");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  } catch (const CanceledError& ex) {
+    WriteLog(LL_ERROR, "  ERROR: " + std::string(ex.what()));
+    ErrorInfo errorInfo("Operation canceled", "HY008");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  } catch (const std::exception& ex) {
+    WriteLog(LL_ERROR,
+             "  ERROR: Exception thrown during SQLExecDirect: " +
+                 std::string(ex.what()));
+    // Set the diagnostic record on the statement handle
+    // to make it possible to tell what happened here.
+    ErrorInfo errorInfo("Exception thrown during SQLExecDirect: " +
+                            std::string(ex.what()),
+                        "HY000");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  }
+}
+
 SQLRETURN SQL_API SQLExecDirect(SQLHSTMT StatementHandle,
                                 _In_reads_opt_(TextLength)
                                     SQLCHAR* StatementText,
@@ -18,30 +56,31 @@ SQLRETURN SQL_API SQLExecDirect(SQLHSTMT StatementHandle,
     return SQL_ERROR;
   }
 
-  Statement* statementPtr = reinterpret_cast<Statement*>(StatementHandle);
+  Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+  return executeQueryText(statement,
+                          stringFromChar(StatementText, TextLength));
+}
 
-  try {
-    Statement* statement  = (Statement*)StatementHandle;
-    std::string queryText = stringFromChar(StatementText, TextLength);
-    WriteLog(LL_DEBUG, "  Query: " + queryText);
-    TrinoQuery* trinoQuery = statement->trinoQuery;
-    WriteLog(LL_DEBUG, "  Setting Query");
-    trinoQuery->setQuery(queryText);
-    WriteLog(LL_DEBUG, "  POSTing Query");
-    trinoQuery->post();
-    WriteLog(LL_DEBUG, "  Setting to executed");
-    statement->executed = true;
-    return SQL_SUCCESS;
-  } catch (const std::exception& ex) {
-    WriteLog(LL_ERROR,
-             "  ERROR: Exception thrown during SQLExecDirect: " +
-                 std::string(ex.what()));
-    // Set the diagnostic record on the statement handle
-    // to make it possible to tell what happened here.
-    ErrorInfo errorInfo("Exception thrown during SQLExecDirect: " +
-                            std::string(ex.what()),
-                        "HY000");
-    statementPtr->setError(errorInfo);
+SQLRETURN SQL_API SQLExecDirectW(SQLHSTMT StatementHandle,
+                                 _In_reads_opt_(TextLength)
+                                     SQLWCHAR* StatementText,
+                                 SQLINTEGER TextLength) {
+  /*
+  TextLength is a count of characters here, not bytes. The query
+  text is converted to UTF-8 once, up front, which is what Trino
+  expects on the wire.
+  */
+  WriteLog(LL_TRACE, "Entering SQLExecDirectW");
+
+  if (not StatementText) {
+    WriteLog(LL_ERROR, " ERROR: No StatementText defined for query");
     return SQL_ERROR;
   }
+
+  Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+  return executeQueryText(
+      statement,
+      stringFromChar(reinterpret_cast<char16_t*>(StatementText), TextLength));
 }
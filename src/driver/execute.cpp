@@ -2,10 +2,51 @@
 #include <sql.h>
 #include <sqlext.h>
 
+#include <string>
+
+#include "../trinoAPIWrapper/trinoExceptions.hpp"
 #include "../util/writeLog.hpp"
+#include "execution/executeStatement.hpp"
+#include "handles/statementHandle.hpp"
 
 SQLRETURN SQL_API SQLExecute(SQLHSTMT StatementHandle) {
   WriteLog(LL_TRACE, "Entering SQLExecute");
-  WriteLog(LL_ERROR, "  ERROR: SQLExecute unimplemented");
-  return SQL_ERROR;
+  if (!StatementHandle) {
+    WriteLog(LL_ERROR, "  ERROR: Invalid statement handle");
+    return SQL_INVALID_HANDLE;
+  }
+
+  Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+  if (not statement->prepared) {
+    WriteLog(LL_ERROR, "  ERROR: SQLExecute called before SQLPrepare");
+    ErrorInfo errorInfo("Function sequence error", "HY010");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  }
+
+  try {
+    return executeStatement(statement,
+                            statement->preparedStatementText,
+                            statement->preparedParameterMarkers);
+  } catch (const TimeoutError& ex) {
+    WriteLog(LL_ERROR, "  ERROR: " + std::string(ex.what()));
+    ErrorInfo errorInfo("Timeout expired", "HYT00");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  } catch (const CanceledError& ex) {
+    WriteLog(LL_ERROR, "  ERROR: " + std::string(ex.what()));
+    ErrorInfo errorInfo("Operation canceled", "HY008");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  } catch (const std::exception& ex) {
+    WriteLog(LL_ERROR,
+             "  ERROR: Exception thrown during SQLExecute: " +
+                 std::string(ex.what()));
+    ErrorInfo errorInfo("Exception thrown during SQLExecute: " +
+                            std::string(ex.what()),
+                        "HY000");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  }
 }
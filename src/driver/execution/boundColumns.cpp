@@ -0,0 +1,71 @@
+#include "boundColumns.hpp"
+
+#include <cstdint>
+#include <string>
+
+#include "../../trinoAPIWrapper/trinoQuery.hpp"
+#include "../../util/rowToBuffer.hpp"
+#include "../../util/writeLog.hpp"
+#include "../handles/descriptorHandle.hpp"
+
+void writeBoundColumns(Statement* statement) {
+  /*
+  Every time we fetch a row, we need to check if any of the data
+  that was returned is from a column that has been bound to a
+  buffer. If it has, we need to copy the data directly into
+  the buffer before returning from the call to SQLFetch().
+  */
+
+  // First, make sure we have column information. We can't do anything with
+  // bound columns until we know what columns we have.
+  if (not statement->trinoQuery->hasColumnData()) {
+    statement->trinoQuery->poll(UntilColumnsLoaded);
+  }
+
+  int16_t columnCount    = statement->trinoQuery->getColumnCount();
+  SQLLEN fetchedPosition = statement->getFetchedPosition();
+  // Only the bindings are read here, and they're laid out one after
+  // another, so a wide row doesn't pull in every column's metadata.
+  const std::vector<DescriptorBinding>& bindings =
+      statement->getRowDescriptor()->getBindings();
+
+  // Field indices start at 1 because index 0 is the "bookmark" column.
+  for (auto i = 1; i <= columnCount; i++) {
+    // It's safe to index the bindings here because we checked and confirmed
+    // that we had loaded all the columns. They should have their descriptors
+    // in place already.
+    const DescriptorBinding& field = bindings[i];
+
+    // If the column isn't bound, there's nothing to be done.
+    if (field.bufferPtr == nullptr) {
+      continue;
+    }
+
+    SQLLEN* strLen_or_IndPtr = field.bufferStrLenOrIndPtr;
+    void* buffer             = field.bufferPtr;
+    SQLLEN bufferLength      = field.bufferLength;
+    SQLSMALLINT cDataType    = field.bufferCDataType;
+    SQLSMALLINT odbcDataType = field.odbcDataType;
+    SQLULEN columnNumber     = i;
+
+    // This is in a tight loop, so best to not even execute it
+    // if there's a chance of skipping the calls to std::to_string.
+    if (getLogLevel() <= LL_TRACE) {
+      WriteLog(LL_TRACE, "  Bound column detected. Writing value");
+      WriteLog(LL_TRACE, "  ODBC Type is: " + std::to_string(odbcDataType));
+      WriteLog(LL_TRACE, "  C Type is: " + std::to_string(cDataType));
+    }
+
+    const json& cellData =
+        statement->trinoQuery->getCellAtIndex(fetchedPosition, i - 1);
+    columnToBuffer(cDataType,
+                   odbcDataType,
+                   cellData,
+                   columnNumber,
+                   buffer,
+                   bufferLength,
+                   strLen_or_IndPtr,
+                   field.precision,
+                   field.scale);
+  }
+}
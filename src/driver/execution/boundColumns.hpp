@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../handles/statementHandle.hpp"
+
+/*
+Copy the values of the statement's current row into the buffers of
+any columns bound with SQLBindCol, like SQLFetch and SQLFetchScroll do
+every time they move to a row.
+*/
+void writeBoundColumns(Statement* statement);
@@ -0,0 +1,251 @@
+#include "catalogQuery.hpp"
+
+#include <chrono>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+#include "../../trinoAPIWrapper/metadataCache.hpp"
+#include "../../trinoAPIWrapper/trinoExceptions.hpp"
+#include "../../trinoAPIWrapper/trinoQuery.hpp"
+#include "../../util/writeLog.hpp"
+
+using json = nlohmann::json;
+
+/*
+The column info of a query's result, the same as Trino sent it.
+*/
+static json capturedColumns(TrinoQuery* trinoQuery) {
+  json columns = json::array();
+  for (const ColumnDescription& column : trinoQuery->getColumnDescriptions()) {
+    columns.push_back(json{{"name", column.getName()},
+                           {"type", column.getType()},
+                           {"typeSignature",
+                            {{"rawType", column.getRawType()},
+                             {"arguments", column.getTypeArguments()}}}});
+  }
+  return columns;
+}
+
+static json capturedRow(TrinoQuery* trinoQuery, int64_t row) {
+  size_t columnCount = trinoQuery->getColumnDescriptions().size();
+  json cells         = json::array();
+  for (size_t column = 0; column < columnCount; column++) {
+    cells.push_back(trinoQuery->getCellAtIndex(row, column));
+  }
+  return cells;
+}
+
+/*
+Keep a finished query's rows, all in a single page.
+*/
+static StaticResult staticResult(const json& columns, const json& rows) {
+  StaticResult result;
+  result.columns = columns.get<std::vector<json>>();
+  result.pages   = {std::make_shared<ResultPage>(rows)};
+  return result;
+}
+
+/*
+Apply the statement's SQL_ATTR_MAX_ROWS to the query about to run or
+be sideloaded. Cached results are always complete, and only cut short
+on their way to the statement.
+*/
+static void limitRows(Statement* statement) {
+  statement->trinoQuery->setMaxRows(static_cast<int64_t>(statement->maxRows));
+}
+
+static void sideloadCached(Statement* statement,
+                           const std::string& query,
+                           const StaticResult& cachedResult) {
+  WriteLog(LL_TRACE, "  Using cached metadata result");
+  limitRows(statement);
+  statement->trinoQuery->setQuery(query);
+  statement->trinoQuery->sideloadResult(cachedResult);
+  statement->executed = true;
+}
+
+/*
+Run a query and wait for all of its rows. Returns false if Trino
+reported an error, which is also set on the statement handle.
+*/
+static bool runToCompletion(Statement* statement, const std::string& query) {
+  TrinoQuery* trinoQuery = statement->trinoQuery;
+  trinoQuery->setQuery(query);
+  trinoQuery->post();
+  statement->executed = true;
+  trinoQuery->poll(ToCompletion);
+  if (trinoQuery->hasError()) {
+    WriteLog(LL_ERROR,
+             "  ERROR: Catalog query failed: " + trinoQuery->getErrorMessage());
+    statement->setQueryError();
+    return false;
+  }
+  return true;
+}
+
+/*
+Get the statement ready for a catalog query. Catalog queries are held
+to SQL_ATTR_QUERY_TIMEOUT like any other, which resetting clears.
+*/
+static void startCatalogQuery(Statement* statement) {
+  statement->trinoQuery->terminate();
+  statement->resetResults();
+  statement->trinoQuery->setTimeout(
+      std::chrono::seconds(statement->queryTimeout));
+}
+
+/*
+Run a catalog query, turning the exceptions posting it can throw into
+the statement's error, the way SQLExecDirect does.
+*/
+static SQLRETURN runGuarded(Statement* statement,
+                            const std::function<SQLRETURN()>& run) {
+  try {
+    return run();
+  } catch (const TimeoutError& ex) {
+    WriteLog(LL_ERROR, "  ERROR: " + std::string(ex.what()));
+    statement->setError(ErrorInfo("Timeout expired", "HYT00"));
+  } catch (const CanceledError& ex) {
+    WriteLog(LL_ERROR, "  ERROR: " + std::string(ex.what()));
+    statement->setError(ErrorInfo("Operation canceled", "HY008"));
+  } catch (const std::exception& ex) {
+    WriteLog(LL_ERROR,
+             "  ERROR: Catalog query failed: " + std::string(ex.what()));
+    statement->setError(ErrorInfo(ex.what(), "HY000"));
+  }
+  return SQL_ERROR;
+}
+
+static SQLRETURN runCatalogQueryUnguarded(Statement* statement,
+                                          const std::string& query) {
+  TrinoQuery* trinoQuery = statement->trinoQuery;
+  MetadataCache& cache   = statement->connectionConfig->metadataCache;
+
+  startCatalogQuery(statement);
+
+  if (not cache.isEnabled()) {
+    limitRows(statement);
+    trinoQuery->setQuery(query);
+    trinoQuery->post();
+    statement->executed = true;
+    return SQL_SUCCESS;
+  }
+
+  const StaticResult* cached = cache.lookup(query);
+  if (cached) {
+    sideloadCached(statement, query, *cached);
+    return SQL_SUCCESS;
+  }
+
+  if (not runToCompletion(statement, query)) {
+    return SQL_ERROR;
+  }
+  json rows      = json::array();
+  int64_t rowEnd = trinoQuery->getCurrentRowCount();
+  for (int64_t row = 0; row < rowEnd; row++) {
+    rows.push_back(capturedRow(trinoQuery, row));
+  }
+  StaticResult result = staticResult(capturedColumns(trinoQuery), rows);
+  cache.store(query, result);
+
+  // The statement reads the result the way a later call would, so it
+  // gets no more rows than it asked for.
+  statement->resetResults();
+  sideloadCached(statement, query, result);
+  return SQL_SUCCESS;
+}
+
+SQLRETURN runCatalogQuery(Statement* statement, const std::string& query) {
+  return runGuarded(statement, [statement, &query]() {
+    return runCatalogQueryUnguarded(statement, query);
+  });
+}
+
+static SQLRETURN runSchemaCatalogQueryUnguarded(
+    Statement* statement,
+    const std::string& query,
+    const std::string& schemaQuery,
+    const std::function<std::string(const std::string&)>& tableQuery) {
+  TrinoQuery* trinoQuery = statement->trinoQuery;
+  MetadataCache& cache   = statement->connectionConfig->metadataCache;
+
+  if (not cache.getPrefetchSchemas()) {
+    return runCatalogQueryUnguarded(statement, query);
+  }
+
+  startCatalogQuery(statement);
+
+  const StaticResult* cached = cache.lookupTable(schemaQuery, query);
+  if (cached) {
+    sideloadCached(statement, query, *cached);
+    return SQL_SUCCESS;
+  }
+
+  WriteLog(LL_TRACE, "  Prefetching catalog metadata for the whole schema");
+  if (not runToCompletion(statement, schemaQuery)) {
+    return SQL_ERROR;
+  }
+
+  // Split the schema's rows up by table. They arrive ordered by table,
+  // so each table's rows keep their order.
+  json columns           = capturedColumns(trinoQuery);
+  size_t tableNameColumn = 0;
+  while (tableNameColumn < columns.size() and
+         columns[tableNameColumn]["name"] != "table_name") {
+    tableNameColumn++;
+  }
+  std::vector<std::string> tableNames;
+  std::map<std::string, json> rowsByTable;
+  int64_t rowEnd = trinoQuery->getCurrentRowCount();
+  for (int64_t row = 0; row < rowEnd; row++) {
+    json cells = capturedRow(trinoQuery, row);
+    if (tableNameColumn >= cells.size() or
+        not cells[tableNameColumn].is_string()) {
+      continue;
+    }
+    json& tableRows = rowsByTable[cells[tableNameColumn].get<std::string>()];
+    if (tableRows.is_null()) {
+      tableRows = json::array();
+      tableNames.push_back(cells[tableNameColumn].get<std::string>());
+    }
+    tableRows.push_back(std::move(cells));
+  }
+
+  // The schema's result is made of its tables' pages, in the order they
+  // arrived, so it answers a call for the whole schema too without
+  // keeping the rows twice. A table without any rows still gets a
+  // result, so asking again is free.
+  StaticResult schemaResult;
+  schemaResult.columns = columns.get<std::vector<json>>();
+  std::map<std::string, StaticResult> tableResults;
+  for (const std::string& tableName : tableNames) {
+    StaticResult tableResult = staticResult(columns, rowsByTable[tableName]);
+    schemaResult.pages.push_back(tableResult.pages.front());
+    tableResults.emplace(tableQuery(tableName), std::move(tableResult));
+  }
+  tableResults.try_emplace(query, staticResult(columns, json::array()));
+  StaticResult requestedResult = tableResults.at(query);
+  cache.storeSchema(
+      schemaQuery, std::move(schemaResult), std::move(tableResults));
+  if (getLogLevel() <= LL_TRACE) {
+    WriteLog(LL_TRACE,
+             "  Cached catalog metadata for " +
+                 std::to_string(tableNames.size()) + " tables");
+  }
+
+  statement->resetResults();
+  sideloadCached(statement, query, requestedResult);
+  return SQL_SUCCESS;
+}
+
+SQLRETURN runSchemaCatalogQuery(
+    Statement* statement,
+    const std::string& query,
+    const std::string& schemaQuery,
+    const std::function<std::string(const std::string&)>& tableQuery) {
+  return runGuarded(statement, [&]() {
+    return runSchemaCatalogQueryUnguarded(
+        statement, query, schemaQuery, tableQuery);
+  });
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../../util/windowsLean.hpp"
+#include <sql.h>
+
+#include <functional>
+#include <string>
+
+#include "../handles/statementHandle.hpp"
+
+/*
+Run a catalog function's query on a statement handle, like SQLTables
+and SQLColumns do. The query text is built from the function's
+normalized arguments, so it doubles as the key into the connection's
+metadata cache. A cached result is sideloaded without contacting the
+server. Otherwise the query runs to completion and its result is
+cached for the next identical call.
+
+With the cache turned off, the query is only posted and its rows are
+read by SQLFetch as they arrive, like any other query. Either way the
+statement's SQL_ATTR_QUERY_TIMEOUT applies, and a query that runs out
+of time fails with HYT00. SQL_ATTR_MAX_ROWS limits the rows the
+statement returns, but never what's cached.
+*/
+SQLRETURN runCatalogQuery(Statement* statement, const std::string& query);
+
+/*
+Run a catalog query for a single table by loading the whole schema
+instead, when the connection has schema prefetch turned on. schemaQuery
+lists the schema, and its rows are split up by their table_name column.
+The schema is cached as one entry under schemaQuery, which holds each
+table's rows under the query text tableQuery gives for it, the text a
+table's own call would have run. Later calls for sibling tables then
+find their result in the cache.
+
+Without schema prefetch this is the same as runCatalogQuery.
+*/
+SQLRETURN runSchemaCatalogQuery(
+    Statement* statement,
+    const std::string& query,
+    const std::string& schemaQuery,
+    const std::function<std::string(const std::string&)>& tableQuery);
@@ -0,0 +1,320 @@
+#include "executeStatement.hpp"
+
+#include <algorithm>
+#include <memory_resource>
+#include <span>
+
+#include "../../trinoAPIWrapper/resultCache.hpp"
+#include "../../trinoAPIWrapper/trinoQuery.hpp"
+#include "../../util/parameterMarkers.hpp"
+#include "../../util/parameterToLiteral.hpp"
+#include "../../util/writeLog.hpp"
+
+/*
+Trino rejects statements longer than query.max-length, which defaults
+to a million characters. Batched inserts are split to stay below it.
+*/
+constexpr size_t BATCH_STATEMENT_MAX_LENGTH = 900000;
+
+/*
+The key a statement's result is cached under, or an empty string if
+it shouldn't be cached. Only read-only statements are cached, and the
+key covers the server, the user, the session's catalog, schema and
+properties, and the statement's normalized text.
+*/
+static std::string resultCacheKey(Statement* statement,
+                                  const std::string& queryText,
+                                  const std::string& preparedText) {
+  ConnectionConfig* connectionConfig = statement->connectionConfig;
+  if (connectionConfig->resultCacheSettings.timeToLive.count() == 0) {
+    return "";
+  }
+  const std::string& statementText =
+      preparedText.empty() ? queryText : preparedText;
+  if (not isReadOnlyStatement(statementText)) {
+    return "";
+  }
+  std::string identity = connectionConfig->getIdentity();
+  if (identity.empty()) {
+    return "";
+  }
+  return identity + "\n" +
+         normalizeStatementText(preparedText) + "\n" +
+         normalizeStatementText(queryText);
+}
+
+/*
+Make queryText the statement handle's current query and send it.
+If preparedText is set, the query refers to it by name, and the text
+goes along with the request in a header.
+*/
+static void postQuery(Statement* statement,
+                      std::string queryText,
+                      const std::string& preparedText) {
+  TrinoQuery* trinoQuery = statement->trinoQuery;
+  trinoQuery->terminate();
+  statement->resetResults();
+  trinoQuery->setTimeout(std::chrono::seconds(statement->queryTimeout));
+  // The columns of a prepared statement are already known, so the
+  // ones in the response don't need to be parsed.
+  if (statement->prepared) {
+    trinoQuery->setColumns(statement->preparedColumns);
+  }
+  // SQL_ATTR_MAX_ROWS only limits queries, not the single row of
+  // counts a statement that changes data returns. Where a LIMIT can be
+  // added, Trino doesn't produce rows the application won't read. The
+  // query is stopped once it has returned enough of them either way.
+  const std::string& statementText =
+      preparedText.empty() ? queryText : preparedText;
+  if (statement->maxRows > 0 and isReadOnlyStatement(statementText)) {
+    trinoQuery->setMaxRows(static_cast<int64_t>(statement->maxRows));
+    std::string limitedText;
+    if (preparedText.empty() and
+        addRowLimit(queryText, statement->maxRows, limitedText)) {
+      queryText = std::move(limitedText);
+    }
+  }
+  trinoQuery->setQuery(queryText);
+
+  // A cached result is read like any other, so SQLFetch can't tell.
+  std::string cacheKey = resultCacheKey(statement, queryText, preparedText);
+  if (not cacheKey.empty()) {
+    const ResultCacheSettings& settings =
+        statement->connectionConfig->resultCacheSettings;
+    StaticResult cachedResult;
+    if (getResultCache().lookup(cacheKey, settings, cachedResult)) {
+      WriteLog(LL_DEBUG, "  Using cached result");
+      trinoQuery->sideloadResult(cachedResult);
+      statement->executed = true;
+      return;
+    }
+    trinoQuery->captureResult(cacheKey);
+  }
+
+  if (not preparedText.empty()) {
+    trinoQuery->setPreparedStatement(PREPARED_STATEMENT_NAME, preparedText);
+  }
+  WriteLog(LL_DEBUG, "  POSTing Query");
+  trinoQuery->post();
+  statement->executed = true;
+}
+
+/*
+Send a query and wait for it to finish, for when several queries run
+back to back. Returns false if Trino reported an error.
+*/
+static bool runQueryToCompletion(Statement* statement,
+                                 const std::string& queryText,
+                                 const std::string& preparedText) {
+  postQuery(statement, queryText, preparedText);
+  statement->trinoQuery->poll(ToCompletion);
+  if (statement->trinoQuery->hasError()) {
+    WriteLog(LL_ERROR,
+             "  ERROR: Query failed: " +
+                 statement->trinoQuery->getErrorMessage());
+    statement->setQueryError();
+    return false;
+  }
+  return true;
+}
+
+/*
+Render every parameter of one parameter set as a literal. Parameters
+are bound either by column, where each parameter has its own array,
+or by row, where each set is a structure of bindType bytes.
+*/
+static bool renderParameterSet(Statement* statement,
+                               size_t parameterCount,
+                               SQLULEN setIndex,
+                               std::pmr::vector<std::pmr::string>& literals) {
+  Descriptor* paramDescriptor = statement->getParamDescriptor();
+  SQLULEN bindType            = paramDescriptor->Field_BindType;
+  SQLLEN bindOffset           = 0;
+  if (paramDescriptor->Field_BindOffsetPtr) {
+    bindOffset = *paramDescriptor->Field_BindOffsetPtr;
+  }
+
+  literals.resize(parameterCount);
+  for (size_t i = 0; i < parameterCount; i++) {
+    const DescriptorBinding& field =
+        paramDescriptor->getBinding(static_cast<SQLSMALLINT>(i + 1));
+    size_t valueStride     = bindType;
+    size_t indicatorStride = bindType;
+    if (bindType == SQL_PARAM_BIND_BY_COLUMN) {
+      valueStride = cDataTypeSize(field.bufferCDataType);
+      if (valueStride == 0) {
+        valueStride = static_cast<size_t>(field.bufferLength);
+      }
+      indicatorStride = sizeof(SQLLEN);
+    }
+
+    const char* value = nullptr;
+    if (field.bufferPtr) {
+      value = static_cast<const char*>(field.bufferPtr) + bindOffset +
+              setIndex * valueStride;
+    }
+    const SQLLEN* indicator = nullptr;
+    if (field.bufferStrLenOrIndPtr) {
+      indicator = reinterpret_cast<const SQLLEN*>(
+          reinterpret_cast<const char*>(field.bufferStrLenOrIndPtr) +
+          bindOffset + setIndex * indicatorStride);
+    }
+
+    if (not parameterToLiteral(field.bufferCDataType,
+                               field.odbcDataType,
+                               value,
+                               field.bufferLength,
+                               indicator,
+                               literals[i])) {
+      WriteLog(LL_ERROR,
+               "  ERROR: Could not convert parameter " +
+                   std::to_string(i + 1));
+      ErrorInfo errorInfo("Could not convert parameter " +
+                              std::to_string(i + 1) + " in parameter set " +
+                              std::to_string(setIndex + 1),
+                          "07006");
+      statement->setError(errorInfo);
+      return false;
+    }
+  }
+  return true;
+}
+
+static std::string executeUsing(std::span<const std::pmr::string> literals) {
+  std::string queryText = std::string("EXECUTE ") + PREPARED_STATEMENT_NAME;
+  for (size_t i = 0; i < literals.size(); i++) {
+    queryText += i == 0 ? " USING " : ", ";
+    queryText += literals[i];
+  }
+  return queryText;
+}
+
+SQLRETURN executeStatement(Statement* statement,
+                           const std::string& statementText,
+                           const std::vector<size_t>& markers) {
+  // Whatever the last execution left in scratch memory is done with.
+  statement->releaseScratch();
+  if (markers.empty()) {
+    if (statement->prepared) {
+      postQuery(statement,
+                std::string("EXECUTE ") + PREPARED_STATEMENT_NAME,
+                statementText);
+    } else {
+      postQuery(statement, statementText, "");
+    }
+    return SQL_SUCCESS;
+  }
+
+  Descriptor* paramDescriptor = statement->getParamDescriptor();
+  if (static_cast<size_t>(paramDescriptor->Field_Count) < markers.size()) {
+    WriteLog(LL_ERROR, "  ERROR: Not every parameter marker is bound");
+    ErrorInfo errorInfo("COUNT field incorrect", "07002");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  }
+
+  SQLULEN setCount = std::max<SQLULEN>(paramDescriptor->Field_ArraySize, 1);
+  SQLUSMALLINT* statuses = statement->impParamDesc->Field_ArrayStatusPtr;
+  SQLULEN* processed     = statement->impParamDesc->Field_RowsProcessedPtr;
+  if (statuses) {
+    std::fill(statuses, statuses + setCount, SQL_PARAM_UNUSED);
+  }
+
+  // Render every set up front. Sets that can't be rendered are
+  // reported as errors and left out, the rest still run. The sets are
+  // only needed until this returns, so they live in scratch memory.
+  std::pmr::memory_resource* scratch = statement->getScratch();
+  std::pmr::vector<std::pmr::vector<std::pmr::string>> literalSets(setCount,
+                                                                   scratch);
+  std::pmr::vector<SQLULEN> renderedSets(scratch);
+  for (SQLULEN setIndex = 0; setIndex < setCount; setIndex++) {
+    if (renderParameterSet(
+            statement, markers.size(), setIndex, literalSets[setIndex])) {
+      renderedSets.push_back(setIndex);
+    } else if (statuses) {
+      statuses[setIndex] = SQL_PARAM_ERROR;
+    }
+  }
+  if (processed) {
+    *processed = setCount;
+  }
+
+  SQLULEN failedSets = setCount - renderedSets.size();
+  if (setCount == 1) {
+    // A single set runs like any other statement, with its results
+    // streamed as the application fetches them.
+    if (failedSets > 0) {
+      return SQL_ERROR;
+    }
+    postQuery(statement, executeUsing(literalSets[0]), statementText);
+    if (statuses) {
+      statuses[0] = SQL_PARAM_SUCCESS;
+    }
+    return SQL_SUCCESS;
+  }
+
+  size_t rowBegin = 0;
+  size_t rowEnd   = 0;
+  if (findInsertValuesRow(statementText, markers, rowBegin, rowEnd)) {
+    /*
+    An INSERT of one VALUES row takes any number of rows, so instead
+    of a round trip per parameter set, the rows are written into as
+    few statements as fit under Trino's length limit.
+    */
+    std::string batchText;
+    std::pmr::vector<SQLULEN> batchSets(scratch);
+    auto runBatch = [&]() {
+      bool succeeded = runQueryToCompletion(statement, batchText, "");
+      for (SQLULEN setIndex : batchSets) {
+        if (statuses) {
+          statuses[setIndex] = succeeded ? SQL_PARAM_SUCCESS : SQL_PARAM_ERROR;
+        }
+      }
+      failedSets += succeeded ? 0 : batchSets.size();
+      batchText.clear();
+      batchSets.clear();
+    };
+    std::string row;
+    for (SQLULEN setIndex : renderedSets) {
+      row.clear();
+      appendWithParameters(row,
+                           statementText,
+                           rowBegin,
+                           rowEnd + 1,
+                           markers,
+                           literalSets[setIndex]);
+      if (not batchSets.empty() and
+          batchText.size() + row.size() + 2 > BATCH_STATEMENT_MAX_LENGTH) {
+        runBatch();
+      }
+      if (batchSets.empty()) {
+        batchText.assign(statementText, 0, rowBegin);
+      } else {
+        batchText += ", ";
+      }
+      batchText += row;
+      batchSets.push_back(setIndex);
+    }
+    if (not batchSets.empty()) {
+      runBatch();
+    }
+  } else {
+    // Anything else runs once per parameter set.
+    for (SQLULEN setIndex : renderedSets) {
+      bool succeeded = runQueryToCompletion(
+          statement, executeUsing(literalSets[setIndex]), statementText);
+      if (statuses) {
+        statuses[setIndex] = succeeded ? SQL_PARAM_SUCCESS : SQL_PARAM_ERROR;
+      }
+      failedSets += succeeded ? 0 : 1;
+    }
+  }
+
+  if (failedSets == 0) {
+    return SQL_SUCCESS;
+  } else if (failedSets < setCount) {
+    return SQL_SUCCESS_WITH_INFO;
+  } else {
+    return SQL_ERROR;
+  }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "../../util/windowsLean.hpp"
+#include <sql.h>
+
+#include <string>
+#include <vector>
+
+#include "../handles/statementHandle.hpp"
+
+/*
+Execute statement text on a statement handle, either text passed to
+SQLExecDirect or the handle's prepared statement. Any parameter
+markers in the text are filled in from the bound parameters, once
+for every parameter set.
+
+Failures talking to Trino are thrown, the same as TrinoQuery does.
+Problems with the parameters are reported on the statement handle
+and in the return code.
+*/
+SQLRETURN executeStatement(Statement* statement,
+                           const std::string& statementText,
+                           const std::vector<size_t>& markers);
@@ -1,73 +1,15 @@
 #include "../util/windowsLean.hpp"
 #include <sql.h>
+#include <sqlext.h>
 
 #include <cstdint>
 #include <string>
 
 #include "../trinoAPIWrapper/trinoQuery.hpp"
-#include "../util/rowToBuffer.hpp"
 #include "../util/writeLog.hpp"
-#include "handles/descriptorHandle.hpp"
+#include "execution/boundColumns.hpp"
 #include "handles/statementHandle.hpp"
 
-static void handleBoundColumns(Statement* statement) {
-  /*
-  Every time we fetch a row, we need to check if any of the data
-  that was returned is from a column that has been bound to a
-  buffer. If it has, we need to copy the data directly into
-  the buffer before returning from the call to SQLFetch().
-  */
-
-  // First, make sure we have column information. We can't do anything with
-  // bound columns until we know what columns we have.
-  if (not statement->trinoQuery->hasColumnData()) {
-    statement->trinoQuery->poll(UntilColumnsLoaded);
-  }
-
-  int16_t columnCount       = statement->trinoQuery->getColumnCount();
-  Descriptor* rowDescriptor = statement->getRowDescriptor();
-  SQLLEN fetchedPosition    = statement->getFetchedPosition();
-  const json& rowData = statement->trinoQuery->getRowAtIndex(fetchedPosition);
-
-  // Field indices start at 1 because index 0 is the "bookmark" column.
-  for (auto i = 1; i <= columnCount; i++) {
-    // It's safe to use `getFieldRef` here because we checked and confirmed
-    // that we had loaded all the columns. They should have their descriptors
-    // in place already.
-    const DescriptorField& field = rowDescriptor->getFieldRef(i);
-
-    // If the column isn't bound, there's nothing to be done.
-    if (field.bufferPtr == nullptr) {
-      continue;
-    }
-
-    SQLLEN* strLen_or_IndPtr = field.bufferStrLenOrIndPtr;
-    void* buffer             = field.bufferPtr;
-    SQLLEN bufferLength      = field.bufferLength;
-    SQLSMALLINT cDataType    = field.bufferCDataType;
-    SQLSMALLINT odbcDataType = field.odbcDataType;
-    SQLULEN columnNumber     = i;
-
-    // This is in a tight loop, so best to not even execute it
-    // if there's a chance of skipping the calls to std::to_string.
-    if (getLogLevel() <= LL_TRACE) {
-      WriteLog(LL_TRACE, "  Bound column detected. Writing value");
-      WriteLog(LL_TRACE, "  ODBC Type is: " + std::to_string(odbcDataType));
-      WriteLog(LL_TRACE, "  C Type is: " + std::to_string(cDataType));
-    }
-
-    columnToBuffer(cDataType,
-                   odbcDataType,
-                   rowData,
-                   columnNumber,
-                   buffer,
-                   bufferLength,
-                   strLen_or_IndPtr,
-                   field.precision,
-                   field.scale);
-  }
-}
-
 SQLRETURN SQL_API SQLFetch(SQLHSTMT StatementHandle) {
   WriteLog(LL_TRACE, "Entering SQLFetch");
   if (!StatementHandle) {
@@ -78,6 +20,13 @@ SQLRETURN SQL_API SQLFetch(SQLHSTMT StatementHandle) {
   WriteLog(LL_TRACE, "  Getting Handles");
   Statement* statement   = reinterpret_cast<Statement*>(StatementHandle);
   TrinoQuery* trinoQuery = statement->trinoQuery;
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+
+  // A static cursor can be positioned after the last row and scrolled
+  // back from there, which SQLFetchScroll keeps track of.
+  if (statement->cursorType == SQL_CURSOR_STATIC) {
+    return SQLFetchScroll(StatementHandle, SQL_FETCH_NEXT, 0);
+  }
 
   WriteLog(LL_TRACE, "  Checking row counts and completion");
   bool trinoQueryCompleted   = trinoQuery->getIsCompleted();
@@ -113,8 +62,17 @@ SQLRETURN SQL_API SQLFetch(SQLHSTMT StatementHandle) {
   } else if (fetchedPosition < (trinoQueryRowCount - 1)) {
     // Handle the case that data is waiting to be read.
     WriteLog(LL_TRACE, "  There are more rows to read. Advancing row pointer.");
+    // A query that paused to let the application catch up still needs
+    // polling now and then, or Trino gives up on it.
+    trinoQuery->pollIfStalled();
+    if (trinoQuery->hasError()) {
+      WriteLog(LL_ERROR,
+               "  ERROR: Query failed: " + trinoQuery->getErrorMessage());
+      statement->setQueryError();
+      return SQL_ERROR;
+    }
     statement->setFetchedPosition(fetchedPosition + 1);
-    handleBoundColumns(statement);
+    writeBoundColumns(statement);
     return SQL_SUCCESS;
 
   } else if (not trinoQueryCompleted) {
@@ -128,6 +86,12 @@ SQLRETURN SQL_API SQLFetch(SQLHSTMT StatementHandle) {
     TrinoQueryPollMode pollMethod = statement->fetchPollMode;
     statement->trinoQuery->poll(pollMethod);
     WriteLog(LL_TRACE, "  Trino poll complete");
+    if (trinoQuery->hasError()) {
+      WriteLog(LL_ERROR,
+               "  ERROR: Query failed: " + trinoQuery->getErrorMessage());
+      statement->setQueryError();
+      return SQL_ERROR;
+    }
     int64_t newTrinoRowCount = trinoQuery->getCurrentRowCount();
     WriteLog(LL_TRACE, "  Got row count: " + std::to_string(newTrinoRowCount));
 
@@ -2,12 +2,120 @@
 #include <sql.h>
 #include <sqlext.h>
 
+#include <cstdint>
+#include <string>
+
+#include "../trinoAPIWrapper/trinoQuery.hpp"
 #include "../util/writeLog.hpp"
+#include "execution/boundColumns.hpp"
+#include "handles/statementHandle.hpp"
+
+/*
+Read rows until the given row is buffered or there are no more. Pass
+-1 to read the whole result, which is how the last row is found.
+*/
+static void pollUntilRowBuffered(TrinoQuery* trinoQuery, int64_t rowIndex) {
+  while (not trinoQuery->getIsCompleted() and
+         (rowIndex < 0 or rowIndex >= trinoQuery->getCurrentRowCount())) {
+    trinoQuery->poll(UntilNewData);
+  }
+}
 
 SQLRETURN SQL_API SQLFetchScroll(SQLHSTMT StatementHandle,
                                  SQLSMALLINT FetchOrientation,
                                  SQLLEN FetchOffset) {
   WriteLog(LL_TRACE, "Entering SQLFetchScroll");
-  WriteLog(LL_ERROR, "  ERROR: SQLFetchScroll is unimplemented");
-  return SQL_ERROR;
+  if (!StatementHandle) {
+    WriteLog(LL_ERROR, "  ERROR: Invalid statement handle");
+    return SQL_INVALID_HANDLE;
+  }
+  Statement* statement   = reinterpret_cast<Statement*>(StatementHandle);
+  TrinoQuery* trinoQuery = statement->trinoQuery;
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+
+  // A forward only cursor can only do what SQLFetch does.
+  if (statement->cursorType != SQL_CURSOR_STATIC) {
+    if (FetchOrientation == SQL_FETCH_NEXT) {
+      return SQLFetch(StatementHandle);
+    }
+    WriteLog(LL_ERROR,
+             "  ERROR: Forward only cursors can't fetch in direction " +
+                 std::to_string(FetchOrientation));
+    ErrorInfo errorInfo("Fetch type out of range", "HY106");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  }
+
+  /*
+  The cursor sits on a row, or before the first row at -1, or after
+  the last row at the row count. Every direction works out which row
+  to move to from there. Positions relative to the end of the result
+  need the whole result read first.
+  */
+  int64_t current = statement->getFetchedPosition();
+  int64_t target  = 0;
+  switch (FetchOrientation) {
+    case SQL_FETCH_NEXT: {
+      target = current + 1;
+      break;
+    }
+    case SQL_FETCH_PRIOR: {
+      target = current - 1;
+      break;
+    }
+    case SQL_FETCH_FIRST: {
+      target = 0;
+      break;
+    }
+    case SQL_FETCH_LAST: {
+      pollUntilRowBuffered(trinoQuery, -1);
+      target = trinoQuery->getCurrentRowCount() - 1;
+      break;
+    }
+    case SQL_FETCH_ABSOLUTE: {
+      if (FetchOffset > 0) {
+        target = FetchOffset - 1;
+      } else if (FetchOffset < 0) {
+        pollUntilRowBuffered(trinoQuery, -1);
+        target = trinoQuery->getCurrentRowCount() + FetchOffset;
+      } else {
+        target = -1;
+      }
+      break;
+    }
+    case SQL_FETCH_RELATIVE: {
+      target = current + FetchOffset;
+      break;
+    }
+    default: {
+      WriteLog(LL_ERROR,
+               "  ERROR: Unsupported fetch direction: " +
+                   std::to_string(FetchOrientation));
+      ErrorInfo errorInfo("Fetch type out of range", "HY106");
+      statement->setError(errorInfo);
+      return SQL_ERROR;
+    }
+  }
+
+  if (target < 0) {
+    statement->setFetchedPosition(-1);
+    return SQL_NO_DATA;
+  }
+  pollUntilRowBuffered(trinoQuery, target);
+  if (trinoQuery->hasError()) {
+    statement->setQueryError();
+    return SQL_ERROR;
+  }
+  int64_t rowCount = trinoQuery->getCurrentRowCount();
+  if (target >= rowCount) {
+    statement->setFetchedPosition(rowCount);
+    return SQL_NO_DATA;
+  }
+
+  if (getLogLevel() <= LL_TRACE) {
+    WriteLog(LL_TRACE, "  Scrolling to row " + std::to_string(target));
+  }
+  statement->setFetchedPosition(target);
+  writeBoundColumns(statement);
+  return SQL_SUCCESS;
 }
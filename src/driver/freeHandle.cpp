@@ -6,6 +6,7 @@
 #include "handles/descriptorHandle.hpp"
 #include "handles/envHandle.hpp"
 #include "handles/statementHandle.hpp"
+#include "handles/statementPool.hpp"
 
 using namespace std;
 
@@ -39,16 +40,22 @@ SQLRETURN SQL_API SQLFreeHandle(SQLSMALLINT HandleType, SQLHANDLE Handle) {
 
     case SQL_HANDLE_STMT: {
       Statement* stmt = reinterpret_cast<Statement*>(Handle);
+      LogLevelScope logScope(stmt->connectionConfig->logLevel);
       WriteLog(LL_TRACE, "  Freeing statement handle");
       // Some clients free the statement handle without terminating
       // a running query first. That means we need to be smart here
       // and assume the statement handle is not yet in a state that
       // is ready to be freed. We can prevent it from leaving Trino
-      // queries hanging in the `FINISHING` state by doing a terminate()
-      // before we free the statement. Conveniently, that does nothing
-      // if a query is not currently running.
-      stmt->terminate();
-      delete stmt;
+      // queries hanging in the `FINISHING` state by closing the cursor
+      // before we free the statement, which stops the query in the
+      // background. Conveniently, that does nothing if a query is not
+      // currently running.
+      stmt->closeCursor();
+      if (stmt->pool) {
+        stmt->pool->release(stmt);
+      } else {
+        delete stmt;
+      }
       return SQL_SUCCESS;
     }
 
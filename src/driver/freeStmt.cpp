@@ -8,12 +8,13 @@
 SQLRETURN SQL_API SQLFreeStmt(SQLHSTMT StatementHandle, SQLUSMALLINT Option) {
   WriteLog(LL_TRACE, "Entering SQLFreeStmt");
   Statement* stmt = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(stmt->connectionConfig->logLevel);
   switch (Option) {
     case (SQL_CLOSE): {
       WriteLog(
           LL_TRACE,
           "  Closing statement with SQL_CLOSE. The statement may be reused.");
-      stmt->reset();
+      stmt->closeCursor();
       return SQL_SUCCESS;
     }
     case (SQL_DROP): {
@@ -27,10 +28,10 @@ SQLRETURN SQL_API SQLFreeStmt(SQLHSTMT StatementHandle, SQLUSMALLINT Option) {
       return SQL_ERROR;
     }
     case (SQL_RESET_PARAMS): {
-      WriteLog(
-          LL_ERROR,
-          "  ERROR: Unimplemented: Closing statement with SQL_RESET_PARAMS");
-      return SQL_ERROR;
+      WriteLog(LL_TRACE, "  Unbinding all parameters with SQL_RESET_PARAMS");
+      stmt->getParamDescriptor()->reset();
+      stmt->getParamDescriptor()->Field_Count = 0;
+      return SQL_SUCCESS;
     }
     default: {
       WriteLog(LL_ERROR, "  ERROR: Unknown option in SQLFreeStmt");
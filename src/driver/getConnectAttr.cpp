@@ -2,8 +2,11 @@
 #include <sql.h>
 #include <sqlext.h>
 
+#include "../trinoAPIWrapper/resultCache.hpp"
 #include "../util/valuePtrHelper.hpp"
 #include "../util/writeLog.hpp"
+#include "constants/connectionAttrs.hpp"
+#include "handles/connHandle.hpp"
 
 
 SQLRETURN SQL_API SQLGetConnectAttr(
@@ -16,6 +19,8 @@ SQLRETURN SQL_API SQLGetConnectAttr(
   WriteLog(LL_TRACE,
            "  Application is requesting connection attribute: " +
                std::to_string(Attribute));
+  Connection* connection = reinterpret_cast<Connection*>(ConnectionHandle);
+  LogLevelScope logScope(connection->getLogLevel());
   switch (Attribute) {
     case (SQL_ATTR_CONNECTION_DEAD): {
     }
@@ -25,6 +30,50 @@ SQLRETURN SQL_API SQLGetConnectAttr(
       writeNullTermStringToPtr(Value, "system", StringLengthPtr);
       break;
     }
+    case SQL_ATTR_LOGIN_TIMEOUT: { // 103
+      if (Value) {
+        *reinterpret_cast<SQLUINTEGER*>(Value) = connection->ATTR_LoginTimeout;
+      }
+      break;
+    }
+    case SQL_ATTR_CONNECTION_TIMEOUT: { // 113
+      if (Value) {
+        *reinterpret_cast<SQLUINTEGER*>(Value) =
+            connection->ATTR_ConnectionTimeout;
+      }
+      break;
+    }
+    case SQL_ATTR_RESULT_CACHE_HITS: { // 16386
+      if (Value) {
+        *reinterpret_cast<SQLULEN*>(Value) = static_cast<SQLULEN>(
+            getResultCache().getCounters().hits);
+      }
+      break;
+    }
+    case SQL_ATTR_RESULT_CACHE_MISSES: { // 16387
+      if (Value) {
+        *reinterpret_cast<SQLULEN*>(Value) = static_cast<SQLULEN>(
+            getResultCache().getCounters().misses);
+      }
+      break;
+    }
+    case SQL_ATTR_CONNECTION_BUFFERED_BYTES: { // 16388
+      // Nothing is buffered before the connection is made.
+      if (Value) {
+        ConnectionConfig* config = connection->connectionConfig;
+        *reinterpret_cast<SQLULEN*>(Value) =
+            config ? static_cast<SQLULEN>(config->bufferedBytes) : 0;
+      }
+      break;
+    }
+    case SQL_ATTR_CONNECTION_PEAK_BUFFERED_BYTES: { // 16389
+      if (Value) {
+        ConnectionConfig* config = connection->connectionConfig;
+        *reinterpret_cast<SQLULEN*>(Value) =
+            config ? static_cast<SQLULEN>(config->peakBufferedBytes) : 0;
+      }
+      break;
+    }
     default: {
       WriteLog(LL_ERROR,
                "  ERROR: Application is requesting unimplemented connection "
@@ -38,6 +38,7 @@ SQLRETURN SQL_API SQLGetData(SQLHSTMT StatementHandle,
   */
   WriteLog(LL_TRACE, "Entering SQLGetData");
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
 
   const std::vector<ColumnDescription>& columnDescriptions =
       statement->trinoQuery->getColumnDescriptions();
@@ -59,14 +60,16 @@ SQLRETURN SQL_API SQLGetData(SQLHSTMT StatementHandle,
   const ColumnDescription& thisColumnDescription =
       columnDescriptions.at(columnNumber - 1);
   // The bookmark column is column 0
-  DescriptorField descriptorField = rowDescriptor->getField(columnNumber);
-  SQLSMALLINT odbcDataType        = descriptorField.odbcDataType;
+  const DescriptorBinding& binding = rowDescriptor->getBinding(columnNumber);
+  SQLSMALLINT odbcDataType         = binding.odbcDataType;
 
   SQLLEN fetchedPosition = statement->getFetchedPosition();
-  const json& rowData = statement->trinoQuery->getRowAtIndex(fetchedPosition);
+  statement->trinoQuery->markColumnInUse(columnNumber - 1);
+  const json& cellData =
+      statement->trinoQuery->getCellAtIndex(fetchedPosition, columnNumber - 1);
 
   // Handle null data
-  if (rowData[columnNumber - 1].is_null()) {
+  if (cellData.is_null()) {
     if (strLen_or_IndPtr) {
       *strLen_or_IndPtr = SQL_NULL_DATA;
     }
@@ -83,21 +86,79 @@ SQLRETURN SQL_API SQLGetData(SQLHSTMT StatementHandle,
     WriteLog(LL_TRACE, "  CDataType is: " + std::to_string(cDataType));
   }
 
+  /*
+  Binary values can be read in pieces by calling SQLGetData repeatedly
+  on the same column. Each call continues where the last one stopped,
+  and once everything has been returned, the next call gets
+  SQL_NO_DATA.
+  */
+  bool isPiecewise      = cDataType == SQL_C_BINARY;
+  SQLLEN sourceOffset   = 0;
+  SQLLEN localIndicator = 0;
+  if (isPiecewise) {
+    if (statement->getDataColumn == columnNumber) {
+      sourceOffset = statement->getDataOffset;
+    } else {
+      statement->getDataColumn = columnNumber;
+      statement->getDataOffset = 0;
+    }
+    if (sourceOffset < 0) {
+      return SQL_NO_DATA;
+    }
+    // We need the remaining length even if the application doesn't.
+    if (not strLen_or_IndPtr) {
+      strLen_or_IndPtr = &localIndicator;
+    }
+  }
+
   ColumnToBufferStatus status = columnToBuffer(cDataType,
                                                odbcDataType,
-                                               rowData,
+                                               cellData,
                                                columnNumber,
                                                buffer,
                                                bufferLength,
                                                strLen_or_IndPtr,
-                                               descriptorField.precision,
-                                               descriptorField.scale);
+                                               binding.precision,
+                                               binding.scale,
+                                               sourceOffset);
+
+  if (not status.isSuccess and status.isOutOfRange) {
+    ErrorInfo errorInfo = ErrorInfo(
+        "Numeric value out of range in column " + std::to_string(columnNumber),
+        "22003");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  }
+  if (not status.isSuccess) {
+    ErrorInfo errorInfo = ErrorInfo(
+        "Could not convert column " + std::to_string(columnNumber) +
+            " to C type " + std::to_string(cDataType),
+        "22018");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  }
+
+  if (isPiecewise) {
+    // Binary data has no null terminator, so it's only truncated if
+    // more remains than the buffer holds.
+    SQLLEN remaining = *strLen_or_IndPtr;
+    if (remaining > bufferLength) {
+      statement->getDataOffset = sourceOffset + bufferLength;
+      ErrorInfo errorInfo = ErrorInfo("String data, right truncated", "01004");
+      statement->setError(errorInfo);
+      return SQL_SUCCESS_WITH_INFO;
+    }
+    statement->getDataOffset = -1;
+    return SQL_SUCCESS;
+  }
 
   // If the client doesn't reserve enough buffer space to hold the variable
   // length data returned, we need to right-truncate it to fit the buffer
-  // and return a different status to warn the client.
+  // and return a different status to warn the client. The buffer also
+  // has to hold the null terminator, so a value exactly as long as the
+  // buffer is truncated too.
   if (status.isVariableLength and strLen_or_IndPtr and
-      *strLen_or_IndPtr > bufferLength) {
+      *strLen_or_IndPtr >= bufferLength) {
     ErrorInfo errorInfo = ErrorInfo("String data, right truncated", "01004");
     statement->setError(errorInfo);
     return SQL_SUCCESS_WITH_INFO;
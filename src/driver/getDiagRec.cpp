@@ -1,6 +1,7 @@
 #include "../util/windowsLean.hpp"
 #include <sql.h>
 #include <sqlext.h>
+#include <sqlucode.h>
 
 #include "handles/connHandle.hpp"
 #include "handles/descriptorHandle.hpp"
@@ -10,21 +11,15 @@
 #include "../util/valuePtrHelper.hpp"
 #include "../util/writeLog.hpp"
 
-SQLRETURN SQL_API SQLGetDiagRec(SQLSMALLINT HandleType,
+/*
+Find the requested diagnostic record. Returns SQL_SUCCESS and fills in
+errorInfo if there is one, SQL_NO_DATA if there isn't, and SQL_ERROR
+for an unknown handle type.
+*/
+static SQLRETURN findDiagRecord(SQLSMALLINT HandleType,
                                 SQLHANDLE Handle,
                                 SQLSMALLINT RecNumber,
-                                _Out_writes_opt_(6) SQLCHAR* SqlStatePtr,
-                                SQLINTEGER* NativeErrorPtr,
-                                _Out_writes_opt_(BufferLength)
-                                    SQLCHAR* MessageTextPtr,
-                                SQLSMALLINT BufferLength,
-                                _Out_opt_ SQLSMALLINT* TextLengthPtr) {
-  /*
-  Return a series of 1-indexed diagnostic records from various handles.
-  If a record is requested beyond what is actually available, return
-  SQL_NO_DATA instead.
-  */
-  WriteLog(LL_ERROR, "Entering SQLGetDiagRec");
+                                ErrorInfo& errorInfo) {
   switch (HandleType) {
     case (SQL_HANDLE_ENV): {
       Environment* env = reinterpret_cast<Environment*>(Handle);
@@ -38,13 +33,8 @@ SQLRETURN SQL_API SQLGetDiagRec(SQLSMALLINT HandleType,
       WriteLog(LL_ERROR, "  Requesting diagnostics for connection handle");
       WriteLog(LL_ERROR,
                "  Requesting RecNumber: " + std::to_string(RecNumber));
-      ErrorInfo errorInfo = conn->getError();
+      errorInfo = conn->getError();
       if (RecNumber == 1 and errorInfo.errorOccurred()) {
-        writeNullTermStringToPtr<SQLINTEGER>(
-            SqlStatePtr, errorInfo.sqlStateCode, nullptr);
-        writeNullTermStringToPtr(
-            MessageTextPtr, errorInfo.errorMessage, TextLengthPtr);
-        *NativeErrorPtr = -1;
         return SQL_SUCCESS;
       } else {
         return SQL_NO_DATA;
@@ -52,10 +42,16 @@ SQLRETURN SQL_API SQLGetDiagRec(SQLSMALLINT HandleType,
     }
     case (SQL_HANDLE_STMT): {
       Statement* statement = reinterpret_cast<Statement*>(Handle);
+      LogLevelScope logScope(statement->connectionConfig->logLevel);
       WriteLog(LL_ERROR, "  Requesting diagnostics for statement handle");
       WriteLog(LL_ERROR,
                "  Requesting RecNumber: " + std::to_string(RecNumber));
-      return SQL_NO_DATA;
+      errorInfo = statement->getError();
+      if (RecNumber == 1 and errorInfo.errorOccurred()) {
+        return SQL_SUCCESS;
+      } else {
+        return SQL_NO_DATA;
+      }
     }
     case (SQL_HANDLE_DESC): {
       Descriptor* descriptor = reinterpret_cast<Descriptor*>(Handle);
@@ -70,3 +66,65 @@ SQLRETURN SQL_API SQLGetDiagRec(SQLSMALLINT HandleType,
     }
   }
 }
+
+SQLRETURN SQL_API SQLGetDiagRec(SQLSMALLINT HandleType,
+                                SQLHANDLE Handle,
+                                SQLSMALLINT RecNumber,
+                                _Out_writes_opt_(6) SQLCHAR* SqlStatePtr,
+                                SQLINTEGER* NativeErrorPtr,
+                                _Out_writes_opt_(BufferLength)
+                                    SQLCHAR* MessageTextPtr,
+                                SQLSMALLINT BufferLength,
+                                _Out_opt_ SQLSMALLINT* TextLengthPtr) {
+  /*
+  Return a series of 1-indexed diagnostic records from various handles.
+  If a record is requested beyond what is actually available, return
+  SQL_NO_DATA instead.
+  */
+  WriteLog(LL_ERROR, "Entering SQLGetDiagRec");
+  ErrorInfo errorInfo;
+  SQLRETURN ret = findDiagRecord(HandleType, Handle, RecNumber, errorInfo);
+  if (ret != SQL_SUCCESS) {
+    return ret;
+  }
+  writeNullTermStringToPtr<SQLINTEGER>(
+      SqlStatePtr, errorInfo.sqlStateCode, nullptr);
+  writeNullTermStringToPtr(
+      MessageTextPtr, errorInfo.errorMessage, TextLengthPtr);
+  if (NativeErrorPtr) {
+    *NativeErrorPtr = -1;
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLGetDiagRecW(SQLSMALLINT HandleType,
+                                 SQLHANDLE Handle,
+                                 SQLSMALLINT RecNumber,
+                                 _Out_writes_opt_(6) SQLWCHAR* SqlStatePtr,
+                                 SQLINTEGER* NativeErrorPtr,
+                                 _Out_writes_opt_(BufferLength)
+                                     SQLWCHAR* MessageTextPtr,
+                                 SQLSMALLINT BufferLength,
+                                 _Out_opt_ SQLSMALLINT* TextLengthPtr) {
+  // BufferLength and TextLengthPtr are counts of characters here.
+  WriteLog(LL_ERROR, "Entering SQLGetDiagRecW");
+  ErrorInfo errorInfo;
+  SQLRETURN ret = findDiagRecord(HandleType, Handle, RecNumber, errorInfo);
+  if (ret != SQL_SUCCESS) {
+    return ret;
+  }
+  // The SQLSTATE buffer is always six characters including the null.
+  writeNullTermWideStringToPtr(SqlStatePtr, errorInfo.sqlStateCode, 6);
+  size_t messageChars = writeNullTermWideStringToPtr(
+      MessageTextPtr, errorInfo.errorMessage, BufferLength);
+  if (TextLengthPtr) {
+    *TextLengthPtr = static_cast<SQLSMALLINT>(messageChars);
+  }
+  if (NativeErrorPtr) {
+    *NativeErrorPtr = -1;
+  }
+  if (MessageTextPtr and messageChars >= static_cast<size_t>(BufferLength)) {
+    return SQL_SUCCESS_WITH_INFO;
+  }
+  return SQL_SUCCESS;
+}
@@ -15,6 +15,7 @@ _Success_(return == SQL_SUCCESS) SQLRETURN SQL_API
                SQLSMALLINT BufferLength,
                _Out_opt_ SQLSMALLINT* StringLengthPtr) {
   Connection* connection = reinterpret_cast<Connection*>(ConnectionHandle);
+  LogLevelScope logScope(connection->getLogLevel());
   WriteLog(LL_TRACE, "Entering SQLGetInfo");
   WriteLog(LL_TRACE,
            "  Requesting information type: " + std::to_string(InfoType));
@@ -133,6 +134,12 @@ _Success_(return == SQL_SUCCESS) SQLRETURN SQL_API
       writeNullTermStringToPtr(InfoValue, "catalog", StringLengthPtr);
       break;
     }
+    case SQL_SCROLL_OPTIONS: { // 44
+      // Static cursors are the only scrollable ones. Trino results
+      // can't change while they're being read.
+      *((SQLUINTEGER*)InfoValue) = SQL_SO_FORWARD_ONLY | SQL_SO_STATIC;
+      break;
+    }
     case SQL_CONVERT_FUNCTIONS: { // 48
       // What convert functions does Trino support?
       // clang-format off
@@ -653,6 +660,10 @@ _Success_(return == SQL_SUCCESS) SQLRETURN SQL_API
       *((SQLUINTEGER*)InfoValue) = 0 | 0;
       break;
     }
+    case SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1: { // 146
+      *((SQLUINTEGER*)InfoValue) = SQL_CA1_NEXT;
+      break;
+    }
     case SQL_ODBC_INTERFACE_CONFORMANCE: { // 152
       // How much of the ODBC interface spec does this driver implement?
       // Just the core level for now.
@@ -713,6 +724,17 @@ _Success_(return == SQL_SUCCESS) SQLRETURN SQL_API
       // clang-format on
       break;
     }
+    case SQL_STATIC_CURSOR_ATTRIBUTES1: { // 167
+      // SQLFetchScroll moves static cursors in every direction except
+      // to a bookmark. Positioned updates aren't supported.
+      *((SQLUINTEGER*)InfoValue) =
+          SQL_CA1_NEXT | SQL_CA1_ABSOLUTE | SQL_CA1_RELATIVE;
+      break;
+    }
+    case SQL_STATIC_CURSOR_ATTRIBUTES2: { // 168
+      *((SQLUINTEGER*)InfoValue) = SQL_CA2_READ_ONLY_CONCURRENCY;
+      break;
+    }
     case SQL_AGGREGATE_FUNCTIONS: { // 169
       // What aggregate functions does Trino support?
       *((SQLUINTEGER*)InfoValue) =
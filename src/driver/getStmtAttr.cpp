@@ -25,8 +25,47 @@ SQLRETURN SQL_API SQLGetStmtAttr(SQLHSTMT StatementHandle,
   }
 
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
 
   switch (Attribute) {
+    case SQL_ATTR_CURSOR_SCROLLABLE: { // -1
+      if (Value) {
+        *reinterpret_cast<SQLULEN*>(Value) =
+            statement->cursorType == SQL_CURSOR_STATIC ? SQL_SCROLLABLE
+                                                       : SQL_NONSCROLLABLE;
+      }
+      if (StringLength) {
+        *StringLength = sizeof(SQLULEN);
+      }
+      break;
+    }
+    case SQL_ATTR_QUERY_TIMEOUT: { // 0
+      if (Value) {
+        *reinterpret_cast<SQLULEN*>(Value) = statement->queryTimeout;
+      }
+      if (StringLength) {
+        *StringLength = sizeof(SQLULEN);
+      }
+      break;
+    }
+    case SQL_ATTR_MAX_ROWS: { // 1
+      if (Value) {
+        *reinterpret_cast<SQLULEN*>(Value) = statement->maxRows;
+      }
+      if (StringLength) {
+        *StringLength = sizeof(SQLULEN);
+      }
+      break;
+    }
+    case SQL_ATTR_CURSOR_TYPE: { // 6
+      if (Value) {
+        *reinterpret_cast<SQLULEN*>(Value) = statement->cursorType;
+      }
+      if (StringLength) {
+        *StringLength = sizeof(SQLULEN);
+      }
+      break;
+    }
     case SQL_ATTR_ROW_NUMBER: { // 14
       if (Value) {
         *reinterpret_cast<SQLULEN*>(Value) = statement->getFetchedPosition();
@@ -36,6 +75,56 @@ SQLRETURN SQL_API SQLGetStmtAttr(SQLHSTMT StatementHandle,
       }
       break;
     }
+    case SQL_ATTR_PARAM_BIND_OFFSET_PTR: { // 17
+      if (Value) {
+        *reinterpret_cast<SQLLEN**>(Value) =
+            statement->getParamDescriptor()->Field_BindOffsetPtr;
+      }
+      if (StringLength) {
+        *StringLength = sizeof(SQLLEN*);
+      }
+      break;
+    }
+    case SQL_ATTR_PARAM_BIND_TYPE: { // 18
+      if (Value) {
+        *reinterpret_cast<SQLULEN*>(Value) =
+            statement->getParamDescriptor()->Field_BindType;
+      }
+      if (StringLength) {
+        *StringLength = sizeof(SQLULEN);
+      }
+      break;
+    }
+    case SQL_ATTR_PARAM_STATUS_PTR: { // 20
+      if (Value) {
+        *reinterpret_cast<SQLUSMALLINT**>(Value) =
+            statement->impParamDesc->Field_ArrayStatusPtr;
+      }
+      if (StringLength) {
+        *StringLength = sizeof(SQLUSMALLINT*);
+      }
+      break;
+    }
+    case SQL_ATTR_PARAMS_PROCESSED_PTR: { // 21
+      if (Value) {
+        *reinterpret_cast<SQLULEN**>(Value) =
+            statement->impParamDesc->Field_RowsProcessedPtr;
+      }
+      if (StringLength) {
+        *StringLength = sizeof(SQLULEN*);
+      }
+      break;
+    }
+    case SQL_ATTR_PARAMSET_SIZE: { // 22
+      if (Value) {
+        *reinterpret_cast<SQLULEN*>(Value) =
+            statement->getParamDescriptor()->Field_ArraySize;
+      }
+      if (StringLength) {
+        *StringLength = sizeof(SQLULEN);
+      }
+      break;
+    }
     case SQL_ATTR_APP_ROW_DESC: { // 10010
       if (Value) {
         *reinterpret_cast<SQLPOINTER*>(Value) = statement->appRowDesc;
@@ -82,6 +171,36 @@ SQLRETURN SQL_API SQLGetStmtAttr(SQLHSTMT StatementHandle,
       }
       break;
     }
+    case SQL_ATTR_BUFFERED_BYTES: { // 1003
+      if (Value) {
+        *reinterpret_cast<SQLULEN*>(Value) =
+            static_cast<SQLULEN>(statement->trinoQuery->getBufferedBytes());
+      }
+      if (StringLength) {
+        *StringLength = sizeof(SQLULEN);
+      }
+      break;
+    }
+    case SQL_ATTR_PEAK_BUFFERED_BYTES: { // 1004
+      if (Value) {
+        *reinterpret_cast<SQLULEN*>(Value) = static_cast<SQLULEN>(
+            statement->trinoQuery->getPeakBufferedBytes());
+      }
+      if (StringLength) {
+        *StringLength = sizeof(SQLULEN);
+      }
+      break;
+    }
+    case SQL_ATTR_SPILLED_BYTES: { // 1005
+      if (Value) {
+        *reinterpret_cast<SQLULEN*>(Value) =
+            static_cast<SQLULEN>(statement->trinoQuery->getSpilledBytes());
+      }
+      if (StringLength) {
+        *StringLength = sizeof(SQLULEN);
+      }
+      break;
+    }
     default: {
       WriteLog(LL_ERROR,
                "  ERROR: Unsupported attribute: " + std::to_string(Attribute));
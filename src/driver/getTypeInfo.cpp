@@ -3,7 +3,9 @@
 #include <sqlext.h>
 
 #include <map>
+#include <memory>
 #include <nlohmann/json.hpp>
+#include <vector>
 
 #include "../util/writeLog.hpp"
 #include "handles/statementHandle.hpp"
@@ -73,7 +75,7 @@ class TypeInfo {
       this->intervalPrecision = intervalPrecision;
     }
 
-    json toJson() {
+    json toJson() const {
       return json::array(
           {typeName,
            dataType,
@@ -149,60 +151,85 @@ TypeInfo decimalTypeInfo   = TypeInfo(  "DECIMAL",   SQL_DECIMAL,          39,
 // clang-format on
 
 
+/*
+SQLGetTypeInfo results never change, and some applications ask for
+them once for every column they describe. Each result is built once
+when the driver loads, and its page is shared by every statement.
+*/
+static StaticResult typeInfoResult(const std::vector<TypeInfo>& typeInfos) {
+  json rows = json::array();
+  for (const TypeInfo& typeInfo : typeInfos) {
+    rows.push_back(typeInfo.toJson());
+  }
+  StaticResult result;
+  result.columns = columnDescription["columns"].get<std::vector<json>>();
+  result.pages   = {std::make_shared<ResultPage>(rows)};
+  return result;
+}
+
+// TODO: JSON TYPE
+// TODO: INTERVAL TYPE
+// TODO: ARRAY TYPE
+// TODO: MAP TYPE
+// TODO: TIME/TIMESTAMP WITH TIME ZONE?
+const StaticResult allTypesResult = typeInfoResult({
+    varcharTypeInfo,
+    varbinaryTypeInfo,
+    bitTypeInfo,
+    tinyintTypeInfo,
+    smallintTypeInfo,
+    integerTypeInfo,
+    bigintTypeInfo,
+    realTypeInfo,
+    doubleTypeInfo,
+    guidTypeInfo,
+    dateTypeInfo,
+    timeTypeInfo,
+    timestampTypeInfo,
+    decimalTypeInfo,
+});
+const StaticResult varcharTypeResult   = typeInfoResult({varcharTypeInfo});
+const StaticResult varbinaryTypeResult = typeInfoResult({varbinaryTypeInfo});
+const StaticResult timestampTypeResult = typeInfoResult({timestampTypeInfo});
+
+
 SQLRETURN SQL_API SQLGetTypeInfo(SQLHSTMT StatementHandle,
                                  SQLSMALLINT DataType) {
   WriteLog(LL_TRACE, "Entering SQLGetTypeInfo");
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
   WriteLog(LL_TRACE,
            "  Requesting type info for type code: " + std::to_string(DataType));
 
-  json typeResponse = columnDescription;
+  const StaticResult* typeResult = nullptr;
   switch (DataType) {
     case SQL_ALL_TYPES: {
-      // TODO: JSON TYPE
-      // TODO: INTERVAL TYPE
-      // TODO: ARRAY TYPE
-      // TODO: MAP TYPE
-      // TODO: TIME/TIMESTAMP WITH TIME ZONE?
-      typeResponse["data"] = json::array({
-          varcharTypeInfo.toJson(),
-          varbinaryTypeInfo.toJson(),
-          bitTypeInfo.toJson(),
-          tinyintTypeInfo.toJson(),
-          smallintTypeInfo.toJson(),
-          integerTypeInfo.toJson(),
-          bigintTypeInfo.toJson(),
-          realTypeInfo.toJson(),
-          doubleTypeInfo.toJson(),
-          guidTypeInfo.toJson(),
-          dateTypeInfo.toJson(),
-          timeTypeInfo.toJson(),
-          timestampTypeInfo.toJson(),
-          decimalTypeInfo.toJson(),
-      });
+      typeResult = &allTypesResult;
       break;
     }
     case SQL_WVARCHAR: {
       // TODO: Does WVARCHAR exist in Trino?
       // Is WVARCHAR any different than varchar?
       // I'm guessing Trino uses UTF-8, and not any wide varchars.
-      typeResponse["data"] = json::array({varcharTypeInfo.toJson()});
+      typeResult = &varcharTypeResult;
       break;
     }
     case SQL_VARCHAR: {
-      typeResponse["data"] = json::array({varcharTypeInfo.toJson()});
+      typeResult = &varcharTypeResult;
       break;
     }
-    case SQL_VARBINARY: {
-      typeResponse["data"] = json::array({varbinaryTypeInfo.toJson()});
+    case SQL_VARBINARY:
+    case SQL_LONGVARBINARY: {
+      // Trino's varbinary has no length limit, so it's the long type too.
+      typeResult = &varbinaryTypeResult;
       break;
     }
     case SQL_TIMESTAMP: {
-      typeResponse["data"] = json::array({timestampTypeInfo.toJson()});
+      typeResult = &timestampTypeResult;
       break;
     }
     case SQL_TYPE_TIMESTAMP: {
-      typeResponse["data"] = json::array({timestampTypeInfo.toJson()});
+      typeResult = &timestampTypeResult;
       break;
     }
     default: {
@@ -212,7 +239,7 @@ SQLRETURN SQL_API SQLGetTypeInfo(SQLHSTMT StatementHandle,
       return SQL_ERROR;
     }
   }
-  statement->trinoQuery->sideloadResponse(typeResponse);
+  statement->trinoQuery->sideloadResult(*typeResult);
   WriteLog(LL_TRACE,
            "  SQLGetTypeInfo returning success for type id: " +
                std::to_string(DataType));
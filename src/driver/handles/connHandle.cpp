@@ -1,19 +1,33 @@
 #include "connHandle.hpp"
 
+#include <chrono>
+
+#include "../../util/writeLog.hpp"
+
 Connection::Connection(EnvironmentConfig* environmentConfig) {
   this->environmentConfig = environmentConfig;
 }
 
 Connection::~Connection() {
+  // Pooled statements still point at the connection config.
+  this->statementPool.clear();
   if (this->connectionConfig) {
     delete this->connectionConfig;
   }
 }
 
 void Connection::disconnect() {
+  this->statementPool.clear();
   this->connectionConfig->disconnect();
 }
 
+LogLevel Connection::getLogLevel() {
+  if (this->connectionConfig) {
+    return this->connectionConfig->logLevel;
+  }
+  return ::getLogLevel();
+}
+
 std::string Connection::getServerVersion() {
   return this->connectionConfig->getTrinoServerVersion();
 }
@@ -29,6 +43,39 @@ void Connection::configure(DriverConfig config) {
                                                 config.getClientId(),
                                                 config.getClientSecret(),
                                                 config.getOidcScope());
+  this->connectionConfig->logLevel = config.getLogLevelEnum();
+  this->connectionConfig->requestLoop =
+      &this->environmentConfig->getRequestLoop();
+  this->connectionConfig->metadataCache.configure(
+      std::chrono::seconds(config.getMetadataCacheTTLNum()),
+      config.getMetadataCacheSizeNum(),
+      config.getSchemaPrefetchBool());
+
+  ResultCacheSettings& resultCacheSettings =
+      this->connectionConfig->resultCacheSettings;
+  resultCacheSettings.timeToLive =
+      std::chrono::seconds(config.getResultCacheTTLNum());
+  resultCacheSettings.maxBytes =
+      static_cast<size_t>(config.getResultCacheSizeNum()) * 1024 * 1024;
+  resultCacheSettings.diskDirectory = config.getResultCacheDir();
+  if (resultCacheSettings.timeToLive.count() > 0) {
+    getResultCache().reserve(resultCacheSettings.maxBytes);
+  }
+
+  SpillSettings& spillSettings = this->connectionConfig->spillSettings;
+  spillSettings.statementBufferLimit =
+      static_cast<size_t>(config.getStatementBufferLimitNum()) * 1024 * 1024;
+  spillSettings.connectionBufferLimit =
+      static_cast<size_t>(config.getConnectionBufferLimitNum()) * 1024 * 1024;
+
+  this->connectionConfig->segmentDownloadThreads =
+      config.getSegmentDownloadThreadsNum();
+  this->connectionConfig->spoolingEncoding = config.getSpoolingEncoding();
+
+  this->connectionConfig->loginTimeout =
+      std::chrono::seconds(this->ATTR_LoginTimeout);
+  this->connectionConfig->connectionTimeout =
+      std::chrono::seconds(this->ATTR_ConnectionTimeout);
 }
 
 void Connection::setError(ErrorInfo errorInfo) {
@@ -9,6 +9,7 @@
 #include "../config/driverConfig.hpp"
 #include "handleErrorInfo.hpp"
 #include "statementHandle.hpp"
+#include "statementPool.hpp"
 
 class Connection {
   private:
@@ -21,11 +22,17 @@ class Connection {
     void configure(DriverConfig config);
     bool connected                     = false;
     ConnectionConfig* connectionConfig = nullptr;
+    // Freed statements, kept to be handed out again.
+    StatementPool statementPool;
     void disconnect();
 
-    SQLINTEGER ATTR_AutoCommitMode = SQL_AUTOCOMMIT_ON;
-    SQLUINTEGER ATTR_LoginTimeout  = 0;
+    SQLINTEGER ATTR_AutoCommitMode     = SQL_AUTOCOMMIT_ON;
+    SQLUINTEGER ATTR_LoginTimeout      = 0;
+    SQLUINTEGER ATTR_ConnectionTimeout = 0;
 
+    // The level the connection's calls log at, or the process's before
+    // it's connected.
+    LogLevel getLogLevel();
     std::string getServerVersion();
     void setError(ErrorInfo errorInfo);
     ErrorInfo getError();
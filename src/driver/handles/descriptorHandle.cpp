@@ -3,7 +3,7 @@
 
 
 Descriptor::Descriptor(SQLSMALLINT columnCount) {
-  this->fields.resize(columnCount);
+  this->resize(columnCount);
   // We may need to manage memory allocation/deallocation
   // for these, but maybe if we leave them all as nullptrs
   // it will just work. Let's try it, but leave the code
@@ -19,39 +19,67 @@ Descriptor::~Descriptor() {
   // delete[] this->Field_BindOffsetPtr;
 }
 
-void Descriptor::setField(SQLSMALLINT columnIndex, DescriptorField& field) {
-  if (columnIndex >= static_cast<SQLSMALLINT>(this->fields.size())) {
+void Descriptor::ensureColumn(SQLSMALLINT columnIndex) {
+  if (columnIndex >= static_cast<SQLSMALLINT>(this->bindings.size())) {
     // It's entirely possible that the ODBC driver will try to bind
     // a column before Trino has returned any column information to us.
-    // That's okay, we'll just resize the fields array to accomodate.
+    // That's okay, we'll just resize the records to accomodate.
     // We need to leave room for the bookmark column on the front.
-    this->fields.resize(columnIndex + 1);
+    this->resize(columnIndex + 1);
   }
-  this->fields[columnIndex] = field;
 }
 
-DescriptorField Descriptor::getField(SQLSMALLINT columnIndex) {
+const DescriptorBinding& Descriptor::getBinding(SQLSMALLINT columnIndex) {
+  static const DescriptorBinding EMPTY_BINDING;
   if (columnIndex < 0 ||
-      columnIndex >= static_cast<SQLSMALLINT>(this->fields.size())) {
-    return DescriptorField();
+      columnIndex >= static_cast<SQLSMALLINT>(this->bindings.size())) {
+    return EMPTY_BINDING;
   }
-  return this->fields[columnIndex];
+  return this->bindings[columnIndex];
 }
 
-const DescriptorField& Descriptor::getFieldRef(SQLSMALLINT columnIndex) {
-  // We shouldn't ask for a field by reference before we've set up the
-  // descriptors. Hopefully this holds true.
-  return this->fields[columnIndex];
+const DescriptorMetadata& Descriptor::getMetadata(SQLSMALLINT columnIndex) {
+  static const DescriptorMetadata EMPTY_METADATA;
+  if (columnIndex < 0 ||
+      columnIndex >= static_cast<SQLSMALLINT>(this->metadata.size())) {
+    return EMPTY_METADATA;
+  }
+  return this->metadata[columnIndex];
+}
+
+const std::vector<DescriptorBinding>& Descriptor::getBindings() {
+  return this->bindings;
+}
+
+DescriptorBinding& Descriptor::editBinding(SQLSMALLINT columnIndex) {
+  this->ensureColumn(columnIndex);
+  return this->bindings[columnIndex];
+}
+
+DescriptorMetadata& Descriptor::editMetadata(SQLSMALLINT columnIndex) {
+  this->ensureColumn(columnIndex);
+  return this->metadata[columnIndex];
 }
 
 void Descriptor::resize(SQLSMALLINT newSize) {
-  this->fields.resize(newSize);
+  this->bindings.resize(newSize);
+  this->metadata.resize(newSize);
 }
 
 void Descriptor::reset() {
-  this->fields.resize(0);
+  this->resize(0);
+}
+
+void Descriptor::recycle() {
+  std::vector<DescriptorBinding> bindings  = std::move(this->bindings);
+  std::vector<DescriptorMetadata> metadata = std::move(this->metadata);
+  bindings.clear();
+  metadata.clear();
+  *this          = Descriptor();
+  this->bindings = std::move(bindings);
+  this->metadata = std::move(metadata);
 }
 
 SQLSMALLINT Descriptor::getColumnCount() {
-  return static_cast<SQLSMALLINT>(this->fields.size());
+  return static_cast<SQLSMALLINT>(this->bindings.size());
 }
@@ -6,36 +6,38 @@
 #include <string>
 #include <vector>
 
-
-struct DescriptorField {
+/*
+A descriptor's records are kept in two tables. The bindings hold what
+converting a value needs, and every SQLFetch and SQLGetData reads
+them, so they're packed small enough for two to share a cache line
+and stored side by side. The metadata, names and all, is only read
+when the application asks about a column.
+*/
+struct DescriptorBinding {
     // SQL Data type of the field
     SQLSMALLINT odbcDataType = SQL_UNKNOWN_TYPE;
     // C Data type of the field
     SQLSMALLINT bufferCDataType = SQL_UNKNOWN_TYPE;
+    // Precision and Scale of the data.
+    // Decimals have both a precision and scale. Integral and floating
+    // point types have precision but no fixed scale.
+    // This is undefined for many other types, so we'll just throw a
+    // default zero into both of them.
+    SQLCHAR scale     = 0;
+    SQLCHAR precision = 0;
     // Data buffer, if column is bound
     SQLPOINTER bufferPtr = nullptr;
     // Length of the data buffer
     SQLLEN bufferLength = -1;
     // Length/indicator buffer.
     SQLLEN* bufferStrLenOrIndPtr = nullptr;
+};
+
+struct DescriptorMetadata {
     // String name of the column being described
     std::string columnName;
     // The raw type name as returned by Trino
     std::string trinoRawTypeName;
-    /* Concise data type */
-    // SQLSMALLINT concise_type;
-    /* Pointer to the indicator buffer (for nulls) */
-    // SQLPOINTER indicator_ptr;
-    /* Pointer to the octet length buffer */
-    // SQLPOINTER octet_length_ptr;
-
-    // Precision and Scale of the data.
-    // Decimals have both a precision and scale. Integral and floating
-    // point types have precision but no fixed scale.
-    // This is undefined for many other types, so we'll just throw a
-    // default zero into both of them.
-    SQLCHAR scale     = 0;
-    SQLCHAR precision = 0;
     // The base of the numbers specified for the precions/scale of this data.
     // Floats and ints use Binary (base 2) precision. Decimal numbers use
     // base 10 precision. Most other types use not applicable (0).
@@ -61,17 +63,27 @@ struct DescriptorField {
 
 class Descriptor {
   private:
-    std::vector<DescriptorField> fields;
+    // Both tables are indexed by column and always the same size.
+    std::vector<DescriptorBinding> bindings;
+    std::vector<DescriptorMetadata> metadata;
+    void ensureColumn(SQLSMALLINT columnIndex);
 
   public:
     Descriptor(SQLSMALLINT columnCount = 0);
     ~Descriptor();
 
-    void setField(SQLSMALLINT columnIndex, DescriptorField& field);
-    DescriptorField getField(SQLSMALLINT columnIndex);
-    const DescriptorField& getFieldRef(SQLSMALLINT columnIndex);
+    // An empty record if the column hasn't been described or bound.
+    const DescriptorBinding& getBinding(SQLSMALLINT columnIndex);
+    const DescriptorMetadata& getMetadata(SQLSMALLINT columnIndex);
+    // Every column's binding, for fetches that walk all of them.
+    const std::vector<DescriptorBinding>& getBindings();
+    // The record to update in place, added if it isn't there yet.
+    DescriptorBinding& editBinding(SQLSMALLINT columnIndex);
+    DescriptorMetadata& editMetadata(SQLSMALLINT columnIndex);
     void resize(SQLSMALLINT newSize);
     void reset();
+    // Forget the records and header, but keep the memory for the records.
+    void recycle();
     SQLSMALLINT getColumnCount();
 
     // HEADER FIELDS
@@ -16,63 +16,69 @@ void Statement::columnsChangedCallback(TrinoQuery* trinoQuery) {
   int i = 1;
   for (const ColumnDescription& colDescription :
        trinoQuery->getColumnDescriptions()) {
-    DescriptorField field           = rowDescriptor->getField(i);
+    DescriptorBinding& binding      = rowDescriptor->editBinding(i);
+    DescriptorMetadata& metadata    = rowDescriptor->editMetadata(i);
     const std::string& trinoRawType = colDescription.getRawType();
-    field.columnName                = colDescription.getName();
-    field.trinoRawTypeName          = trinoRawType;
+    metadata.columnName             = colDescription.getName();
+    metadata.trinoRawTypeName       = trinoRawType;
     // TODO: How do we find out what fields are actually nullable from Trino?
-    field.nullable = true;
+    metadata.nullable = true;
     if (colDescription.getRawType() == "decimal") {
       // Decimal precision and scale are the values of the first and second
       // type arguments. Decimal types use a numerical precision radix of 10,
       // but that is set by the TRINO_RAW_TYPE_TO_NUM_PREC_RADIX lookup.
-      field.precision =
+      binding.precision =
           colDescription.getTypeArguments()[0]["value"].get<SQLCHAR>();
-      field.scale =
+      binding.scale =
           colDescription.getTypeArguments()[1]["value"].get<SQLCHAR>();
     }
     // Not all types have precision, but if they do, set it.
     if (TRINO_RAW_TYPE_TO_PRECISION.contains(trinoRawType)) {
-      field.precision = TRINO_RAW_TYPE_TO_PRECISION.at(trinoRawType);
+      binding.precision = TRINO_RAW_TYPE_TO_PRECISION.at(trinoRawType);
     }
     // Not all types have a numerical precision radix, but if they do, set it.
     if (TRINO_RAW_TYPE_TO_NUM_PREC_RADIX.contains(trinoRawType)) {
-      field.numPrecRadix = TRINO_RAW_TYPE_TO_NUM_PREC_RADIX.at(trinoRawType);
+      metadata.numPrecRadix = TRINO_RAW_TYPE_TO_NUM_PREC_RADIX.at(trinoRawType);
     }
     try {
       // This is always true for integral types! Trino doesn't support unsigned
       // integral types. It internally converts unsigned types to the next
       // larger signed integral type. uint64s are turned to decimals, which
       // finishes the job.
-      field.isUnsigned = TRINO_RAW_TYPE_TO_UNSIGNED.at(trinoRawType);
+      metadata.isUnsigned = TRINO_RAW_TYPE_TO_UNSIGNED.at(trinoRawType);
     } catch (const std::exception& ex) {
       WriteLog(LL_ERROR,
                "ERROR: Key " + trinoRawType +
                    " not found in unsigned lookup: " + ex.what());
     }
     try {
-      field.odbcDataType = TRINO_RAW_TYPE_TO_ODBC_TYPE_CODE.at(trinoRawType);
+      binding.odbcDataType = TRINO_RAW_TYPE_TO_ODBC_TYPE_CODE.at(trinoRawType);
     } catch (const std::exception& ex) {
       WriteLog(LL_ERROR,
                "ERROR: Key " + trinoRawType +
                    " not found in type code lookup: " + ex.what());
     }
     try {
-      field.octetLength = TRINO_RAW_TYPE_TO_ODBC_SIZE_BYTES.at(trinoRawType);
+      metadata.octetLength = TRINO_RAW_TYPE_TO_ODBC_SIZE_BYTES.at(trinoRawType);
     } catch (const std::exception& ex) {
       WriteLog(LL_ERROR,
                "ERROR: Key " + trinoRawType +
                    " not found in type code lookup: " + ex.what());
     }
-    this->getRowDescriptor()->setField(i, field);
+    // Columns bound before the query ran are read on every fetch, so
+    // tell the query to decode them as soon as rows arrive.
+    if (binding.bufferPtr) {
+      trinoQuery->markColumnInUse(i - 1);
+    }
     i++;
   }
 }
 
 Statement::Statement(ConnectionConfig* connectionConfig) {
-  this->trinoQuery   = new TrinoQuery(connectionConfig);
-  this->impParamDesc = new Descriptor();
-  this->impRowDesc   = new Descriptor();
+  this->connectionConfig = connectionConfig;
+  this->trinoQuery       = new TrinoQuery(connectionConfig);
+  this->impParamDesc     = new Descriptor();
+  this->impRowDesc       = new Descriptor();
   // Application descriptors are managed by the application,
   // and thus the driver is not responsible for allocating
   // them or managing their memory.
@@ -94,15 +100,39 @@ Statement::~Statement() {
 }
 
 /*
-Reset gets this statement ready to be used again.
+Reset gets this statement ready to be used again. A prepared
+statement stays prepared and its parameters stay bound, as ODBC
+expects after closing a cursor. SQLFreeStmt with SQL_RESET_PARAMS
+is what unbinds parameters. Only the cursor goes away, so a prepared
+statement can still be described before it runs again.
 */
 void Statement::reset() {
+  this->resetResults();
+  this->impRowDesc->reset();
+  this->releaseScratch();
+  if (this->prepared) {
+    this->trinoQuery->setColumns(this->preparedColumns);
+  }
+}
+
+/*
+Discard the results of the last execution, but keep the descriptors
+so the statement can run again with the same bindings.
+*/
+void Statement::resetResults() {
   this->executed              = false;
   this->fetchExecuteConfirmed = false;
   this->fetchedPosition       = -1;
+  this->getDataColumn         = 0;
+  this->getDataOffset         = 0;
   this->trinoQuery->reset();
-  this->impParamDesc->reset();
-  this->impRowDesc->reset();
+}
+
+void Statement::clearPrepared() {
+  this->prepared = false;
+  this->preparedStatementText.clear();
+  this->preparedColumns.clear();
+  this->preparedParameterMarkers.clear();
 }
 
 /*
@@ -115,6 +145,58 @@ void Statement::terminate() {
   this->trinoQuery->terminate();
 }
 
+/*
+Close the cursor so the statement can run again. Trino is told to stop
+an unfinished query, but in the background, so closing is quick even
+when the application walks away from most of a large result.
+*/
+void Statement::closeCursor() {
+  this->trinoQuery->close();
+  this->reset();
+}
+
+/*
+Return the statement to how a new one starts out, so the pool can
+hand it out again. The cursor must already be closed. The buffers it
+grew, like its descriptors' fields, are kept for its next query.
+*/
+void Statement::recycle() {
+  this->clearPrepared();
+  // Closing kept the prepared statement's columns.
+  this->resetResults();
+  this->fetchPollMode = UntilNewData;
+  this->cursorType    = SQL_CURSOR_FORWARD_ONLY;
+  this->maxRows       = 0;
+  this->queryTimeout  = 0;
+  this->errorInfo     = ErrorInfo();
+  this->appRowDesc    = this->impRowDesc;
+  this->appParamDesc  = this->impParamDesc;
+  this->impRowDesc->recycle();
+  this->impParamDesc->recycle();
+  this->trinoQuery->setRetainRows(false);
+  this->releaseScratch();
+}
+
+std::pmr::memory_resource* Statement::getScratch() {
+  return &this->scratch;
+}
+
+void Statement::releaseScratch() {
+  this->scratch.release();
+}
+
+/*
+SQLCancel usually comes from another thread while this statement is
+blocked fetching, in which case the query is told to stop and that
+thread returns HY008. Only the thread that owns the statement tears
+the query down, since another call may be reading its rows right now.
+Canceling never closes the cursor, which ODBC 3 leaves to
+SQLCloseCursor.
+*/
+void Statement::cancel() {
+  this->trinoQuery->requestCancel();
+}
+
 /*
 If the application provides their own descriptor,
 we will ignore the default one we are providing
@@ -150,12 +232,25 @@ void Statement::setFetchedPosition(SQLLEN pos) {
     *(this->impRowDesc->Field_RowsProcessedPtr) = pos;
   }
   this->fetchedPosition = pos;
+  // A new row means any piecewise SQLGetData starts over.
+  this->getDataColumn = 0;
+  this->getDataOffset = 0;
 }
 
 void Statement::setError(ErrorInfo errorInfo) {
   this->errorInfo = errorInfo;
 }
 
+void Statement::setQueryError() {
+  std::string sqlState = "HY000";
+  if (this->trinoQuery->wasCanceled()) {
+    sqlState = "HY008";
+  } else if (this->trinoQuery->hasTimedOut()) {
+    sqlState = "HYT00";
+  }
+  this->setError(ErrorInfo(this->trinoQuery->getErrorMessage(), sqlState));
+}
+
 ErrorInfo Statement::getError() {
   return this->errorInfo;
 }
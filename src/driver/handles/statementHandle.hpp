@@ -3,7 +3,12 @@
 #include <sql.h>
 #include <sqlext.h>
 
+#include <array>
+#include <cstddef>
 #include <functional>
+#include <memory_resource>
+#include <string>
+#include <vector>
 
 #include "descriptorHandle.hpp"
 #include "handleErrorInfo.hpp"
@@ -11,6 +16,19 @@
 #include "../../trinoAPIWrapper/connectionConfig.hpp"
 #include "../../trinoAPIWrapper/trinoQuery.hpp"
 
+/*
+The name prepared statements are registered under. Each request only
+carries the prepared statement of the statement handle that sent it,
+so one name can be shared by every handle.
+*/
+constexpr const char* PREPARED_STATEMENT_NAME = "odbc_prepared";
+
+// How much scratch memory a statement holds inline before it has to
+// ask the heap for more.
+constexpr size_t STATEMENT_SCRATCH_BYTES = 4096;
+
+class StatementPool;
+
 class Statement {
   private:
     void columnsChangedCallback(TrinoQuery* trinoQuery);
@@ -20,6 +38,11 @@ class Statement {
     // indicates that no rows are ready to process.
     SQLLEN fetchedPosition = -1;
     ErrorInfo errorInfo;
+    // Temporaries a call needs only until it returns are carved out of
+    // this, and it's all given back at once.
+    std::array<std::byte, STATEMENT_SCRATCH_BYTES> scratchBuffer;
+    std::pmr::monotonic_buffer_resource scratch{scratchBuffer.data(),
+                                                scratchBuffer.size()};
 
   public:
     Statement(ConnectionConfig* connectionConfig);
@@ -30,8 +53,31 @@ class Statement {
     bool fetchExecuteConfirmed = false;
     // The underlying trino query utility class.
     TrinoQuery* trinoQuery;
+    // The connection the statement belongs to.
+    ConnectionConfig* connectionConfig;
+    // The pool the statement goes back to when it's freed.
+    StatementPool* pool = nullptr;
     // The method used in SQLFetch for polling trino.
     TrinoQueryPollMode fetchPollMode = UntilNewData;
+    // SQL_CURSOR_FORWARD_ONLY, or SQL_CURSOR_STATIC if the application
+    // wants to scroll. A static cursor keeps every row of its result.
+    SQLULEN cursorType = SQL_CURSOR_FORWARD_ONLY;
+    // SQL_ATTR_MAX_ROWS. Zero means every row is returned.
+    SQLULEN maxRows = 0;
+    // SQL_ATTR_QUERY_TIMEOUT, in seconds. Zero means no limit.
+    SQLULEN queryTimeout = 0;
+    // SQLGetData can return a long binary value over several calls.
+    // This tracks which column of the current row is being read that
+    // way, and how many bytes of it have been returned. An offset of
+    // -1 means the whole value has been returned.
+    SQLUSMALLINT getDataColumn = 0;
+    SQLLEN getDataOffset       = 0;
+    // Set by SQLPrepare. The result columns are described once when
+    // the statement is prepared and reused by every SQLExecute.
+    bool prepared = false;
+    std::string preparedStatementText;
+    std::vector<json> preparedColumns;
+    std::vector<size_t> preparedParameterMarkers;
 
     // The ODBC protocol assumes these descriptors are
     // instantiated on all statements.
@@ -41,12 +87,26 @@ class Statement {
     Descriptor* impParamDesc;
 
     void reset();
+    void resetResults();
+    void clearPrepared();
     void terminate();
+    void cancel();
+    void closeCursor();
+    void recycle();
+    /*
+    Memory for temporaries that don't outlive the call using them.
+    It's released when the cursor closes and when the statement runs
+    again, so nothing allocated from it may be kept past either.
+    */
+    std::pmr::memory_resource* getScratch();
+    void releaseScratch();
     Descriptor* getRowDescriptor();
     Descriptor* getParamDescriptor();
     SQLLEN getFetchedPosition();
     void setFetchedPosition(SQLLEN pos);
 
     void setError(ErrorInfo errorInfo);
+    // Report why the query failed, with the SQLSTATE that fits.
+    void setQueryError();
     ErrorInfo getError();
 };
@@ -0,0 +1,48 @@
+#include "statementPool.hpp"
+
+#include "statementHandle.hpp"
+
+StatementPool::~StatementPool() {
+  this->clear();
+}
+
+Statement* StatementPool::acquire(ConnectionConfig* connectionConfig) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->connectionConfig != connectionConfig) {
+    // Idle statements from before a reconnect can't be used.
+    this->deleteIdle();
+    this->connectionConfig = connectionConfig;
+  }
+  if (not this->idle.empty()) {
+    Statement* statement = this->idle.back();
+    this->idle.pop_back();
+    return statement;
+  }
+  Statement* statement = new Statement(connectionConfig);
+  statement->pool      = this;
+  return statement;
+}
+
+void StatementPool::release(Statement* statement) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (statement->connectionConfig != this->connectionConfig or
+      this->idle.size() >= STATEMENT_POOL_CAPACITY) {
+    delete statement;
+    return;
+  }
+  statement->recycle();
+  this->idle.push_back(statement);
+}
+
+void StatementPool::clear() {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->deleteIdle();
+  this->connectionConfig = nullptr;
+}
+
+void StatementPool::deleteIdle() {
+  for (Statement* statement : this->idle) {
+    delete statement;
+  }
+  this->idle.clear();
+}
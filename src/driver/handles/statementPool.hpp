@@ -0,0 +1,43 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "../../trinoAPIWrapper/connectionConfig.hpp"
+
+class Statement;
+
+// How many freed statements a connection keeps for reuse.
+constexpr size_t STATEMENT_POOL_CAPACITY = 16;
+
+/*
+Keeps a connection's freed statements so the next SQLAllocHandle can
+hand one back out instead of building a new one. Applications that
+allocate a statement per query would otherwise build and tear down a
+statement, its query and its descriptors thousands of times a minute.
+A recycled statement also keeps the buffers it grew, so its next
+query fills them again without going back to the heap.
+
+Statements are only reused on the connection they were built for, so
+the pool is emptied when the connection disconnects.
+*/
+class StatementPool {
+  private:
+    std::mutex mutex;
+    std::vector<Statement*> idle;
+    // The connection the idle statements belong to.
+    ConnectionConfig* connectionConfig = nullptr;
+    void deleteIdle();
+
+  public:
+    StatementPool() = default;
+    ~StatementPool();
+    StatementPool(const StatementPool&)            = delete;
+    StatementPool& operator=(const StatementPool&) = delete;
+    // A statement as good as new, built if none are idle.
+    Statement* acquire(ConnectionConfig* connectionConfig);
+    // Take back a statement whose cursor is closed. It's deleted if the
+    // pool is full or it belongs to an earlier connection.
+    void release(Statement* statement);
+    void clear();
+};
@@ -10,6 +10,7 @@ std::unordered_map<std::string, SQLSMALLINT> TRINO_RAW_TYPE_TO_ODBC_TYPE_CODE =
         std::make_pair("real", SQL_REAL),
         std::make_pair("boolean", SQL_BIT),
         std::make_pair("varchar", SQL_VARCHAR),
+        std::make_pair("varbinary", SQL_VARBINARY),
         std::make_pair("uuid", SQL_GUID),
         std::make_pair("decimal", SQL_DECIMAL),
         std::make_pair("date", SQL_TYPE_DATE),
@@ -27,6 +28,7 @@ std::unordered_map<std::string, SQLLEN> TRINO_RAW_TYPE_TO_ODBC_SIZE_BYTES = {
     std::make_pair("real", 4),
     std::make_pair("boolean", 1),
     std::make_pair("varchar", SQL_NO_TOTAL),
+    std::make_pair("varbinary", SQL_NO_TOTAL),
     std::make_pair("uuid", sizeof(SQLGUID)),
     std::make_pair("decimal", SQL_NO_TOTAL),
     std::make_pair("date", sizeof(SQL_DATE_STRUCT)),
@@ -51,6 +53,7 @@ std::unordered_map<std::string, bool> TRINO_RAW_TYPE_TO_UNSIGNED = {
     std::make_pair("real", false),
     std::make_pair("boolean", true),
     std::make_pair("varchar", true),
+    std::make_pair("varbinary", true),
     std::make_pair("uuid", true),
     std::make_pair("decimal", false),
     std::make_pair("date", true),
@@ -8,6 +8,7 @@
 SQLRETURN SQL_API SQLMoreResults(SQLHSTMT StatementHandle) {
   WriteLog(LL_TRACE, "Entering SQLMoreResults");
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
 
   /*
   I don't think Trino supports returning multiple result sets
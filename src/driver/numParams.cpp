@@ -3,9 +3,28 @@
 #include <sqlext.h>
 
 #include "../util/writeLog.hpp"
+#include "handles/statementHandle.hpp"
 
 SQLRETURN SQL_API SQLNumParams(SQLHSTMT hstmt, _Out_opt_ SQLSMALLINT* pcpar) {
   WriteLog(LL_TRACE, "Entering SQLNumParams");
-  WriteLog(LL_ERROR, " ERROR: SQLNumParams is unimplemented");
-  return SQL_ERROR;
+  if (!hstmt) {
+    WriteLog(LL_ERROR, "  ERROR: Invalid statement handle");
+    return SQL_INVALID_HANDLE;
+  }
+
+  Statement* statement = reinterpret_cast<Statement*>(hstmt);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+  if (not statement->prepared) {
+    WriteLog(LL_ERROR, "  ERROR: SQLNumParams called before SQLPrepare");
+    ErrorInfo errorInfo("Function sequence error", "HY010");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  }
+
+  // The markers were counted when the statement was prepared.
+  if (pcpar) {
+    *pcpar =
+        static_cast<SQLSMALLINT>(statement->preparedParameterMarkers.size());
+  }
+  return SQL_SUCCESS;
 }
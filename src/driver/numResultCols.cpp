@@ -9,6 +9,13 @@ SQLRETURN SQL_API SQLNumResultCols(SQLHSTMT StatementHandle,
   WriteLog(LL_TRACE, "Entering SQLNumResultCols");
 
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+  // A prepared statement that hasn't run yet already knows its columns,
+  // which might be none at all if it doesn't return rows.
+  if (statement->prepared and not statement->executed) {
+    *ColumnCount = static_cast<SQLSMALLINT>(statement->preparedColumns.size());
+    return SQL_SUCCESS;
+  }
   WriteLog(LL_TRACE, "  Getting Column Count");
   SQLSMALLINT queryColumnCount = statement->trinoQuery->getColumnCount();
   WriteLog(LL_TRACE, "  Got Column Count");
@@ -1,13 +1,133 @@
 #include "../util/windowsLean.hpp"
 #include <sql.h>
 #include <sqlext.h>
+#include <sqlucode.h>
 
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../trinoAPIWrapper/columnDescription.hpp"
+#include "../trinoAPIWrapper/trinoQuery.hpp"
+#include "../util/parameterMarkers.hpp"
+#include "../util/stringFromChar.hpp"
 #include "../util/writeLog.hpp"
+#include "handles/statementHandle.hpp"
+
+static size_t findColumnIndex(TrinoQuery& trinoQuery, const std::string& name) {
+  const std::vector<ColumnDescription>& columnDescriptions =
+      trinoQuery.getColumnDescriptions();
+  for (size_t i = 0; i < columnDescriptions.size(); i++) {
+    if (columnDescriptions[i].getName() == name) {
+      return i;
+    }
+  }
+  throw std::runtime_error("DESCRIBE OUTPUT did not return column " + name);
+}
+
+/*
+Ask Trino for the result columns of the prepared statement. Each row
+DESCRIBE OUTPUT returns describes one column, and is turned into the
+column info a query response would carry.
+*/
+static std::vector<json> describeOutput(Statement* statement) {
+  TrinoQuery describeQuery(statement->connectionConfig);
+  describeQuery.setPreparedStatement(PREPARED_STATEMENT_NAME,
+                                     statement->preparedStatementText);
+  describeQuery.setQuery(std::string("DESCRIBE OUTPUT ") +
+                         PREPARED_STATEMENT_NAME);
+  describeQuery.post();
+  describeQuery.poll(ToCompletion);
+  if (describeQuery.hasError()) {
+    throw std::invalid_argument(describeQuery.getErrorMessage());
+  }
+
+  std::vector<json> columns;
+  if (describeQuery.getCurrentRowCount() == 0) {
+    // Statements that don't return rows have nothing to describe.
+    return columns;
+  }
+  size_t nameIndex = findColumnIndex(describeQuery, "Column Name");
+  size_t typeIndex = findColumnIndex(describeQuery, "Type");
+  for (int64_t row = 0; row < describeQuery.getCurrentRowCount(); row++) {
+    columns.push_back(columnInfoFromTypeText(
+        describeQuery.getCellAtIndex(row, nameIndex).get<std::string>(),
+        describeQuery.getCellAtIndex(row, typeIndex).get<std::string>()));
+  }
+  return columns;
+}
+
+static SQLRETURN prepareStatementText(Statement* statement,
+                                      const std::string& statementText) {
+  try {
+    WriteLog(LL_DEBUG, "  Preparing: " + statementText);
+    statement->trinoQuery->terminate();
+    statement->resetResults();
+    statement->clearPrepared();
+    statement->preparedStatementText    = statementText;
+    statement->preparedParameterMarkers = findParameterMarkers(statementText);
+    statement->preparedColumns          = describeOutput(statement);
+    statement->prepared                 = true;
+    // The columns are known now, so describing them doesn't have to
+    // wait for the statement to run.
+    statement->trinoQuery->setColumns(statement->preparedColumns);
+    return SQL_SUCCESS;
+  } catch (const std::invalid_argument& ex) {
+    WriteLog(LL_ERROR,
+             "  ERROR: Trino rejected the prepared statement: " +
+                 std::string(ex.what()));
+    statement->clearPrepared();
+    ErrorInfo errorInfo(std::string(ex.what()), "42000");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  } catch (const std::exception& ex) {
+    WriteLog(LL_ERROR,
+             "  ERROR: Exception thrown during SQLPrepare: " +
+                 std::string(ex.what()));
+    statement->clearPrepared();
+    ErrorInfo errorInfo("Exception thrown during SQLPrepare: " +
+                            std::string(ex.what()),
+                        "HY000");
+    statement->setError(errorInfo);
+    return SQL_ERROR;
+  }
+}
 
 SQLRETURN SQL_API SQLPrepare(SQLHSTMT StatementHandle,
                              _In_reads_(TextLength) SQLCHAR* StatementText,
                              SQLINTEGER TextLength) {
   WriteLog(LL_TRACE, "Entering SQLPrepare");
-  WriteLog(LL_ERROR, "  ERROR: SQLPrepare is unimplemented");
-  return SQL_ERROR;
+  if (!StatementHandle) {
+    WriteLog(LL_ERROR, "  ERROR: Invalid statement handle");
+    return SQL_INVALID_HANDLE;
+  }
+  if (not StatementText) {
+    WriteLog(LL_ERROR, " ERROR: No StatementText defined for query");
+    return SQL_ERROR;
+  }
+
+  Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+  return prepareStatementText(statement,
+                              stringFromChar(StatementText, TextLength));
+}
+
+SQLRETURN SQL_API SQLPrepareW(SQLHSTMT StatementHandle,
+                              _In_reads_(TextLength) SQLWCHAR* StatementText,
+                              SQLINTEGER TextLength) {
+  WriteLog(LL_TRACE, "Entering SQLPrepareW");
+  if (!StatementHandle) {
+    WriteLog(LL_ERROR, "  ERROR: Invalid statement handle");
+    return SQL_INVALID_HANDLE;
+  }
+  if (not StatementText) {
+    WriteLog(LL_ERROR, " ERROR: No StatementText defined for query");
+    return SQL_ERROR;
+  }
+
+  Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
+  return prepareStatementText(
+      statement,
+      stringFromChar(reinterpret_cast<char16_t*>(StatementText), TextLength));
 }
@@ -9,6 +9,7 @@ SQLRETURN SQL_API SQLRowCount(_In_ SQLHSTMT StatementHandle,
   WriteLog(LL_TRACE, "Entering SQLRowCount");
 
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
   // We can return -1 to indicate that we do not
   // yet know the number of rows in the query. This is
   // useful because this will often be called even before
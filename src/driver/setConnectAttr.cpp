@@ -3,6 +3,7 @@
 #include <sqlext.h>
 
 #include "../util/writeLog.hpp"
+#include "constants/connectionAttrs.hpp"
 #include "handles/connHandle.hpp"
 
 SQLRETURN SQL_API SQLSetConnectOption(SQLHDBC ConnectionHandle,
@@ -38,6 +39,7 @@ SQLRETURN SQL_API SQLSetConnectAttr(SQLHDBC ConnectionHandle,
     WriteLog(LL_ERROR, "  ERROR: ConnectionHandle is invalid.");
     return SQL_ERROR;
   }
+  LogLevelScope logScope(connection->getLogLevel());
 
   switch (Attribute) {
     case SQL_ATTR_AUTOCOMMIT: { // 102
@@ -48,6 +50,19 @@ SQLRETURN SQL_API SQLSetConnectAttr(SQLHDBC ConnectionHandle,
                "  Autocommit mode set to: " + std::to_string(autocommitMode));
       break;
     }
+    case SQL_ATTR_CONNECTION_TIMEOUT: { // 113
+      SQLUINTEGER connectionTimeout =
+          static_cast<SQLUINTEGER>(reinterpret_cast<std::uintptr_t>(Value));
+      connection->ATTR_ConnectionTimeout = connectionTimeout;
+      if (connection->connectionConfig) {
+        connection->connectionConfig->connectionTimeout =
+            std::chrono::seconds(connectionTimeout);
+      }
+      WriteLog(LL_TRACE,
+               "  Connection timeout set to: " +
+                   std::to_string(connectionTimeout));
+      break;
+    }
     case SQL_ATTR_LOGIN_TIMEOUT: { // 103
       SQLUINTEGER loginTimeout =
           static_cast<SQLUINTEGER>(reinterpret_cast<std::uintptr_t>(Value));
@@ -56,6 +71,14 @@ SQLRETURN SQL_API SQLSetConnectAttr(SQLHDBC ConnectionHandle,
                "  Login timeout set to: " + std::to_string(loginTimeout));
       break;
     }
+    case SQL_ATTR_METADATA_CACHE_INVALIDATE: { // 16385
+      // The value doesn't matter. Before connecting there's nothing cached.
+      if (connection->connectionConfig) {
+        connection->connectionConfig->metadataCache.invalidate();
+      }
+      WriteLog(LL_TRACE, "  Metadata cache invalidated");
+      break;
+    }
     default: {
       WriteLog(LL_ERROR, "  ERROR: Unsupported attribute in SetConnectAttr.");
       WriteLog(LL_ERROR, "  Attribute is " + std::to_string(Attribute));
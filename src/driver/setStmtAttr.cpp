@@ -14,9 +14,88 @@ SQLRETURN SQL_API SQLSetStmtAttr(SQLHSTMT StatementHandle,
                                  SQLINTEGER StringLength) {
   WriteLog(LL_TRACE, "Entering SQLSetStmtAttr");
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
 
   WriteLog(LL_TRACE, "  Setting attribute: " + std::to_string(Attribute));
   switch (Attribute) {
+    case SQL_ATTR_CURSOR_SCROLLABLE: { // -1
+      SQLULEN scrollable = reinterpret_cast<SQLULEN>(Value);
+      statement->cursorType = scrollable == SQL_SCROLLABLE
+                                  ? SQL_CURSOR_STATIC
+                                  : SQL_CURSOR_FORWARD_ONLY;
+      statement->trinoQuery->setRetainRows(statement->cursorType ==
+                                           SQL_CURSOR_STATIC);
+      break;
+    }
+    case SQL_ATTR_QUERY_TIMEOUT: { // 0
+      SQLULEN queryTimeout = reinterpret_cast<SQLULEN>(Value);
+      WriteLog(LL_TRACE,
+               "  Attribute value is set to " + std::to_string(queryTimeout));
+      statement->queryTimeout = queryTimeout;
+      break;
+    }
+    case SQL_ATTR_MAX_ROWS: { // 1
+      SQLULEN maxRows = reinterpret_cast<SQLULEN>(Value);
+      WriteLog(LL_TRACE,
+               "  Attribute value is set to " + std::to_string(maxRows));
+      statement->maxRows = maxRows;
+      break;
+    }
+    case SQL_ATTR_CURSOR_TYPE: { // 6
+      SQLULEN cursorType = reinterpret_cast<SQLULEN>(Value);
+      WriteLog(LL_TRACE,
+               "  Attribute value is set to " + std::to_string(cursorType));
+      statement->cursorType = cursorType == SQL_CURSOR_FORWARD_ONLY
+                                  ? SQL_CURSOR_FORWARD_ONLY
+                                  : SQL_CURSOR_STATIC;
+      statement->trinoQuery->setRetainRows(statement->cursorType ==
+                                           SQL_CURSOR_STATIC);
+      // Trino results can't change under an open cursor, so keyset
+      // driven and dynamic cursors get a static cursor instead.
+      if (statement->cursorType != cursorType) {
+        ErrorInfo errorInfo("Option value changed", "01S02");
+        statement->setError(errorInfo);
+        return SQL_SUCCESS_WITH_INFO;
+      }
+      break;
+    }
+    case SQL_ATTR_PARAM_BIND_OFFSET_PTR: { // 17
+      statement->getParamDescriptor()->Field_BindOffsetPtr =
+          static_cast<SQLLEN*>(Value);
+      break;
+    }
+    case SQL_ATTR_PARAM_BIND_TYPE: { // 18
+      // Either SQL_PARAM_BIND_BY_COLUMN, or the size of the structure
+      // that holds one set of parameters when binding by row.
+      SQLULEN bindType = reinterpret_cast<SQLULEN>(Value);
+      WriteLog(LL_TRACE,
+               "  Attribute value is set to " + std::to_string(bindType));
+      statement->getParamDescriptor()->Field_BindType =
+          static_cast<SQLUINTEGER>(bindType);
+      break;
+    }
+    case SQL_ATTR_PARAM_STATUS_PTR: { // 20
+      statement->impParamDesc->Field_ArrayStatusPtr =
+          static_cast<SQLUSMALLINT*>(Value);
+      break;
+    }
+    case SQL_ATTR_PARAMS_PROCESSED_PTR: { // 21
+      statement->impParamDesc->Field_RowsProcessedPtr =
+          static_cast<SQLULEN*>(Value);
+      break;
+    }
+    case SQL_ATTR_PARAMSET_SIZE: { // 22
+      SQLULEN paramsetSize = reinterpret_cast<SQLULEN>(Value);
+      WriteLog(LL_TRACE,
+               "  Attribute value is set to " + std::to_string(paramsetSize));
+      if (paramsetSize == 0) {
+        ErrorInfo errorInfo("Invalid attribute value", "HY024");
+        statement->setError(errorInfo);
+        return SQL_ERROR;
+      }
+      statement->getParamDescriptor()->Field_ArraySize = paramsetSize;
+      break;
+    }
     case SQL_ATTR_ROWS_FETCHED_PTR: { // 26
       SQLULEN* rowsProcessedPtr = static_cast<SQLULEN*>(Value);
       WriteLog(LL_TRACE, std::format("  Attribute value is set to {}", Value));
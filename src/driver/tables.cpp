@@ -7,6 +7,7 @@
 #include "../util/stringFromChar.hpp"
 #include "../util/stringSplitAndTrim.hpp"
 #include "../util/writeLog.hpp"
+#include "execution/catalogQuery.hpp"
 #include "handles/statementHandle.hpp"
 
 std::string ALL_CATALOGS_QUERY = R"SQL(
@@ -112,6 +113,7 @@ SQLRETURN SQL_API SQLTables(SQLHSTMT StatementHandle,
   }
 
   Statement* statement = reinterpret_cast<Statement*>(StatementHandle);
+  LogLevelScope logScope(statement->connectionConfig->logLevel);
 
   std::string catalogName = stringFromChar(CatalogNameChars, NameLength1);
   std::string schemaName  = stringFromChar(SchemaNameChars, NameLength2);
@@ -126,19 +128,13 @@ SQLRETURN SQL_API SQLTables(SQLHSTMT StatementHandle,
   // Special cases to enable enumeration of catalogs, schemas, and table types.
   if (catalogName == SQL_ALL_CATALOGS and schemaName.empty() and
       tableName.empty() and tableType.empty()) {
-    statement->trinoQuery->setQuery(ALL_CATALOGS_QUERY);
-    statement->trinoQuery->post();
-    statement->executed = true;
+    return runCatalogQuery(statement, ALL_CATALOGS_QUERY);
   } else if (schemaName == SQL_ALL_SCHEMAS and catalogName.empty() and
              tableName.empty()) {
-    statement->trinoQuery->setQuery(ALL_SCHEMAS_QUERY);
-    statement->trinoQuery->post();
-    statement->executed = true;
+    return runCatalogQuery(statement, ALL_SCHEMAS_QUERY);
   } else if (tableType == SQL_ALL_TABLE_TYPES and catalogName.empty() and
              schemaName.empty() and tableName.empty()) {
-    statement->trinoQuery->setQuery(ALL_TABLE_TYPES_QUERY);
-    statement->trinoQuery->post();
-    statement->executed = true;
+    return runCatalogQuery(statement, ALL_TABLE_TYPES_QUERY);
   } else {
     /*
     The docs make it sound like schema, tablename, and tabletype are all going
@@ -161,10 +157,6 @@ SQLRETURN SQL_API SQLTables(SQLHSTMT StatementHandle,
     std::string query =
         constructTableQuery(catalogName, schemaName, tableName, tableType);
     WriteLog(LL_TRACE, "Final query is: " + query);
-    statement->trinoQuery->setQuery(query);
-    statement->trinoQuery->post();
-    statement->executed = true;
+    return runCatalogQuery(statement, query);
   }
-
-  return SQL_SUCCESS;
 }
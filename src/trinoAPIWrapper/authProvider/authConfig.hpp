@@ -4,6 +4,8 @@
 #include <map>
 #include <string>
 
+#include "../responseBuffers.hpp"
+
 class AuthConfig {
   public:
     // Any headers that must be included on all requests go here.
@@ -24,10 +26,10 @@ class AuthConfig {
 
     // The '=0' on the end makes these "pure virtual" methods,
     // transforming this into an abstract bass class.
-    virtual bool const isExpired()                                       = 0;
+    virtual bool const isExpired()                     = 0;
     virtual void refresh(CURL* curl,
                          std::string* responseData,
-                         std::map<std::string, std::string>* headerData) = 0;
+                         ResponseHeaders* headerData) = 0;
 
     // Virtual destructors are considered "best practice" for virtual classes.
     virtual ~AuthConfig() = default;
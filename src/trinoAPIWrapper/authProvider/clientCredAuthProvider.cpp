@@ -19,16 +19,16 @@ std::string urlEncode(CURL* curl, std::string s) {
 }
 
 struct ClientCredAuthParams {
-    std::string hostname                                   = "";
-    unsigned short port                                    = 0;
-    CURL* curl                                             = nullptr;
-    std::string* oidcDiscoveryUrl                          = nullptr;
-    std::string* clientId                                  = nullptr;
-    std::string* clientSecret                              = nullptr;
-    std::string* scope                                     = nullptr;
-    std::string* responseData                              = nullptr;
-    std::map<std::string, std::string>* responseHeaderData = nullptr;
-    std::map<std::string, std::string>* requestHeaders     = nullptr;
+    std::string hostname                               = "";
+    unsigned short port                                = 0;
+    CURL* curl                                         = nullptr;
+    std::string* oidcDiscoveryUrl                      = nullptr;
+    std::string* clientId                              = nullptr;
+    std::string* clientSecret                          = nullptr;
+    std::string* scope                                 = nullptr;
+    std::string* responseData                          = nullptr;
+    ResponseHeaders* responseHeaderData                = nullptr;
+    std::map<std::string, std::string>* requestHeaders = nullptr;
 };
 
 std::string refreshClientCredAuth(ClientCredAuthParams& params) {
@@ -110,10 +110,9 @@ class ClientCredAuthConfig : public TokenCacheAuthProviderBase {
     }
 
 
-    std::string
-    obtainAccessToken(CURL* curl,
-                      std::string* responseData,
-                      std::map<std::string, std::string>* responseHeaderData) {
+    std::string obtainAccessToken(CURL* curl,
+                                  std::string* responseData,
+                                  ResponseHeaders* responseHeaderData) {
       ClientCredAuthParams params;
       params.curl               = curl;
       params.hostname           = this->hostname;
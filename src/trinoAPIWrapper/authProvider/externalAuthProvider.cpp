@@ -18,18 +18,18 @@ Depending on network latency, it might be
 necessary to hit the auth token endpoint more than
 once.
 */
-int MAX_AUTH_TOKEN_RETRIES                 = 2;
-std::string EXTERNAL_AUTH_TRIGGER_ENDPOINT = "v1/statement";
-std::string EXTERNAL_AUTH_TRIGGER_QUERY    = "SELECT 'authenticating...'";
+const int MAX_AUTH_TOKEN_RETRIES                 = 2;
+const std::string EXTERNAL_AUTH_TRIGGER_ENDPOINT = "v1/statement";
+const std::string EXTERNAL_AUTH_TRIGGER_QUERY    = "SELECT 'authenticating...'";
 
 
 struct ExternalAuthParams {
-    std::string hostname                                   = "";
-    unsigned short port                                    = 0;
-    CURL* curl                                             = nullptr;
-    std::string* responseData                              = nullptr;
-    std::map<std::string, std::string>* responseHeaderData = nullptr;
-    std::map<std::string, std::string>* requestHeaders     = nullptr;
+    std::string hostname                               = "";
+    unsigned short port                                = 0;
+    CURL* curl                                         = nullptr;
+    std::string* responseData                          = nullptr;
+    ResponseHeaders* responseHeaderData                = nullptr;
+    std::map<std::string, std::string>* requestHeaders = nullptr;
 };
 
 
@@ -73,7 +73,7 @@ std::string refreshExternalAuth(ExternalAuthParams& params) {
   WriteLog(LL_TRACE,
            "  Auth trigger CURLcode returned: " + std::to_string(res));
 
-  if (not params.responseHeaderData->count("www-authenticate")) {
+  if (not params.responseHeaderData->contains("www-authenticate")) {
     WriteLog(LL_ERROR,
              "  ERROR: Unauthenticated request did not return www-authenticate "
              "header");
@@ -89,7 +89,7 @@ std::string refreshExternalAuth(ExternalAuthParams& params) {
   // www-authenticate: Bearer x_redirect_server="https://...",
   // x_token_server="https://..." This is basically a "Bearer " prefix on a
   // comma delimited set of key-value pairs
-  std::string headerKVPs = params.responseHeaderData->at("www-authenticate");
+  std::string headerKVPs(params.responseHeaderData->get("www-authenticate"));
 
   // We need to strip the word "Bearer" off of the front of this text before
   // we try to parse it. Also take the space character following the word.
@@ -161,10 +161,9 @@ class ExternalAuthConfig : public TokenCacheAuthProviderBase {
                        std::string connectionName)
         : TokenCacheAuthProviderBase(hostname, port, connectionName) {}
 
-    std::string
-    obtainAccessToken(CURL* curl,
-                      std::string* responseData,
-                      std::map<std::string, std::string>* responseHeaderData) {
+    std::string obtainAccessToken(CURL* curl,
+                                  std::string* responseData,
+                                  ResponseHeaders* responseHeaderData) {
       ExternalAuthParams params;
       params.curl               = curl;
       params.hostname           = this->hostname;
@@ -20,10 +20,9 @@ class NoAuthAuthConfig : public AuthConfig {
     bool const isExpired() override {
       return false;
     }
-    void
-    refresh(CURL* curl,
-            std::string* responseData,
-            std::map<std::string, std::string>* responseHeaderData) override {
+    void refresh(CURL* curl,
+                 std::string* responseData,
+                 ResponseHeaders* responseHeaderData) override {
       // There's nothing to refresh.
     }
     ~NoAuthAuthConfig() override = default;
@@ -22,10 +22,9 @@ void TokenCacheAuthProviderBase::applyToken() {
   this->headers.insert({authKey, authValue});
 }
 
-void TokenCacheAuthProviderBase::refresh(
-    CURL* curl,
-    std::string* responseData,
-    std::map<std::string, std::string>* responseHeaderData) {
+void TokenCacheAuthProviderBase::refresh(CURL* curl,
+                                         std::string* responseData,
+                                         ResponseHeaders* responseHeaderData) {
   applyTokenIfNotExpired();
 
   // Actually obtain the access token. This function is pure virtual,
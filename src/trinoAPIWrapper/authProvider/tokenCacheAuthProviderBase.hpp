@@ -17,20 +17,19 @@ class TokenCacheAuthProviderBase : public AuthConfig {
                                std::string connectionName);
     bool const isExpired() override;
     void applyToken();
-    void
-    refresh(CURL* curl,
-            std::string* responseData,
-            std::map<std::string, std::string>* responseHeaderData) override;
+    void refresh(CURL* curl,
+                 std::string* responseData,
+                 ResponseHeaders* responseHeaderData) override;
     virtual ~TokenCacheAuthProviderBase() = default;
 
   protected:
     std::string tokenId;
     std::optional<TokenCacheEntry> tokenCache;
     // This is pure virtual, it requires an implementation in the subclass.
-    virtual std::string obtainAccessToken(
-        CURL* curl,
-        std::string* responseData,
-        std::map<std::string, std::string>* responseHeaderData) = 0;
+    virtual std::string
+    obtainAccessToken(CURL* curl,
+                      std::string* responseData,
+                      ResponseHeaders* responseHeaderData) = 0;
     void applyTokenIfNotExpired();
     void cacheToken(std::string accessToken);
     void setAccessTokenHeader(std::string accessToken);
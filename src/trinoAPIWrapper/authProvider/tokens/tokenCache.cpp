@@ -19,8 +19,8 @@
 using json = nlohmann::json;
 
 
-int TOKEN_CACHE_JSON_INDENT     = 2;
-long long EXPIRY_GRACE_PERIOD_S = 60 * 10;
+const int TOKEN_CACHE_JSON_INDENT     = 2;
+const long long EXPIRY_GRACE_PERIOD_S = 60 * 10;
 
 
 TokenCacheEntry::TokenCacheEntry(std::string accessToken,
@@ -1,5 +1,12 @@
 #include "columnDescription.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <limits>
+
+#include "../util/stringTrim.hpp"
+
 ColumnDescription::ColumnDescription(const json& columnInfo) {
   this->name          = columnInfo["name"];
   this->type          = columnInfo["type"];
@@ -22,3 +29,63 @@ const std::string& ColumnDescription::getRawType() const {
 const json& ColumnDescription::getTypeArguments() const {
   return this->typeArguments;
 }
+
+static json typeArgumentFromText(std::string argumentText) {
+  trim(argumentText);
+  bool isNumber = not argumentText.empty() and
+                  std::all_of(argumentText.begin(),
+                              argumentText.end(),
+                              [](unsigned char c) { return std::isdigit(c); });
+  if (isNumber) {
+    return {{"kind", "LONG"}, {"value", std::stoll(argumentText)}};
+  }
+  return {{"kind", "TYPE"}, {"value", argumentText}};
+}
+
+json columnInfoFromTypeText(const std::string& name,
+                            const std::string& typeText) {
+  /*
+  The arguments are whatever is inside the first set of parentheses,
+  split on the commas that aren't nested any deeper. The raw type is
+  the rest of the text, which matches what Trino puts in the type
+  signature: "timestamp(3) with time zone" has the raw type
+  "timestamp with time zone".
+  */
+  std::string rawType = typeText;
+  json arguments      = json::array();
+  size_t open         = typeText.find('(');
+  if (open != std::string::npos) {
+    int depth            = 0;
+    size_t argumentStart = open + 1;
+    size_t close         = typeText.size();
+    for (size_t i = open; i < typeText.size(); i++) {
+      char c = typeText[i];
+      if (c == '(') {
+        depth++;
+      } else if (c == ')' and --depth == 0) {
+        close = i;
+        break;
+      } else if (c == ',' and depth == 1) {
+        arguments.push_back(typeArgumentFromText(
+            typeText.substr(argumentStart, i - argumentStart)));
+        argumentStart = i + 1;
+      }
+    }
+    arguments.push_back(typeArgumentFromText(
+        typeText.substr(argumentStart, close - argumentStart)));
+    rawType = typeText.substr(0, open);
+    if (close < typeText.size()) {
+      rawType += typeText.substr(close + 1);
+    }
+    trim(rawType);
+  }
+  // Trino leaves the length off unbounded varchars in the type text,
+  // but the type signature always has it.
+  if (rawType == "varchar" and arguments.empty()) {
+    arguments.push_back({{"kind", "LONG"},
+                         {"value", std::numeric_limits<int32_t>::max()}});
+  }
+  return {{"name", name},
+          {"type", typeText},
+          {"typeSignature", {{"rawType", rawType}, {"arguments", arguments}}}};
+}
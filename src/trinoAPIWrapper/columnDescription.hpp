@@ -20,3 +20,11 @@ class ColumnDescription {
     const std::string& getRawType() const;
     const json& getTypeArguments() const;
 };
+
+/*
+Build the column info a query response would contain for a column,
+given its type as text, like "decimal(10,2)". DESCRIBE OUTPUT reports
+types this way, and this lets its results feed a ColumnDescription.
+*/
+json columnInfoFromTypeText(const std::string& name,
+                            const std::string& typeText);
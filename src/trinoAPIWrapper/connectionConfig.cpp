@@ -1,8 +1,10 @@
 #include "connectionConfig.hpp"
+#include <algorithm>
+#include <format>
+#include <functional>
 #include <nlohmann/json.hpp>
 
 #include "../util/callbackHelper.hpp"
-#include "../util/stringTrim.hpp"
 #include "../util/writeLog.hpp"
 #include "authProvider/clientCredAuthProvider.hpp"
 #include "authProvider/externalAuthProvider.hpp"
@@ -17,30 +19,43 @@ curlWriteCallback(void* contents, size_t size, size_t nmemb, std::string* s) {
   return totalSize;
 }
 
+// The most room made for a body before it arrives. Content-Length is
+// whatever the server says, so it isn't trusted with an allocation of
+// any size. A larger body still grows the buffer as it streams in.
+static constexpr size_t RESPONSE_RESERVE_MAX_BYTES = 64 * 1024 * 1024;
+
 static size_t
 curlHeaderCallback(char* buffer, size_t size, size_t nitems, void* userdata) {
-  std::map<std::string, std::string>* responseHeaderData =
-      (std::map<std::string, std::string>*)userdata;
-  std::string headerData = std::string(buffer, nitems);
-  if (headerData.starts_with("HTTP/")) {
-    // The HTTP/<version> header is not a key value pair, so
-    // it gets some special logic.
-    responseHeaderData->insert({"http", headerData});
-  } else {
-    auto firstColon = headerData.find(':');
-    if (firstColon != std::string::npos) {
-      std::string key   = headerData.substr(0, firstColon);
-      std::string value = headerData.substr(firstColon + 1);
-      // The values usually end in \r\n at a minimum, so we need
-      // to trim that off.
-      trim(value);
-      responseHeaderData->insert({key, value});
-    }
+  ConnectionConfig* connectionConfig = static_cast<ConnectionConfig*>(userdata);
+  ResponseHeaders& headers           = connectionConfig->responseHeaderData;
+  headers.addLine(std::string_view(buffer, size * nitems));
+  // Headers come before the body, so there's time to make room for
+  // all of it rather than growing the buffer as it streams in. A
+  // compressed body inflates past this, but it's most of the way.
+  std::string& responseData = connectionConfig->responseData;
+  size_t reserve =
+      std::min(headers.getContentLength(), RESPONSE_RESERVE_MAX_BYTES);
+  if (reserve > responseData.capacity()) {
+    responseData.reserve(reserve);
   }
   // Return the number of bytes consumed to signal success.
   return nitems * size;
 }
 
+/*
+Curl calls this at least once a second during a transfer. Returning
+nonzero aborts it, which is how a canceled query stops waiting on a
+slow response.
+*/
+static int curlProgressCallback(void* clientp,
+                                curl_off_t downloadTotal,
+                                curl_off_t downloaded,
+                                curl_off_t uploadTotal,
+                                curl_off_t uploaded) {
+  std::atomic<bool>* canceled = static_cast<std::atomic<bool>*>(clientp);
+  return canceled and canceled->load() ? 1 : 0;
+}
+
 ConnectionConfig::ConnectionConfig(std::string hostname,
                                    unsigned short port,
                                    ApiAuthMethod authMethod,
@@ -52,6 +67,7 @@ ConnectionConfig::ConnectionConfig(std::string hostname,
   this->hostname       = hostname;
   this->port           = port;
   this->connectionName = connectionName;
+  this->clientId       = clientId;
   this->authMethod     = authMethod;
   this->curl           = nullptr;
 
@@ -86,6 +102,7 @@ ConnectionConfig::ConnectionConfig(std::string hostname,
 
 ConnectionConfig::~ConnectionConfig() {
   curl_easy_cleanup(this->curl);
+  curl_slist_free_all(this->requestHeaders);
 }
 
 std::string const ConnectionConfig::getHostname() {
@@ -100,6 +117,31 @@ ApiAuthMethod const ConnectionConfig::getAuthMethod() {
   return this->authMethod;
 }
 
+std::string ConnectionConfig::getIdentity() {
+  std::string identity =
+      this->connectionName + "__" + this->hostname + "__" +
+      std::to_string(this->port) + "__" + std::to_string(this->authMethod) +
+      "__" + this->clientId;
+  // The user, and the catalog, schema and session properties queries
+  // run with, all go to the server as X-Trino headers. A bearer token
+  // stands in for the user it was issued to, and is hashed so the
+  // identity never holds the token itself.
+  bool knowsUser = false;
+  std::lock_guard<std::mutex> lock(this->authMutex);
+  for (const auto& [name, value] : this->authConfigPtr->headers) {
+    if (name.starts_with("X-Trino-")) {
+      identity += "__" + name + "=" + value;
+      knowsUser = knowsUser or name == "X-Trino-User";
+    } else if (name == "Authorization") {
+      identity += std::format("__{}={:016x}",
+                              name,
+                              std::hash<std::string>{}(value));
+      knowsUser = true;
+    }
+  }
+  return knowsUser ? identity : "";
+}
+
 std::string const ConnectionConfig::getStatementUrl() {
   return (this->hostname) + ":" + std::to_string(port) + "/v1/statement";
 }
@@ -117,12 +159,17 @@ CURL* ConnectionConfig::getCurl() {
     curl_easy_setopt(this->curl, CURLOPT_WRITEDATA, &(this->responseData));
     // We want to parse response headers.
     curl_easy_setopt(this->curl, CURLOPT_HEADERFUNCTION, curlHeaderCallback);
-    curl_easy_setopt(
-        this->curl, CURLOPT_HEADERDATA, &(this->responseHeaderData));
-    // Set a timeout on all requests
-    curl_easy_setopt(this->curl, CURLOPT_TIMEOUT_MS, 10000);
+    curl_easy_setopt(this->curl, CURLOPT_HEADERDATA, this);
+    // A request that receives nothing for a minute has stalled. Trino
+    // answers every poll within a second or so, even without rows.
+    curl_easy_setopt(this->curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+    curl_easy_setopt(this->curl, CURLOPT_LOW_SPEED_TIME, 60L);
     // Enable gzip and/or deflate on responses
     curl_easy_setopt(this->curl, CURLOPT_ACCEPT_ENCODING, "gzip, deflate");
+    // Lets a canceled query abort the request it's waiting on.
+    curl_easy_setopt(
+        this->curl, CURLOPT_XFERINFOFUNCTION, curlProgressCallback);
+    curl_easy_setopt(this->curl, CURLOPT_NOPROGRESS, 0L);
   }
 
 curlSetup:
@@ -140,16 +187,32 @@ curlSetup:
   // handle is configured to run GET requests, no matter
   // how it was used before.
   curl_easy_setopt(this->curl, CURLOPT_HTTPGET, true);
+  // Only the query that set a cancel flag can be canceled with it.
+  curl_easy_setopt(this->curl, CURLOPT_XFERINFODATA, nullptr);
+
+  // Timeouts are set again for every request, since a query shortens
+  // its requests' timeout to whatever is left of its own.
+  curl_easy_setopt(this->curl,
+                   CURLOPT_CONNECTTIMEOUT_MS,
+                   static_cast<long>(this->loginTimeout.count() * 1000));
+  curl_easy_setopt(this->curl,
+                   CURLOPT_TIMEOUT_MS,
+                   static_cast<long>(this->connectionTimeout.count() * 1000));
 
-  // Set up any required headers if needed.
-  if (this->authConfigPtr->headers.size() > 0) {
-    struct curl_slist* headers = nullptr;
+  // Set up any required headers if needed. The list is rebuilt for
+  // every request so headers added with addRequestHeader only apply
+  // to the request they were added for.
+  curl_slist_free_all(this->requestHeaders);
+  this->requestHeaders = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(this->authMutex);
     for (const auto pair : this->authConfigPtr->headers) {
       std::string nextHeader = pair.first + ": " + pair.second;
-      headers                = curl_slist_append(headers, nextHeader.c_str());
+      this->requestHeaders =
+          curl_slist_append(this->requestHeaders, nextHeader.c_str());
     }
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
   }
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, this->requestHeaders);
 
   // Now that we have a fully configured CURL handle, check if we need to do
   // any required auth steps. We may need to use the configured handle to
@@ -157,14 +220,55 @@ curlSetup:
   if (this->authConfigPtr->isExpired()) {
     WriteLog(LL_TRACE,
              "  Detected expired authentication. Reauthenticating...");
-    this->authConfigPtr->refresh(
-        this->curl, &(this->responseData), &(this->responseHeaderData));
+    {
+      std::lock_guard<std::mutex> lock(this->authMutex);
+      this->authConfigPtr->refresh(
+          this->curl, &(this->responseData), &(this->responseHeaderData));
+    }
     goto curlSetup;
   }
 
   return this->curl;
 }
 
+void ConnectionConfig::addRequestHeader(const std::string& header) {
+  this->requestHeaders =
+      curl_slist_append(this->requestHeaders, header.c_str());
+  curl_easy_setopt(this->curl, CURLOPT_HTTPHEADER, this->requestHeaders);
+}
+
+void ConnectionConfig::setCancelFlag(std::atomic<bool>* canceled) {
+  curl_easy_setopt(this->curl, CURLOPT_XFERINFODATA, canceled);
+}
+
+std::vector<std::string> ConnectionConfig::getAuthHeaders() {
+  std::lock_guard<std::mutex> lock(this->authMutex);
+  std::vector<std::string> headers;
+  for (const auto pair : this->authConfigPtr->headers) {
+    headers.push_back(pair.first + ": " + pair.second);
+  }
+  return headers;
+}
+
+bool ConnectionConfig::sendOutOfBandDelete(const std::string& uri) {
+  return sendStandaloneDelete(uri, this->getAuthHeaders());
+}
+
+void ConnectionConfig::reapQuery(const std::string& uri) {
+  if (not this->queryReaper) {
+    this->queryReaper = std::make_unique<QueryReaper>();
+  }
+  this->queryReaper->reap(uri, this->getAuthHeaders());
+}
+
+SegmentDownloader& ConnectionConfig::getSegmentDownloader() {
+  if (not this->segmentDownloader) {
+    this->segmentDownloader = std::make_unique<SegmentDownloader>(
+        std::max<size_t>(this->segmentDownloadThreads, 1));
+  }
+  return *this->segmentDownloader;
+}
+
 long ConnectionConfig::getLastHTTPStatusCode() {
   long httpStatusCode = -1;
   if (this->curl) {
@@ -181,6 +285,9 @@ void ConnectionConfig::disconnect() {
     curl_easy_cleanup(this->curl);
     this->curl = nullptr;
   }
+  curl_slist_free_all(this->requestHeaders);
+  this->requestHeaders = nullptr;
+  this->metadataCache.invalidate();
 }
 
 std::string ConnectionConfig::getTrinoServerVersion() {
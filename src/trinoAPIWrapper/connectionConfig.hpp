@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <curl/curl.h>
@@ -10,12 +13,22 @@
 #include "apiAuthMethod.hpp"
 #include "authProvider/authConfig.hpp"
 #include "environmentConfig.hpp"
+#include "metadataCache.hpp"
+#include "queryReaper.hpp"
+#include "requestLoop.hpp"
+#include "responseBuffers.hpp"
+#include "resultCache.hpp"
+#include "spillFile.hpp"
+#include "spooledSegments.hpp"
+
+#include "../util/writeLog.hpp"
 
 class ConnectionConfig {
   private:
     std::string hostname;
     unsigned short port;
     std::string connectionName;
+    std::string clientId;
     ApiAuthMethod authMethod;
     std::unique_ptr<AuthConfig> authConfigPtr;
     std::vector<std::function<void(ConnectionConfig*)>> onDisconnectCallbacks;
@@ -24,6 +37,15 @@ class ConnectionConfig {
     // we can set up all the right headers and SSL options
     // every time anything asks for a CURL handle.
     CURL* curl;
+    curl_slist* requestHeaders = nullptr;
+    // Guards the auth headers, which a cancel reads from another thread
+    // while this one may be refreshing them.
+    std::mutex authMutex;
+    // Started the first time a query gets a spooled result.
+    std::unique_ptr<SegmentDownloader> segmentDownloader;
+    // Started the first time a cursor is closed on an unfinished query.
+    std::unique_ptr<QueryReaper> queryReaper;
+    std::vector<std::string> getAuthHeaders();
 
   public:
     ConnectionConfig(std::string hostname,
@@ -39,7 +61,26 @@ class ConnectionConfig {
     std::string const getStatementUrl();
     unsigned short const getPort();
     ApiAuthMethod const getAuthMethod();
+    // Identifies the server, the user and the session settings queries
+    // run with, for keying shared caches. Empty until the connection
+    // knows which user it's acting as.
+    std::string getIdentity();
     CURL* getCurl();
+    // Add a header to the request being set up on the handle
+    // most recently returned by getCurl.
+    void addRequestHeader(const std::string& header);
+    // Have the request being set up give up once the flag is set.
+    void setCancelFlag(std::atomic<bool>* canceled);
+    /*
+    Send a DELETE on a short-lived handle of its own, so it goes out
+    right away even while another thread is using the connection's
+    handle. Safe to call from any thread.
+    */
+    bool sendOutOfBandDelete(const std::string& uri);
+    // Have a background thread stop the query at uri, retrying if it
+    // has to, and return right away.
+    void reapQuery(const std::string& uri);
+    SegmentDownloader& getSegmentDownloader();
     long getLastHTTPStatusCode();
     void disconnect();
     std::string getTrinoServerVersion();
@@ -49,5 +90,32 @@ class ConnectionConfig {
     // Making these public because they're frequently accessed and
     // manipulated external to the ConnectionConfig object
     std::string responseData;
-    std::map<std::string, std::string> responseHeaderData;
+    ResponseHeaders responseHeaderData;
+
+    // Catalog metadata results, shared by the connection's statements.
+    MetadataCache metadataCache;
+    // How this connection uses the process wide result cache.
+    ResultCacheSettings resultCacheSettings;
+    // How much memory buffered rows may use before ingestion pauses or
+    // they spill to disk, how much the connection's statements are
+    // using right now, and the most they have used at once. Statements
+    // on different threads update the counts.
+    SpillSettings spillSettings;
+    std::atomic<size_t> bufferedBytes     = 0;
+    std::atomic<size_t> peakBufferedBytes = 0;
+    // SQL_ATTR_LOGIN_TIMEOUT bounds connecting to the server, and
+    // SQL_ATTR_CONNECTION_TIMEOUT bounds every request sent to it.
+    // Zero means no limit.
+    std::chrono::seconds loginTimeout      = std::chrono::seconds(0);
+    std::chrono::seconds connectionTimeout = std::chrono::seconds(0);
+    // How many spooled segments are downloaded at once. Zero means the
+    // spooling protocol isn't used, and rows come from the coordinator.
+    size_t segmentDownloadThreads = 0;
+    // The encodings spooled results may use, best first.
+    std::string spoolingEncoding = DEFAULT_SPOOLING_ENCODING;
+    // The DSN's LogLevel, which its statements' calls log at.
+    LogLevel logLevel = LL_NONE;
+    // Where its queries send their requests, one of the environment's
+    // request loops, which other connections may share.
+    RequestLoop* requestLoop = nullptr;
 };
@@ -1,12 +1,32 @@
+#include <algorithm>
 #include <curl/curl.h>
 #include <iostream>
+#include <thread>
 
 #include "environmentConfig.hpp"
 
+// The most request loop threads an environment starts.
+static const size_t MAX_REQUEST_LOOPS = 8;
+
 EnvironmentConfig::EnvironmentConfig() {
   curl_global_init(CURL_GLOBAL_DEFAULT);
 }
 
 EnvironmentConfig::~EnvironmentConfig() {
+  // The loops' multi handles have to go before curl does.
+  this->requestLoops.clear();
   curl_global_cleanup();
 }
+
+RequestLoop& EnvironmentConfig::getRequestLoop() {
+  std::lock_guard<std::mutex> lock(this->requestLoopMutex);
+  size_t loopLimit = std::clamp<size_t>(
+      std::thread::hardware_concurrency(), 1, MAX_REQUEST_LOOPS);
+  if (this->requestLoops.size() < loopLimit) {
+    this->requestLoops.push_back(std::make_unique<RequestLoop>());
+    return *this->requestLoops.back();
+  }
+  RequestLoop& requestLoop = *this->requestLoops[this->nextRequestLoop];
+  this->nextRequestLoop = (this->nextRequestLoop + 1) % loopLimit;
+  return requestLoop;
+}
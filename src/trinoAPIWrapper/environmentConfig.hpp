@@ -1,9 +1,27 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
+
+#include "requestLoop.hpp"
 
 class EnvironmentConfig {
+  private:
+    // Request loops shared by the environment's connections. Each loop
+    // is one thread, and receiving a response, inflating it and reading
+    // its headers all happen on it, so connections are spread across
+    // several. A loop is started when a connection is configured, until
+    // there are as many as the machine has cores, up to a limit, and
+    // after that connections take turns.
+    std::mutex requestLoopMutex;
+    std::vector<std::unique_ptr<RequestLoop>> requestLoops;
+    size_t nextRequestLoop = 0;
+
   public:
     EnvironmentConfig();
     ~EnvironmentConfig();
+    // The loop for a new connection's requests.
+    RequestLoop& getRequestLoop();
 };
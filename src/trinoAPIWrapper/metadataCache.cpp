@@ -0,0 +1,88 @@
+#include "metadataCache.hpp"
+
+#include "../util/writeLog.hpp"
+
+void MetadataCache::configure(std::chrono::steady_clock::duration timeToLive,
+                              size_t maxEntries,
+                              bool prefetchSchemas) {
+  this->timeToLive      = timeToLive;
+  this->maxEntries      = maxEntries;
+  this->prefetchSchemas = prefetchSchemas;
+  this->invalidate();
+}
+
+bool MetadataCache::isEnabled() const {
+  return this->timeToLive > std::chrono::steady_clock::duration::zero() and
+         this->maxEntries > 0;
+}
+
+bool MetadataCache::getPrefetchSchemas() const {
+  return this->prefetchSchemas and this->isEnabled();
+}
+
+MetadataCache::Entry* MetadataCache::find(const std::string& key) {
+  auto found = this->entries.find(key);
+  if (found == this->entries.end()) {
+    return nullptr;
+  }
+  Entry& entry = found->second;
+  if (std::chrono::steady_clock::now() - entry.storedAt >= this->timeToLive) {
+    WriteLog(LL_TRACE, "  Metadata cache entry expired");
+    this->recency.erase(entry.recencyPosition);
+    this->entries.erase(found);
+    return nullptr;
+  }
+  this->recency.splice(
+      this->recency.begin(), this->recency, entry.recencyPosition);
+  return &entry;
+}
+
+const StaticResult* MetadataCache::lookup(const std::string& key) {
+  Entry* entry = this->find(key);
+  return entry ? &entry->result : nullptr;
+}
+
+const StaticResult* MetadataCache::lookupTable(const std::string& schemaKey,
+                                               const std::string& tableKey) {
+  Entry* entry = this->find(schemaKey);
+  if (not entry) {
+    return nullptr;
+  }
+  auto table = entry->tables.find(tableKey);
+  return table == entry->tables.end() ? nullptr : &table->second;
+}
+
+void MetadataCache::store(const std::string& key, StaticResult result) {
+  this->storeSchema(key, std::move(result), {});
+}
+
+void MetadataCache::storeSchema(const std::string& key,
+                                StaticResult result,
+                                std::map<std::string, StaticResult> tables) {
+  if (not this->isEnabled()) {
+    return;
+  }
+  auto found = this->entries.find(key);
+  if (found != this->entries.end()) {
+    this->recency.erase(found->second.recencyPosition);
+    this->entries.erase(found);
+  }
+  this->recency.push_front(key);
+  this->entries[key] = Entry{std::move(result),
+                             std::move(tables),
+                             std::chrono::steady_clock::now(),
+                             this->recency.begin()};
+  while (this->entries.size() > this->maxEntries) {
+    this->entries.erase(this->recency.back());
+    this->recency.pop_back();
+  }
+}
+
+void MetadataCache::invalidate() {
+  this->entries.clear();
+  this->recency.clear();
+}
+
+size_t MetadataCache::size() const {
+  return this->entries.size();
+}
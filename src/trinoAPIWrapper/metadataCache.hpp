@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <map>
+#include <string>
+
+#include "resultPage.hpp"
+
+/*
+Catalog metadata results kept for reuse within a connection.
+
+Applications like PowerBI and Excel call SQLTables and SQLColumns over
+and over with the same arguments while building their navigators, and
+each call would otherwise be a full Trino query. Results are kept as
+fully decoded static results, so a repeated call can sideload one
+instead of going to the server.
+
+Entries expire after the time to live, and the least recently used
+entry is dropped once there are more than maxEntries. A time to live
+or size of zero turns the cache off.
+
+With schema prefetch on, the first SQLColumns call for a table loads
+the columns of every table in its schema. The schema is stored as a
+single entry that also holds each table's result, so calls for sibling
+tables are answered from the cache, and a schema with more tables than
+maxEntries doesn't evict itself.
+*/
+class MetadataCache {
+  private:
+    struct Entry {
+        StaticResult result;
+        // For a schema, the results of its tables, sharing their pages
+        // with the schema's result.
+        std::map<std::string, StaticResult> tables;
+        std::chrono::steady_clock::time_point storedAt;
+        std::list<std::string>::iterator recencyPosition;
+    };
+
+    std::chrono::steady_clock::duration timeToLive =
+        std::chrono::steady_clock::duration::zero();
+    size_t maxEntries    = 0;
+    bool prefetchSchemas = false;
+    std::map<std::string, Entry> entries;
+    // Keys from most to least recently used.
+    std::list<std::string> recency;
+    // Returns nullptr if there's no unexpired entry for the key, and
+    // marks the entry as the most recently used otherwise.
+    Entry* find(const std::string& key);
+
+  public:
+    void configure(std::chrono::steady_clock::duration timeToLive,
+                   size_t maxEntries,
+                   bool prefetchSchemas);
+    bool isEnabled() const;
+    bool getPrefetchSchemas() const;
+    // Returns nullptr if there's no unexpired entry for the key.
+    const StaticResult* lookup(const std::string& key);
+    // Returns nullptr if there's no unexpired entry for the schema, or
+    // it doesn't have the table.
+    const StaticResult* lookupTable(const std::string& schemaKey,
+                                    const std::string& tableKey);
+    void store(const std::string& key, StaticResult result);
+    // Store a schema's result along with its tables' results, keyed by
+    // the query each table's own call would run.
+    void storeSchema(const std::string& key,
+                     StaticResult result,
+                     std::map<std::string, StaticResult> tables);
+    void invalidate();
+    size_t size() const;
+};
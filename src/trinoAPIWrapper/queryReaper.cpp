@@ -0,0 +1,130 @@
+#include "queryReaper.hpp"
+
+#include <algorithm>
+#include <curl/curl.h>
+
+#include "../util/writeLog.hpp"
+
+// How many times a DELETE is sent before the query is left to finish
+// on its own, and how long to wait before the first retry.
+static const int REAP_ATTEMPTS = 4;
+static const std::chrono::milliseconds REAP_RETRY_DELAY(500);
+// How long one DELETE may take, since it's retried anyway, and how
+// long closing the connection may wait on the DELETEs in all. A DELETE
+// already under way when the connection closes adds to the second.
+static const std::chrono::milliseconds REAP_REQUEST_TIMEOUT(2000);
+static const std::chrono::milliseconds REAP_SHUTDOWN_WAIT(2000);
+
+static size_t
+curlWriteCallback(void* contents, size_t size, size_t nmemb, std::string* s) {
+  size_t totalSize = size * nmemb;
+  s->append(static_cast<char*>(contents), totalSize);
+  return totalSize;
+}
+
+bool sendStandaloneDelete(const std::string& uri,
+                          const std::vector<std::string>& headers,
+                          std::chrono::milliseconds timeout) {
+  curl_slist* headerList = nullptr;
+  for (const std::string& header : headers) {
+    headerList = curl_slist_append(headerList, header.c_str());
+  }
+  std::string ignored;
+  CURL* curl = curl_easy_init();
+  curl_easy_setopt(curl, CURLOPT_SSL_OPTIONS, CURLSSLOPT_NATIVE_CA);
+  curl_easy_setopt(curl, CURLOPT_URL, uri.c_str());
+  curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headerList);
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlWriteCallback);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ignored);
+  // Someone may be waiting on this, so it can't hang.
+  curl_easy_setopt(
+      curl, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout.count()));
+  CURLcode res        = curl_easy_perform(curl);
+  long httpStatusCode = 0;
+  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpStatusCode);
+  curl_easy_cleanup(curl);
+  curl_slist_free_all(headerList);
+  // A server error may pass, but anything else won't change on retry.
+  return res == CURLE_OK and httpStatusCode < 500;
+}
+
+QueryReaper::QueryReaper() {
+  this->worker = std::thread(&QueryReaper::work, this);
+}
+
+QueryReaper::~QueryReaper() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+    this->stopBy   = std::chrono::steady_clock::now() + REAP_SHUTDOWN_WAIT;
+  }
+  this->wake.notify_all();
+  this->worker.join();
+}
+
+void QueryReaper::reap(const std::string& uri,
+                       std::vector<std::string> headers) {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Task task;
+    task.uri       = uri;
+    task.headers   = std::move(headers);
+    task.notBefore = std::chrono::steady_clock::now();
+    this->tasks.push_back(std::move(task));
+  }
+  this->wake.notify_one();
+}
+
+void QueryReaper::work() {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (not(this->stopping and this->tasks.empty())) {
+    auto due = std::min_element(
+        this->tasks.begin(),
+        this->tasks.end(),
+        [](const Task& a, const Task& b) { return a.notBefore < b.notBefore; });
+    if (due == this->tasks.end()) {
+      this->wake.wait(lock);
+      continue;
+    }
+    // Once the connection is closing, nothing waits for its retry.
+    if (not this->stopping and
+        due->notBefore > std::chrono::steady_clock::now()) {
+      this->wake.wait_until(lock, due->notBefore);
+      continue;
+    }
+    std::chrono::milliseconds timeout = REAP_REQUEST_TIMEOUT;
+    if (this->stopping) {
+      std::chrono::milliseconds remaining =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              this->stopBy - std::chrono::steady_clock::now());
+      if (remaining.count() <= 0) {
+        WriteLog(LL_WARN,
+                 "  Out of time. Leaving " +
+                     std::to_string(this->tasks.size()) +
+                     " queries to finish on their own");
+        this->tasks.clear();
+        break;
+      }
+      timeout = std::min(timeout, remaining);
+    }
+    Task task = std::move(*due);
+    this->tasks.erase(due);
+
+    lock.unlock();
+    bool stopped = sendStandaloneDelete(task.uri, task.headers, timeout);
+    lock.lock();
+
+    task.attempts++;
+    if (stopped) {
+      continue;
+    }
+    if (task.attempts < REAP_ATTEMPTS and not this->stopping) {
+      task.notBefore = std::chrono::steady_clock::now() +
+                       REAP_RETRY_DELAY * (1 << (task.attempts - 1));
+      this->tasks.push_back(std::move(task));
+    } else {
+      WriteLog(LL_WARN, "  Gave up stopping the query at " + task.uri);
+    }
+  }
+}
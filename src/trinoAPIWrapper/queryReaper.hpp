@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The longest a standalone DELETE waits for Trino, unless told otherwise.
+const std::chrono::milliseconds STANDALONE_DELETE_TIMEOUT(10000);
+
+/*
+Send a DELETE on a short-lived curl handle of its own, with the given
+headers. Returns true once Trino has the request, including when the
+query is already gone. Safe to call from any thread.
+*/
+bool sendStandaloneDelete(
+    const std::string& uri,
+    const std::vector<std::string>& headers,
+    std::chrono::milliseconds timeout = STANDALONE_DELETE_TIMEOUT);
+
+/*
+Stops queries nobody is reading any more, on a thread of its own, so
+closing a cursor doesn't wait on Trino. A DELETE that fails is tried
+again a few times, further apart each time, since a query left
+running holds cluster memory until it finishes on its own.
+*/
+class QueryReaper {
+  private:
+    struct Task {
+        std::string uri;
+        std::vector<std::string> headers;
+        int attempts = 0;
+        std::chrono::steady_clock::time_point notBefore;
+    };
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Task> tasks;
+    std::thread worker;
+    bool stopping = false;
+    // Once stopping, what's still queued by then is dropped.
+    std::chrono::steady_clock::time_point stopBy;
+    void work();
+
+  public:
+    QueryReaper();
+    // Sends the DELETEs still queued, without further retries, for a
+    // short while at most. Queries left after that finish on their own.
+    ~QueryReaper();
+    QueryReaper(const QueryReaper&)            = delete;
+    QueryReaper& operator=(const QueryReaper&) = delete;
+    // Queue a DELETE for a query's nextUri and return right away.
+    void reap(const std::string& uri, std::vector<std::string> headers);
+};
@@ -0,0 +1,194 @@
+#include "requestLoop.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+// The longest the loop sleeps without looking around, in case curl has
+// nothing for it to wait on and nothing else wakes it.
+static const std::chrono::milliseconds LOOP_IDLE_WAIT(1000);
+
+void TaskWakeup::post() {
+  // Notified under the lock, since the waiter may be done with the
+  // wakeup, and free it, as soon as it sees the post.
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->ready = true;
+  this->posted.notify_one();
+}
+
+void TaskWakeup::take() {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->posted.wait(lock, [this]() { return this->ready; });
+  this->ready = false;
+}
+
+QueryTask QueryTask::promise_type::get_return_object() {
+  return QueryTask(
+      std::coroutine_handle<QueryTask::promise_type>::from_promise(*this));
+}
+
+QueryTask::QueryTask(std::coroutine_handle<promise_type> handle)
+    : handle(handle) {}
+
+QueryTask::QueryTask(QueryTask&& other) noexcept
+    : handle(std::exchange(other.handle, nullptr)) {}
+
+QueryTask::~QueryTask() {
+  if (this->handle) {
+    this->handle.destroy();
+  }
+}
+
+void QueryTask::wait() {
+  promise_type& promise = this->handle.promise();
+  this->handle.resume();
+  while (not this->handle.done()) {
+    // The task is waiting on the loop. Sleep until it's done with
+    // the task's request or pause, then carry on with the task here.
+    promise.wakeup.take();
+    this->handle.resume();
+  }
+  if (promise.exception) {
+    std::rethrow_exception(promise.exception);
+  }
+}
+
+RequestLoop::TransferAwaiter::TransferAwaiter(RequestLoop& loop, CURL* curl)
+    : loop(loop) {
+  this->transfer.curl = curl;
+}
+
+void RequestLoop::TransferAwaiter::await_suspend(
+    std::coroutine_handle<QueryTask::promise_type> h) {
+  this->transfer.wakeup = &h.promise().wakeup;
+  this->loop.submit(&this->transfer);
+}
+
+RequestLoop::SleepAwaiter::SleepAwaiter(RequestLoop& loop,
+                                        std::chrono::milliseconds pause,
+                                        const std::atomic<bool>* interrupt)
+    : loop(loop) {
+  this->timer.due       = std::chrono::steady_clock::now() + pause;
+  this->timer.interrupt = interrupt;
+}
+
+void RequestLoop::SleepAwaiter::await_suspend(
+    std::coroutine_handle<QueryTask::promise_type> h) {
+  this->timer.wakeup = &h.promise().wakeup;
+  this->loop.submit(this->timer);
+}
+
+RequestLoop::RequestLoop() {
+  this->multi  = curl_multi_init();
+  this->worker = std::thread(&RequestLoop::work, this);
+}
+
+RequestLoop::~RequestLoop() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+  curl_multi_wakeup(this->multi);
+  this->worker.join();
+  curl_multi_cleanup(this->multi);
+}
+
+RequestLoop::TransferAwaiter RequestLoop::perform(CURL* curl) {
+  return TransferAwaiter(*this, curl);
+}
+
+RequestLoop::SleepAwaiter
+RequestLoop::sleepFor(std::chrono::milliseconds pause,
+                      const std::atomic<bool>* interrupt) {
+  return SleepAwaiter(*this, pause, interrupt);
+}
+
+CURLcode RequestLoop::performAndWait(CURL* curl) {
+  TaskWakeup wakeup;
+  Transfer transfer;
+  transfer.curl   = curl;
+  transfer.wakeup = &wakeup;
+  this->submit(&transfer);
+  wakeup.take();
+  return transfer.result;
+}
+
+void RequestLoop::interrupt() {
+  curl_multi_wakeup(this->multi);
+}
+
+void RequestLoop::submit(Transfer* transfer) {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->submitted.push_back(transfer);
+  }
+  curl_multi_wakeup(this->multi);
+}
+
+void RequestLoop::submit(Timer timer) {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->timers.push_back(timer);
+  }
+  curl_multi_wakeup(this->multi);
+}
+
+/*
+Only this thread uses the multi handle, apart from curl_multi_wakeup,
+which is safe from anywhere. Everything other threads hand over goes
+through the mutex, and the loop wakes up to pick it up.
+*/
+void RequestLoop::work() {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (not this->stopping) {
+    for (Transfer* transfer : this->submitted) {
+      curl_easy_setopt(transfer->curl, CURLOPT_PRIVATE, transfer);
+      curl_multi_add_handle(this->multi, transfer->curl);
+    }
+    this->submitted.clear();
+
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point nextDue = now + LOOP_IDLE_WAIT;
+    for (auto timer = this->timers.begin(); timer != this->timers.end();) {
+      if (timer->due <= now or
+          (timer->interrupt and timer->interrupt->load())) {
+        timer->wakeup->post();
+        timer = this->timers.erase(timer);
+      } else {
+        nextDue = std::min(nextDue, timer->due);
+        ++timer;
+      }
+    }
+    lock.unlock();
+
+    int running = 0;
+    curl_multi_perform(this->multi, &running);
+    int queued = 0;
+    while (CURLMsg* message = curl_multi_info_read(this->multi, &queued)) {
+      if (message->msg != CURLMSG_DONE) {
+        continue;
+      }
+      // The message is gone once its handle is removed.
+      CURL* curl         = message->easy_handle;
+      CURLcode result    = message->data.result;
+      Transfer* transfer = nullptr;
+      curl_easy_getinfo(curl, CURLINFO_PRIVATE, &transfer);
+      curl_multi_remove_handle(this->multi, curl);
+      // The task may reuse the handle as soon as it's woken.
+      transfer->result = result;
+      transfer->wakeup->post();
+    }
+
+    // Curl shortens the wait if a transfer needs seeing to sooner.
+    std::chrono::milliseconds wait =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            nextDue - std::chrono::steady_clock::now());
+    curl_multi_poll(this->multi,
+                    nullptr,
+                    0,
+                    static_cast<int>(std::max<int64_t>(wait.count(), 0)),
+                    nullptr);
+    lock.lock();
+  }
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <curl/curl.h>
+
+/*
+How a suspended task learns it can go on. The request loop posts to it
+from its own thread, and the thread waiting on the task takes the post
+and resumes the task itself.
+*/
+class TaskWakeup {
+  private:
+    std::mutex mutex;
+    std::condition_variable posted;
+    bool ready = false;
+
+  public:
+    void post();
+    // Block until something is posted, and clear it.
+    void take();
+};
+
+/*
+A query's work, written as a coroutine that suspends whenever it waits
+on the server. It doesn't start until something waits on it, and it
+only ever runs on the waiting thread, so its code sees that thread's
+log level and never races the code that started it. While it's
+suspended, the waiting thread sleeps and the request loop's thread
+does the waiting for it.
+*/
+class QueryTask {
+  public:
+    struct promise_type {
+        TaskWakeup wakeup;
+        std::exception_ptr exception;
+        QueryTask get_return_object();
+        std::suspend_always initial_suspend() noexcept {
+          return {};
+        }
+        std::suspend_always final_suspend() noexcept {
+          return {};
+        }
+        void return_void() {}
+        void unhandled_exception() {
+          this->exception = std::current_exception();
+        }
+    };
+
+  private:
+    std::coroutine_handle<promise_type> handle;
+
+  public:
+    explicit QueryTask(std::coroutine_handle<promise_type> handle);
+    QueryTask(QueryTask&& other) noexcept;
+    ~QueryTask();
+    QueryTask(const QueryTask&)            = delete;
+    QueryTask& operator=(const QueryTask&) = delete;
+    QueryTask& operator=(QueryTask&&)      = delete;
+    // Run the task to its end on this thread, and rethrow whatever it
+    // threw.
+    void wait();
+};
+
+/*
+Runs the requests the queries of some connections send, and the pauses
+between their polls, on one thread. Curl's multi interface lets that
+thread have any number of transfers going at once, on connections
+shared between them, so hundreds of queries can be waiting on Trino
+without a thread each doing the waiting. Curl receives and inflates
+every response on this thread, so an environment spreads its
+connections over a few loops rather than giving them all one.
+
+A request is a curl handle set up as usual. A task hands it over with
+co_await perform(curl), and the loop adds it to its multi handle,
+takes it back out when the transfer is done, and wakes the task with
+the result. The handle isn't touched by the loop at any other time.
+*/
+class RequestLoop {
+  private:
+    struct Transfer {
+        CURL* curl         = nullptr;
+        CURLcode result    = CURLE_OK;
+        TaskWakeup* wakeup = nullptr;
+    };
+    struct Timer {
+        std::chrono::steady_clock::time_point due;
+        const std::atomic<bool>* interrupt = nullptr;
+        TaskWakeup* wakeup                 = nullptr;
+    };
+    CURLM* multi;
+    std::mutex mutex;
+    // Handed over by other threads, for the loop to start.
+    std::vector<Transfer*> submitted;
+    std::vector<Timer> timers;
+    bool stopping = false;
+    std::thread worker;
+    void work();
+    void submit(Transfer* transfer);
+    void submit(Timer timer);
+
+  public:
+    class TransferAwaiter {
+      private:
+        RequestLoop& loop;
+        Transfer transfer;
+
+      public:
+        TransferAwaiter(RequestLoop& loop, CURL* curl);
+        bool await_ready() const noexcept {
+          return false;
+        }
+        void await_suspend(std::coroutine_handle<QueryTask::promise_type> h);
+        CURLcode await_resume() const noexcept {
+          return this->transfer.result;
+        }
+    };
+    class SleepAwaiter {
+      private:
+        RequestLoop& loop;
+        Timer timer;
+
+      public:
+        SleepAwaiter(RequestLoop& loop,
+                     std::chrono::milliseconds pause,
+                     const std::atomic<bool>* interrupt);
+        bool await_ready() const noexcept {
+          return false;
+        }
+        void await_suspend(std::coroutine_handle<QueryTask::promise_type> h);
+        void await_resume() const noexcept {}
+    };
+
+    RequestLoop();
+    // Nothing may be in flight by now, since an environment's
+    // connections and their statements are freed before it is.
+    ~RequestLoop();
+    RequestLoop(const RequestLoop&)            = delete;
+    RequestLoop& operator=(const RequestLoop&) = delete;
+    // Send the request set up on curl. The task resumes with its result.
+    TransferAwaiter perform(CURL* curl);
+    // Pause the task, for no longer than it takes interrupt to be set
+    // and interrupt() to be called.
+    SleepAwaiter sleepFor(std::chrono::milliseconds pause,
+                          const std::atomic<bool>* interrupt);
+    // perform, for callers that aren't tasks.
+    CURLcode performAndWait(CURL* curl);
+    // Have paused tasks check their interrupt flags now. Safe to call
+    // from any thread.
+    void interrupt();
+};
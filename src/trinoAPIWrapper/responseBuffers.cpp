@@ -0,0 +1,148 @@
+#include "responseBuffers.hpp"
+
+#include <array>
+#include <cctype>
+#include <charconv>
+
+// The headers addLine keeps. Content-Length is read as it goes by.
+static constexpr std::array<std::string_view, 1> KEPT_RESPONSE_HEADERS = {
+    "www-authenticate",
+};
+
+// Buffers too small to save much growing, or too large to hold on to,
+// aren't kept. Nor are more than so many, or so much memory in all.
+constexpr size_t RESPONSE_BUFFER_MIN_BYTES  = 4 * 1024;
+constexpr size_t RESPONSE_BUFFER_MAX_BYTES  = 16 * 1024 * 1024;
+constexpr size_t RESPONSE_BUFFER_POOL_COUNT = 16;
+constexpr size_t RESPONSE_BUFFER_POOL_BYTES = 32 * 1024 * 1024;
+
+static bool equalsIgnoringCase(std::string_view a, std::string_view b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (std::tolower(static_cast<unsigned char>(a[i])) !=
+        std::tolower(static_cast<unsigned char>(b[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static std::string_view trimmed(std::string_view text) {
+  while (not text.empty() and std::isspace(static_cast<unsigned char>(
+                                  text.front()))) {
+    text.remove_prefix(1);
+  }
+  while (not text.empty() and std::isspace(static_cast<unsigned char>(
+                                  text.back()))) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+void ResponseHeaders::addLine(std::string_view line) {
+  if (line.starts_with("HTTP/")) {
+    // A status line starts the headers of another response, like the
+    // one after a 100 Continue, and its body is the one that counts.
+    this->contentLength = 0;
+    return;
+  }
+  size_t colon = line.find(':');
+  if (colon == std::string_view::npos) {
+    return;
+  }
+  std::string_view name  = trimmed(line.substr(0, colon));
+  std::string_view value = trimmed(line.substr(colon + 1));
+
+  if (equalsIgnoringCase(name, "content-length")) {
+    size_t length = 0;
+    auto result =
+        std::from_chars(value.data(), value.data() + value.size(), length);
+    if (result.ec == std::errc()) {
+      this->contentLength = length;
+    }
+    return;
+  }
+  for (std::string_view kept : KEPT_RESPONSE_HEADERS) {
+    if (equalsIgnoringCase(name, kept)) {
+      Header header;
+      header.nameOffset = this->arena.size();
+      header.nameLength = name.size();
+      this->arena.append(name);
+      header.valueOffset = this->arena.size();
+      header.valueLength = value.size();
+      this->arena.append(value);
+      this->kept.push_back(header);
+      return;
+    }
+  }
+}
+
+void ResponseHeaders::clear() {
+  this->arena.clear();
+  this->kept.clear();
+  this->contentLength = 0;
+}
+
+bool ResponseHeaders::contains(std::string_view name) const {
+  for (const Header& header : this->kept) {
+    std::string_view keptName(this->arena.data() + header.nameOffset,
+                              header.nameLength);
+    if (equalsIgnoringCase(keptName, name)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string_view ResponseHeaders::get(std::string_view name) const {
+  for (const Header& header : this->kept) {
+    std::string_view keptName(this->arena.data() + header.nameOffset,
+                              header.nameLength);
+    if (equalsIgnoringCase(keptName, name)) {
+      return std::string_view(this->arena.data() + header.valueOffset,
+                              header.valueLength);
+    }
+  }
+  return std::string_view();
+}
+
+size_t ResponseHeaders::getContentLength() const {
+  return this->contentLength;
+}
+
+std::string ResponseBufferPool::take() {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->buffers.empty()) {
+    return std::string();
+  }
+  std::string buffer = std::move(this->buffers.back());
+  this->buffers.pop_back();
+  this->pooledBytes -= buffer.capacity();
+  return buffer;
+}
+
+void ResponseBufferPool::give(std::string&& buffer) {
+  size_t capacity = buffer.capacity();
+  if (capacity < RESPONSE_BUFFER_MIN_BYTES or
+      capacity > RESPONSE_BUFFER_MAX_BYTES) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->buffers.size() >= RESPONSE_BUFFER_POOL_COUNT or
+      this->pooledBytes + capacity > RESPONSE_BUFFER_POOL_BYTES) {
+    return;
+  }
+  buffer.clear();
+  this->pooledBytes += capacity;
+  this->buffers.push_back(std::move(buffer));
+}
+
+ResponseBufferPool& getResponseBufferPool() {
+  // Never destroyed. Cached result pages give their buffers back when
+  // the result cache is destroyed at exit, which can be after a static
+  // pool would be gone.
+  static ResponseBufferPool* responseBufferPool = new ResponseBufferPool;
+  return *responseBufferPool;
+}
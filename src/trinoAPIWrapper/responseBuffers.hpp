@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+The response headers the driver reads. Every poll gets a dozen or so
+headers and hardly any of them matter, so a header line is only kept
+if its name is one the driver looks up. The lines that are kept are
+copied into one buffer that's reused from request to request, and
+looked up as views into it, rather than each name and value getting
+strings of their own.
+*/
+class ResponseHeaders {
+  private:
+    struct Header {
+        size_t nameOffset;
+        size_t nameLength;
+        size_t valueOffset;
+        size_t valueLength;
+    };
+    std::string arena;
+    std::vector<Header> kept;
+    size_t contentLength = 0;
+
+  public:
+    // Take a raw header line as curl hands it over, line ending and all.
+    void addLine(std::string_view line);
+    void clear();
+    // Names are matched regardless of case, as HTTP requires.
+    bool contains(std::string_view name) const;
+    // The first value sent for the header, or an empty view if it
+    // wasn't. The view is good until the headers change.
+    std::string_view get(std::string_view name) const;
+    // The body's size as the server sent it, which is before curl
+    // inflates a compressed body. Zero if it wasn't given.
+    size_t getContentLength() const;
+};
+
+/*
+Response bodies that result pages are done with, kept for the next
+response to stream into. A body that becomes a page is handed over
+to it whole, so without these every poll would start over with an
+empty buffer and grow it a few kilobytes at a time. Only a few
+buffers of reasonable size are kept, since the memory they hold isn't
+counted against any statement's buffer budget. Safe to use from any
+thread.
+*/
+class ResponseBufferPool {
+  private:
+    std::mutex mutex;
+    std::vector<std::string> buffers;
+    size_t pooledBytes = 0;
+
+  public:
+    // An empty buffer, with whatever room a pooled one had.
+    std::string take();
+    void give(std::string&& buffer);
+};
+
+// The process wide pool every connection's responses come from.
+ResponseBufferPool& getResponseBufferPool();
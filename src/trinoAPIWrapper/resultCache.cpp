@@ -0,0 +1,278 @@
+#include "resultCache.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+
+#include "../util/windowsLean.hpp"
+#include <sddl.h>
+
+#include "../util/writeLog.hpp"
+
+static const std::string DISK_FILE_PREFIX = "trino-odbc-result-";
+
+// How often a disk directory is swept for expired files. Sweeping stats
+// every file in it, so it isn't done on every store.
+static const std::chrono::minutes DISK_PRUNE_INTERVAL(10);
+
+static std::filesystem::path diskPath(const std::string& key,
+                                      const ResultCacheSettings& settings) {
+  return std::filesystem::path(settings.diskDirectory) /
+         std::format("{}{:016x}.json",
+                     DISK_FILE_PREFIX,
+                     std::hash<std::string>{}(key));
+}
+
+static bool isExpiredOnDisk(const std::filesystem::path& path,
+                            const ResultCacheSettings& settings) {
+  auto age = std::filesystem::file_time_type::clock::now() -
+             std::filesystem::last_write_time(path);
+  return age >= settings.timeToLive;
+}
+
+/*
+Read a result another connection or process stored on disk. The file
+holds the key it was stored under, since different keys can share a
+file name.
+*/
+static bool readFromDisk(const std::string& key,
+                         const ResultCacheSettings& settings,
+                         StaticResult& result) {
+  try {
+    std::filesystem::path path = diskPath(key, settings);
+    if (not std::filesystem::exists(path) or isExpiredOnDisk(path, settings)) {
+      return false;
+    }
+    std::ifstream input(path, std::ios::binary);
+    json stored = json::parse(input);
+    if (stored.value("key", "") != key) {
+      return false;
+    }
+    result.columns = stored["columns"].get<std::vector<json>>();
+    result.pages   = {std::make_shared<ResultPage>(stored["data"])};
+    return true;
+  } catch (const std::exception& ex) {
+    WriteLog(LL_WARN,
+             "  WARNING: Could not read cached result from disk: " +
+                 std::string(ex.what()));
+    return false;
+  }
+}
+
+/*
+Create an empty file that only the current user can open, since a
+result holds whatever that user was allowed to read and the directory
+may be shared. Writing to the file later keeps its permissions, and so
+does renaming it.
+*/
+static void createOwnerOnlyFile(const std::filesystem::path& path) {
+  // Full access for the file's owner and nobody else, without the
+  // entries the directory would otherwise pass on.
+  PSECURITY_DESCRIPTOR descriptor = nullptr;
+  if (not ConvertStringSecurityDescriptorToSecurityDescriptorW(
+          L"D:P(A;;FA;;;OW)", SDDL_REVISION_1, &descriptor, nullptr)) {
+    throw std::runtime_error("Could not describe owner-only permissions: " +
+                             std::to_string(GetLastError()));
+  }
+  SECURITY_ATTRIBUTES attributes = {sizeof(attributes), descriptor, FALSE};
+  // A file that's already there keeps its own permissions, so whatever
+  // an earlier writer left behind goes first.
+  std::filesystem::remove(path);
+  HANDLE file = CreateFileW(path.c_str(),
+                            GENERIC_WRITE,
+                            0,
+                            &attributes,
+                            CREATE_NEW,
+                            FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  DWORD error = GetLastError();
+  LocalFree(descriptor);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Could not create " + path.string() + ": " +
+                             std::to_string(error));
+  }
+  CloseHandle(file);
+}
+
+// Remove the files in the disk directory that have expired.
+static void pruneDisk(const ResultCacheSettings& settings) {
+  try {
+    if (not std::filesystem::exists(settings.diskDirectory)) {
+      return;
+    }
+    for (const auto& file :
+         std::filesystem::directory_iterator(settings.diskDirectory)) {
+      if (file.path().filename().string().starts_with(DISK_FILE_PREFIX) and
+          isExpiredOnDisk(file.path(), settings)) {
+        std::filesystem::remove(file.path());
+      }
+    }
+  } catch (const std::exception& ex) {
+    WriteLog(LL_WARN,
+             "  WARNING: Could not remove expired results from disk: " +
+                 std::string(ex.what()));
+  }
+}
+
+/*
+Write a result to disk, replacing the file in one step so readers
+never see half of it.
+*/
+static void writeToDisk(const std::string& key,
+                        const ResultCacheSettings& settings,
+                        const StaticResult& result) {
+  try {
+    std::filesystem::create_directories(settings.diskDirectory);
+
+    json rows = json::array();
+    for (const std::shared_ptr<ResultPage>& page : result.pages) {
+      for (size_t row = 0; row < page->getRowCount(); row++) {
+        json cells = json::array();
+        for (size_t column = 0; column < page->getColumnCount(); column++) {
+          cells.push_back(page->getCell(row, column));
+        }
+        rows.push_back(std::move(cells));
+      }
+    }
+    json stored = {{"key", key}, {"columns", result.columns}, {"data", rows}};
+
+    std::filesystem::path path = diskPath(key, settings);
+    std::filesystem::path temporaryPath(path.string() + ".tmp");
+    createOwnerOnlyFile(temporaryPath);
+    {
+      std::ofstream output(temporaryPath, std::ios::binary);
+      output << stored.dump();
+    }
+    std::filesystem::rename(temporaryPath, path);
+  } catch (const std::exception& ex) {
+    WriteLog(LL_WARN,
+             "  WARNING: Could not write cached result to disk: " +
+                 std::string(ex.what()));
+  }
+}
+
+void ResultCache::reserve(size_t maxBytes) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->maxBytes = std::max(this->maxBytes, maxBytes);
+}
+
+size_t ResultCache::getEntryByteLimit() {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->maxBytes / 4;
+}
+
+bool ResultCache::isDiskPruneDue(const std::string& directory) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto now   = std::chrono::steady_clock::now();
+  auto found = this->lastPruned.find(directory);
+  if (found != this->lastPruned.end() and
+      now - found->second < DISK_PRUNE_INTERVAL) {
+    return false;
+  }
+  this->lastPruned[directory] = now;
+  return true;
+}
+
+void ResultCache::erase(std::map<std::string, Entry>::iterator entry) {
+  this->totalBytes -= entry->second.byteSize;
+  this->recency.erase(entry->second.recencyPosition);
+  this->entries.erase(entry);
+}
+
+void ResultCache::insert(const std::string& key,
+                         StaticResult result,
+                         size_t byteSize) {
+  auto found = this->entries.find(key);
+  if (found != this->entries.end()) {
+    this->erase(found);
+  }
+  this->recency.push_front(key);
+  this->entries[key] = Entry{std::move(result),
+                             byteSize,
+                             std::chrono::steady_clock::now(),
+                             this->recency.begin()};
+  this->totalBytes += byteSize;
+  while (this->totalBytes > this->maxBytes and not this->recency.empty()) {
+    this->erase(this->entries.find(this->recency.back()));
+    this->counters.evictions++;
+  }
+}
+
+bool ResultCache::lookup(const std::string& key,
+                         const ResultCacheSettings& settings,
+                         StaticResult& result) {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto found = this->entries.find(key);
+    if (found != this->entries.end()) {
+      Entry& entry = found->second;
+      auto age     = std::chrono::steady_clock::now() - entry.storedAt;
+      if (age < settings.timeToLive) {
+        this->recency.splice(
+            this->recency.begin(), this->recency, entry.recencyPosition);
+        this->counters.hits++;
+        result = entry.result;
+        return true;
+      }
+      this->erase(found);
+    }
+  }
+
+  // Files are read without holding the lock, so other connections
+  // aren't held up. The result is kept in memory from then on.
+  bool foundOnDisk = not settings.diskDirectory.empty() and
+                     readFromDisk(key, settings, result);
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (foundOnDisk) {
+    size_t byteSize = 0;
+    for (const std::shared_ptr<ResultPage>& page : result.pages) {
+      byteSize += page->getByteSize();
+    }
+    if (byteSize <= this->maxBytes / 4) {
+      this->insert(key, result, byteSize);
+    }
+    this->counters.hits++;
+    this->counters.diskHits++;
+    return true;
+  }
+  this->counters.misses++;
+  return false;
+}
+
+void ResultCache::store(const std::string& key,
+                        const ResultCacheSettings& settings,
+                        StaticResult result,
+                        size_t byteSize) {
+  if (byteSize > this->getEntryByteLimit()) {
+    return;
+  }
+  if (not settings.diskDirectory.empty()) {
+    if (this->isDiskPruneDue(settings.diskDirectory)) {
+      pruneDisk(settings);
+    }
+    writeToDisk(key, settings, result);
+  }
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->insert(key, std::move(result), byteSize);
+  this->counters.stores++;
+}
+
+void ResultCache::clear() {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->entries.clear();
+  this->recency.clear();
+  this->totalBytes = 0;
+}
+
+ResultCacheCounters ResultCache::getCounters() {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->counters;
+}
+
+ResultCache& getResultCache() {
+  static ResultCache resultCache;
+  return resultCache;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "resultPage.hpp"
+
+/*
+How a connection uses the result cache. A time to live of zero means
+the connection doesn't use it. If diskDirectory is set, results are
+also written there and survive the process. Only the user who wrote a
+file can open it.
+*/
+struct ResultCacheSettings {
+    std::chrono::seconds timeToLive = std::chrono::seconds(0);
+    size_t maxBytes                 = 0;
+    std::string diskDirectory;
+};
+
+struct ResultCacheCounters {
+    uint64_t hits      = 0;
+    uint64_t diskHits  = 0;
+    uint64_t misses    = 0;
+    uint64_t stores    = 0;
+    uint64_t evictions = 0;
+};
+
+/*
+Results of read-only queries, kept for reuse by identical queries.
+
+Dashboards rerun the same few queries every few minutes, often from
+new connections, so the cache is shared by every connection in the
+process. Keys are built by the caller from everything that affects a
+query's result, like the server, the user, the session settings and
+the normalized text.
+
+Memory is bounded by the largest maxBytes any connection configured.
+The least recently used results are dropped to stay below it, and a
+single result may use at most a quarter of it, so one big result
+can't push out everything else. Each lookup applies the time to live
+of the connection that's asking.
+*/
+class ResultCache {
+  private:
+    struct Entry {
+        StaticResult result;
+        size_t byteSize;
+        std::chrono::steady_clock::time_point storedAt;
+        std::list<std::string>::iterator recencyPosition;
+    };
+
+    std::mutex mutex;
+    size_t maxBytes   = 0;
+    size_t totalBytes = 0;
+    std::map<std::string, Entry> entries;
+    // Keys from most to least recently used.
+    std::list<std::string> recency;
+    ResultCacheCounters counters;
+    // When each disk directory was last swept for expired files.
+    std::map<std::string, std::chrono::steady_clock::time_point> lastPruned;
+
+    void insert(const std::string& key, StaticResult result, size_t byteSize);
+    void erase(std::map<std::string, Entry>::iterator entry);
+    // Whether it's time to sweep the directory again. If so, the sweep
+    // is counted as done, so only one caller makes it.
+    bool isDiskPruneDue(const std::string& directory);
+
+  public:
+    void reserve(size_t maxBytes);
+    size_t getEntryByteLimit();
+    bool lookup(const std::string& key,
+                const ResultCacheSettings& settings,
+                StaticResult& result);
+    void store(const std::string& key,
+               const ResultCacheSettings& settings,
+               StaticResult result,
+               size_t byteSize);
+    void clear();
+    ResultCacheCounters getCounters();
+};
+
+// The process wide result cache.
+ResultCache& getResultCache();
@@ -0,0 +1,338 @@
+#include "resultPage.hpp"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "responseBuffers.hpp"
+
+static inline bool isJsonWhitespace(char c) {
+  return c == ' ' or c == '\n' or c == '\r' or c == '\t';
+}
+
+static inline size_t skipWhitespace(std::string_view text, size_t pos) {
+  while (pos < text.size() and isJsonWhitespace(text[pos])) {
+    pos++;
+  }
+  return pos;
+}
+
+static inline void expectChar(std::string_view text, size_t pos, char c) {
+  if (pos >= text.size() or text[pos] != c) {
+    throw std::invalid_argument("Malformed JSON in Trino response at offset " +
+                                std::to_string(pos));
+  }
+}
+
+// Skip a string starting at its opening quote. Returns the position
+// just past the closing quote.
+static size_t skipString(std::string_view text, size_t pos) {
+  pos++;
+  while (pos < text.size()) {
+    const char* found = static_cast<const char*>(
+        std::memchr(text.data() + pos, '"', text.size() - pos));
+    if (not found) {
+      break;
+    }
+    size_t quote = found - text.data();
+    // The quote is escaped if an odd number of backslashes precede it.
+    size_t backslashes = 0;
+    while (quote - backslashes > pos and
+           text[quote - backslashes - 1] == '\\') {
+      backslashes++;
+    }
+    if (backslashes % 2 == 0) {
+      return quote + 1;
+    }
+    pos = quote + 1;
+  }
+  throw std::invalid_argument("Unterminated string in Trino response");
+}
+
+/*
+Skip one JSON value of any type without decoding it. Nested arrays
+and objects, which is how Trino sends array, map and row values, are
+skipped by tracking depth. Returns the position just past the value.
+*/
+static size_t skipValue(std::string_view text, size_t pos) {
+  if (pos >= text.size()) {
+    throw std::invalid_argument("Unexpected end of Trino response");
+  }
+  char first = text[pos];
+  if (first == '"') {
+    return skipString(text, pos);
+  }
+  if (first == '[' or first == '{') {
+    int depth = 0;
+    while (pos < text.size()) {
+      char c = text[pos];
+      if (c == '"') {
+        pos = skipString(text, pos);
+        continue;
+      }
+      if (c == '[' or c == '{') {
+        depth++;
+      } else if (c == ']' or c == '}') {
+        depth--;
+        if (depth == 0) {
+          return pos + 1;
+        }
+      }
+      pos++;
+    }
+    throw std::invalid_argument("Unterminated array or object in response");
+  }
+  // Numbers and the literals true, false and null.
+  size_t start = pos;
+  while (pos < text.size() and text[pos] != ',' and text[pos] != ']' and
+         text[pos] != '}' and not isJsonWhitespace(text[pos])) {
+    pos++;
+  }
+  if (pos == start) {
+    throw std::invalid_argument("Malformed JSON in Trino response at offset " +
+                                std::to_string(pos));
+  }
+  return pos;
+}
+
+size_t scanRows(std::string_view text,
+                size_t pos,
+                size_t columnCount,
+                RowSpans& rows) {
+  if (text.size() > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument("Trino response page is too large");
+  }
+  rows.columnCount = columnCount;
+  pos              = skipWhitespace(text, pos);
+  expectChar(text, pos, '[');
+  pos = skipWhitespace(text, pos + 1);
+  while (pos < text.size() and text[pos] != ']') {
+    expectChar(text, pos, '[');
+    pos               = skipWhitespace(text, pos + 1);
+    size_t cellsInRow = 0;
+    while (pos < text.size() and text[pos] != ']') {
+      size_t cellEnd = skipValue(text, pos);
+      rows.cells.push_back({static_cast<uint32_t>(pos),
+                            static_cast<uint32_t>(cellEnd - pos)});
+      cellsInRow++;
+      pos = skipWhitespace(text, cellEnd);
+      if (pos < text.size() and text[pos] == ',') {
+        pos = skipWhitespace(text, pos + 1);
+      }
+    }
+    expectChar(text, pos, ']');
+    if (rows.columnCount == 0 and rows.rowCount == 0) {
+      rows.columnCount = cellsInRow;
+    }
+    if (cellsInRow != rows.columnCount) {
+      throw std::invalid_argument(
+          "Row has " + std::to_string(cellsInRow) + " values but " +
+          std::to_string(rows.columnCount) + " columns were described");
+    }
+    rows.rowCount++;
+    pos = skipWhitespace(text, pos + 1);
+    if (pos < text.size() and text[pos] == ',') {
+      pos = skipWhitespace(text, pos + 1);
+    }
+  }
+  expectChar(text, pos, ']');
+  return pos + 1;
+}
+
+ResponseParts splitResponse(std::string_view text, size_t columnCount) {
+  ResponseParts parts;
+  size_t pos = skipWhitespace(text, 0);
+  expectChar(text, pos, '{');
+  pos = skipWhitespace(text, pos + 1);
+  if (pos < text.size() and text[pos] == '}') {
+    return parts;
+  }
+  while (pos < text.size()) {
+    expectChar(text, pos, '"');
+    size_t keyEnd = skipString(text, pos);
+    // Trino's keys never contain escapes, so they're taken as raw text.
+    std::string key(text.substr(pos + 1, keyEnd - pos - 2));
+    pos = skipWhitespace(text, keyEnd);
+    expectChar(text, pos, ':');
+    pos             = skipWhitespace(text, pos + 1);
+    size_t valueEnd = 0;
+    if (key == "data" and pos < text.size() and text[pos] == '[') {
+      if (parts.envelope.contains("columns")) {
+        columnCount = parts.envelope["columns"].size();
+      }
+      valueEnd      = scanRows(text, pos, columnCount, parts.rows);
+      parts.hasRows = true;
+    } else {
+      valueEnd            = skipValue(text, pos);
+      parts.envelope[key] =
+          json::parse(text.data() + pos, text.data() + valueEnd);
+    }
+    pos = skipWhitespace(text, valueEnd);
+    if (pos < text.size() and text[pos] == ',') {
+      pos = skipWhitespace(text, pos + 1);
+    } else {
+      break;
+    }
+  }
+  return parts;
+}
+
+ResultPage::ResultPage(std::string&& text, RowSpans&& rows) {
+  this->text        = std::move(text);
+  this->columnCount = rows.columnCount;
+  this->rowCount    = rows.rowCount;
+  this->cellSpans   = std::move(rows.cells);
+  this->cells.resize(this->cellSpans.size());
+  this->decoded.resize(this->cellSpans.size(), false);
+}
+
+ResultPage::~ResultPage() {
+  getResponseBufferPool().give(std::move(this->text));
+}
+
+ResultPage::ResultPage(const json& rows) {
+  if (not rows.empty()) {
+    this->columnCount = rows[0].size();
+  }
+  this->rowCount = rows.size();
+  this->cells.reserve(this->rowCount * this->columnCount);
+  for (const json& row : rows) {
+    if (row.size() != this->columnCount) {
+      throw std::invalid_argument(
+          "Row has " + std::to_string(row.size()) + " values but " +
+          std::to_string(this->columnCount) + " were expected");
+    }
+    for (const json& cell : row) {
+      this->cells.push_back(cell);
+    }
+  }
+  this->decoded.resize(this->cells.size(), true);
+}
+
+size_t ResultPage::getRowCount() const {
+  return this->rowCount;
+}
+
+size_t ResultPage::getColumnCount() const {
+  return this->columnCount;
+}
+
+size_t ResultPage::getByteSize() const {
+  if (this->spillFile) {
+    return 0;
+  }
+  return this->text.size() + this->cellSpans.size() * sizeof(CellSpan) +
+         this->cells.size() * sizeof(json);
+}
+
+/*
+The spans of a spilled page are read straight from its view. Records
+start wherever the previous one ended, so they're copied out rather
+than read in place, which might not be aligned.
+*/
+CellSpan ResultPage::getSpan(size_t index) const {
+  if (not this->spillView) {
+    return this->cellSpans[index];
+  }
+  CellSpan span;
+  std::memcpy(&span,
+              this->spillView->data() + index * sizeof(CellSpan),
+              sizeof(CellSpan));
+  return span;
+}
+
+const char* ResultPage::getText() const {
+  if (not this->spillView) {
+    return this->text.data();
+  }
+  return this->spillView->data() + this->decoded.size() * sizeof(CellSpan);
+}
+
+void ResultPage::mapSpilled() {
+  this->spillView = this->spillFile->map(this->spillOffset, this->spillLength);
+  if (not this->spillView) {
+    throw std::runtime_error("Rows spilled to disk could not be read back");
+  }
+  this->cells.resize(this->decoded.size());
+}
+
+const json& ResultPage::getCell(size_t row, size_t column) {
+  size_t index = row * this->columnCount + column;
+  if (not this->decoded[index]) {
+    if (this->spillFile and not this->spillView) {
+      this->mapSpilled();
+    }
+    CellSpan span        = this->getSpan(index);
+    const char* begin    = this->getText() + span.offset;
+    this->cells[index]   = json::parse(begin, begin + span.length);
+    this->decoded[index] = true;
+  }
+  return this->cells[index];
+}
+
+void ResultPage::decodeColumn(size_t column) {
+  if (column >= this->columnCount) {
+    return;
+  }
+  for (size_t row = 0; row < this->rowCount; row++) {
+    this->getCell(row, column);
+  }
+}
+
+bool ResultPage::spill(const std::shared_ptr<SpillFile>& file) {
+  if (this->spillFile or this->cellSpans.empty()) {
+    return false;
+  }
+  size_t spansLength = this->cellSpans.size() * sizeof(CellSpan);
+  size_t textLength  = 0;
+  for (const CellSpan& span : this->cellSpans) {
+    textLength += span.length;
+  }
+  // The spans, then the text of each cell with nothing in between.
+  std::string record;
+  record.reserve(spansLength + textLength);
+  record.resize(spansLength);
+  uint32_t offset = 0;
+  for (size_t i = 0; i < this->cellSpans.size(); i++) {
+    const CellSpan& span = this->cellSpans[i];
+    CellSpan packed      = {offset, span.length};
+    std::memcpy(record.data() + i * sizeof(CellSpan), &packed, sizeof(packed));
+    record.append(this->text, span.offset, span.length);
+    offset += span.length;
+  }
+
+  uint64_t fileOffset = 0;
+  if (not file->append(record, fileOffset)) {
+    return false;
+  }
+  this->spillFile   = file;
+  this->spillOffset = fileOffset;
+  this->spillLength = record.size();
+  // Swapping with empty containers gives their memory back, which
+  // clear would not.
+  getResponseBufferPool().give(std::exchange(this->text, std::string()));
+  std::vector<CellSpan>().swap(this->cellSpans);
+  std::vector<json>().swap(this->cells);
+  this->decoded.assign(this->decoded.size(), false);
+  return true;
+}
+
+bool ResultPage::isSpilled() const {
+  return this->spillFile != nullptr;
+}
+
+void ResultPage::prefetch() {
+  if (this->spillFile and not this->spillView) {
+    this->mapSpilled();
+    this->spillView->prefetch();
+  }
+}
+
+void ResultPage::unmap() {
+  if (this->spillView) {
+    this->spillView.reset();
+    std::vector<json>().swap(this->cells);
+    this->decoded.assign(this->decoded.size(), false);
+  }
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "spillFile.hpp"
+
+using json = nlohmann::json;
+
+// Where a cell's value sits in a page's text.
+struct CellSpan {
+    uint32_t offset;
+    uint32_t length;
+};
+
+// The rows of a "data" array, as found by scanRows.
+struct RowSpans {
+    std::vector<CellSpan> cells;
+    size_t rowCount    = 0;
+    size_t columnCount = 0;
+};
+
+/*
+Find the cells of the array of rows at pos in text, without parsing
+any of them. If columnCount is zero, it's taken from the first row.
+Returns the position just past the array. Throws std::invalid_argument
+if the rows are malformed or ragged, or the text is too large for a
+page.
+*/
+size_t scanRows(std::string_view text,
+                size_t pos,
+                size_t columnCount,
+                RowSpans& rows);
+
+/*
+A Trino response, taken apart in one pass over its text. Every member
+but "data" is parsed into envelope, which is small. The rows in "data"
+are only scanned, for a ResultPage to take over along with the text. A
+spooled result's "data", which lists segments instead of rows, is
+parsed into envelope like the other members.
+*/
+struct ResponseParts {
+    json envelope = json::object();
+    bool hasRows  = false;
+    RowSpans rows;
+};
+
+/*
+Take a response apart. columnCount is the number of columns known from
+earlier responses, and a "columns" member ahead of the rows replaces
+it. Throws std::invalid_argument if the text isn't a JSON object or its
+rows are malformed, and json::parse_error if another member is.
+*/
+ResponseParts splitResponse(std::string_view text, size_t columnCount);
+
+/*
+One page of result rows.
+
+Parsing every cell of every row up front wastes time and memory when
+the application only reads a few of a wide table's columns. A page
+keeps the raw response text and the byte range of each cell instead,
+and only parses a cell into json the first time something reads it.
+Columns the application is known to use can be decoded eagerly with
+decodeColumn.
+
+A page that came from response text can also be spilled to disk when
+too many rows are buffered. Its cells are then written out back to
+back, after their spans, and read through a mapped view once
+something reads the page again.
+*/
+class ResultPage {
+  private:
+    std::string text;
+    size_t columnCount = 0;
+    size_t rowCount    = 0;
+    std::vector<CellSpan> cellSpans;
+    std::vector<json> cells;
+    std::vector<bool> decoded;
+    // Where the page went if it was spilled, and its mapped view once
+    // it's being read again.
+    std::shared_ptr<SpillFile> spillFile;
+    uint64_t spillOffset = 0;
+    size_t spillLength   = 0;
+    std::unique_ptr<SpillView> spillView;
+
+    CellSpan getSpan(size_t index) const;
+    const char* getText() const;
+    void mapSpilled();
+
+  public:
+    // Take ownership of a response's text and the rows scanRows found
+    // in it.
+    ResultPage(std::string&& text, RowSpans&& rows);
+    /*
+    Build a page from rows the driver already has as json, like results
+    it makes up itself. Every cell starts out decoded, so the page never
+    changes after construction and can be shared between queries.
+    Throws std::invalid_argument if the rows are ragged.
+    */
+    explicit ResultPage(const json& rows);
+    // The response text goes back to the pool for another response.
+    ~ResultPage();
+    ResultPage(ResultPage&&)            = default;
+    ResultPage& operator=(ResultPage&&) = default;
+    size_t getRowCount() const;
+    size_t getColumnCount() const;
+    // Roughly how much memory the page holds on to. A spilled page
+    // counts as nothing, since the system can page out what it maps.
+    size_t getByteSize() const;
+    const json& getCell(size_t row, size_t column);
+    void decodeColumn(size_t column);
+    /*
+    Write the page's cells to the end of the file and let go of them in
+    memory. Returns false if the page has no response text to spill,
+    was spilled already, or the write failed, in which case the page
+    is left as it was.
+    */
+    bool spill(const std::shared_ptr<SpillFile>& file);
+    bool isSpilled() const;
+    // Map a spilled page ahead of reading it, and start reading it in.
+    void prefetch();
+    // Let go of a spilled page's view and the cells decoded from it.
+    void unmap();
+};
+
+/*
+A complete result set that isn't read from a running query, like the
+type information SQLGetTypeInfo returns or a cached result. It is
+attached to a query as is, without a trip through response text. Its
+pages are fully decoded, so they can be shared between queries.
+*/
+struct StaticResult {
+    std::vector<json> columns;
+    std::vector<std::shared_ptr<ResultPage>> pages;
+};
@@ -0,0 +1,137 @@
+#include "spillFile.hpp"
+
+#include <algorithm>
+
+#include "../util/writeLog.hpp"
+
+// Mapped views have to start on a multiple of this.
+static uint64_t getAllocationGranularity() {
+  static const uint64_t granularity = []() {
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    return static_cast<uint64_t>(systemInfo.dwAllocationGranularity);
+  }();
+  return granularity;
+}
+
+SpillView::SpillView(void* base, const char* bytes, size_t length) {
+  this->base   = base;
+  this->bytes  = bytes;
+  this->length = length;
+}
+
+SpillView::~SpillView() {
+  UnmapViewOfFile(this->base);
+}
+
+const char* SpillView::data() const {
+  return this->bytes;
+}
+
+size_t SpillView::size() const {
+  return this->length;
+}
+
+void SpillView::prefetch() const {
+  WIN32_MEMORY_RANGE_ENTRY range;
+  range.VirtualAddress = const_cast<char*>(this->bytes);
+  range.NumberOfBytes  = this->length;
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+std::shared_ptr<SpillFile> SpillFile::create() {
+  wchar_t directory[MAX_PATH + 1];
+  wchar_t path[MAX_PATH + 1];
+  if (GetTempPathW(MAX_PATH + 1, directory) == 0 or
+      GetTempFileNameW(directory, L"tro", 0, path) == 0) {
+    WriteLog(LL_WARN, "  Could not name a temporary file to spill rows to");
+    return nullptr;
+  }
+  // The file is only ever read through this handle, so nothing else
+  // may open it, and the system removes it once the handle is closed.
+  HANDLE file =
+      CreateFileW(path,
+                  GENERIC_READ | GENERIC_WRITE,
+                  0,
+                  nullptr,
+                  CREATE_ALWAYS,
+                  FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+                  nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    WriteLog(LL_WARN,
+             "  Could not create a temporary file to spill rows to: " +
+                 std::to_string(GetLastError()));
+    return nullptr;
+  }
+  std::shared_ptr<SpillFile> spillFile = std::make_shared<SpillFile>();
+  spillFile->file                      = file;
+  return spillFile;
+}
+
+SpillFile::~SpillFile() {
+  if (this->file != INVALID_HANDLE_VALUE) {
+    CloseHandle(this->file);
+  }
+}
+
+bool SpillFile::append(const std::string& record, uint64_t& offset) {
+  // Nothing but appends moves the file pointer, so it's always at the
+  // end. WriteFile takes at most a DWORD worth of bytes at a time.
+  size_t written = 0;
+  while (written < record.size()) {
+    DWORD chunk = static_cast<DWORD>(
+        std::min<size_t>(record.size() - written, 0x40000000));
+    DWORD chunkWritten = 0;
+    if (not WriteFile(this->file,
+                      record.data() + written,
+                      chunk,
+                      &chunkWritten,
+                      nullptr)) {
+      WriteLog(LL_WARN,
+               "  Could not spill rows to disk: " +
+                   std::to_string(GetLastError()));
+      // Put the file pointer back, so a partial record is overwritten.
+      LARGE_INTEGER end;
+      end.QuadPart = static_cast<LONGLONG>(this->size);
+      SetFilePointerEx(this->file, end, nullptr, FILE_BEGIN);
+      return false;
+    }
+    written += chunkWritten;
+  }
+  offset = this->size;
+  this->size += record.size();
+  return true;
+}
+
+std::unique_ptr<SpillView> SpillFile::map(uint64_t offset, size_t length) {
+  if (offset + length > this->size) {
+    return nullptr;
+  }
+  // A mapping of size zero covers the file as it is now. It can be
+  // closed right away, since the view keeps it alive.
+  HANDLE mapping =
+      CreateFileMappingW(this->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    WriteLog(LL_ERROR,
+             "  ERROR: Could not map spilled rows: " +
+                 std::to_string(GetLastError()));
+    return nullptr;
+  }
+  uint64_t viewStart = offset - offset % getAllocationGranularity();
+  size_t lead        = static_cast<size_t>(offset - viewStart);
+
+  void* base = MapViewOfFile(mapping,
+                             FILE_MAP_READ,
+                             static_cast<DWORD>(viewStart >> 32),
+                             static_cast<DWORD>(viewStart & 0xFFFFFFFF),
+                             lead + length);
+  CloseHandle(mapping);
+  if (base == nullptr) {
+    WriteLog(LL_ERROR,
+             "  ERROR: Could not map spilled rows: " +
+                 std::to_string(GetLastError()));
+    return nullptr;
+  }
+  return std::make_unique<SpillView>(
+      base, static_cast<const char*>(base) + lead, length);
+}
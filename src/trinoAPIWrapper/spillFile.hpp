@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "../util/windowsLean.hpp"
+
+/*
+How much memory buffered result pages may hold before the oldest
+unread ones are written to disk. Zero means there is no limit. The
+connection limit covers every statement on the connection.
+
+A statement reading in order pauses instead of spilling, but Trino
+abandons a query its client hasn't polled for query.client.timeout,
+five minutes by default. After pauseLimit the query is polled again
+anyway, and what doesn't fit is spilled.
+*/
+struct SpillSettings {
+    size_t statementBufferLimit     = 0;
+    size_t connectionBufferLimit    = 0;
+    std::chrono::seconds pauseLimit = std::chrono::seconds(120);
+};
+
+/*
+A read-only view of part of a SpillFile, mapped into memory. The
+operating system pages it in as it's read and can drop it again under
+memory pressure, so a mapped page doesn't count against any budget.
+*/
+class SpillView {
+  private:
+    void* base;
+    const char* bytes;
+    size_t length;
+
+  public:
+    SpillView(void* base, const char* bytes, size_t length);
+    ~SpillView();
+    SpillView(const SpillView&)            = delete;
+    SpillView& operator=(const SpillView&) = delete;
+    const char* data() const;
+    size_t size() const;
+    // Ask the operating system to start reading the view in.
+    void prefetch() const;
+};
+
+/*
+A temporary file result pages are spilled to. It is only ever
+appended to, and is deleted when the last reference to it goes away,
+even if the process doesn't exit cleanly.
+*/
+class SpillFile {
+  private:
+    HANDLE file   = INVALID_HANDLE_VALUE;
+    uint64_t size = 0;
+
+  public:
+    // Returns nullptr if no temporary file could be created.
+    static std::shared_ptr<SpillFile> create();
+    ~SpillFile();
+    SpillFile()                            = default;
+    SpillFile(const SpillFile&)            = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+    // Write a record to the end of the file, returning where it starts.
+    bool append(const std::string& record, uint64_t& offset);
+    // Returns nullptr if the range can't be mapped.
+    std::unique_ptr<SpillView> map(uint64_t offset, size_t length);
+};
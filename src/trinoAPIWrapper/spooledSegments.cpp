@@ -0,0 +1,324 @@
+#include "spooledSegments.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <exception>
+#include <lz4.h>
+#include <stdexcept>
+#include <string>
+
+#include "../util/b64decoder.hpp"
+
+const std::string DEFAULT_SPOOLING_ENCODING = "json+zstd,json+lz4,json";
+
+static size_t
+curlWriteCallback(void* contents, size_t size, size_t nmemb, std::string* s) {
+  size_t totalSize = size * nmemb;
+  s->append(static_cast<char*>(contents), totalSize);
+  return totalSize;
+}
+
+/*
+What a segment download writes to. Exceptions can't pass through curl,
+so a decoding failure is kept until the transfer ends, and taking none
+of the bytes stops the transfer.
+*/
+struct SegmentTransfer {
+    SegmentDecoder* decoder;
+    std::exception_ptr failure;
+};
+
+static size_t segmentWriteCallback(void* contents,
+                                   size_t size,
+                                   size_t nmemb,
+                                   SegmentTransfer* transfer) {
+  try {
+    transfer->decoder->write(static_cast<char*>(contents), size * nmemb);
+  } catch (const std::exception&) {
+    transfer->failure = std::current_exception();
+    return 0;
+  }
+  return size * nmemb;
+}
+
+std::vector<SpooledSegment> parseSpooledData(const json& data) {
+  std::string encoding = data.value("encoding", "");
+  SegmentCompression compression;
+  if (encoding == "json") {
+    compression = SC_NONE;
+  } else if (encoding == "json+zstd") {
+    compression = SC_ZSTD;
+  } else if (encoding == "json+lz4") {
+    compression = SC_LZ4;
+  } else {
+    throw std::invalid_argument("Unsupported result encoding: " + encoding);
+  }
+  std::vector<SpooledSegment> segments;
+  for (const json& item : data.value("segments", json::array())) {
+    SpooledSegment segment;
+    std::string type = item.value("type", "");
+    // Segments too small to be worth compressing are sent as is, and
+    // only compressed ones say how large they were.
+    json metadata = item.value("metadata", json::object());
+    if (compression != SC_NONE and metadata.contains("uncompressedSize")) {
+      segment.compression      = compression;
+      segment.uncompressedSize = metadata["uncompressedSize"].get<size_t>();
+      segment.expectedSize     = segment.uncompressedSize;
+    } else if (metadata.contains("segmentSize")) {
+      segment.expectedSize = metadata["segmentSize"].get<size_t>();
+    }
+    if (type == "inline") {
+      std::string encoded = item.value("data", "");
+      segment.isInline    = true;
+      segment.data.resize(base64DecodedSize(encoded));
+      decodeBase64Range(encoded,
+                        0,
+                        reinterpret_cast<unsigned char*>(segment.data.data()),
+                        segment.data.size());
+    } else if (type == "spooled") {
+      segment.uri    = item.value("uri", "");
+      segment.ackUri = item.value("ackUri", "");
+      if (segment.uri.empty()) {
+        throw std::invalid_argument("Spooled segment has no uri");
+      }
+      // Each header can have several values.
+      json headers = item.value("headers", json::object());
+      for (const auto& [name, values] : headers.items()) {
+        for (const json& value : values) {
+          segment.headers.push_back(name + ": " + value.get<std::string>());
+        }
+      }
+    } else {
+      throw std::invalid_argument("Unknown result segment type: " + type);
+    }
+    segments.push_back(std::move(segment));
+  }
+  return segments;
+}
+
+static std::runtime_error segmentTooLarge(size_t sizeLimit) {
+  return std::runtime_error("Result segment is larger than the limit of " +
+                            std::to_string(sizeLimit) + " bytes");
+}
+
+SegmentDecoder::SegmentDecoder(SegmentCompression compression,
+                               size_t uncompressedSize,
+                               size_t sizeLimit) {
+  if (uncompressedSize > sizeLimit) {
+    throw segmentTooLarge(sizeLimit);
+  }
+  this->compression = compression;
+  this->sizeLimit   = sizeLimit;
+  this->rows.resize(uncompressedSize);
+  if (compression == SC_ZSTD) {
+    this->zstdStream = ZSTD_createDStream();
+    ZSTD_initDStream(this->zstdStream);
+  }
+}
+
+SegmentDecoder::~SegmentDecoder() {
+  ZSTD_freeDStream(this->zstdStream);
+}
+
+void SegmentDecoder::write(const char* bytes, size_t length) {
+  switch (this->compression) {
+    case SC_NONE: {
+      if (length > this->sizeLimit - this->rowsLength) {
+        throw segmentTooLarge(this->sizeLimit);
+      }
+      this->rows.resize(this->rowsLength);
+      this->rows.append(bytes, length);
+      this->rowsLength = this->rows.size();
+      break;
+    }
+    case SC_ZSTD: {
+      ZSTD_inBuffer in = {bytes, length, 0};
+      while (in.pos < in.size) {
+        // The size the server gave should be exact, but don't trust it.
+        if (this->rowsLength == this->rows.size()) {
+          if (this->rows.size() >= this->sizeLimit) {
+            throw segmentTooLarge(this->sizeLimit);
+          }
+          this->rows.resize(std::min(
+              std::max<size_t>(this->rows.size() * 2, 4096), this->sizeLimit));
+        }
+        ZSTD_outBuffer out = {
+            this->rows.data(), this->rows.size(), this->rowsLength};
+        size_t result = ZSTD_decompressStream(this->zstdStream, &out, &in);
+        if (ZSTD_isError(result)) {
+          throw std::runtime_error("Could not decompress result segment: " +
+                                   std::string(ZSTD_getErrorName(result)));
+        }
+        this->rowsLength = out.pos;
+        this->frameEnded = result == 0;
+      }
+      break;
+    }
+    case SC_LZ4: {
+      // Nothing that decompresses into the rows is larger than this.
+      size_t bound = static_cast<size_t>(LZ4_COMPRESSBOUND(this->rows.size()));
+      if (length > bound - std::min(this->compressed.size(), bound)) {
+        throw std::runtime_error("Result segment is larger than it said");
+      }
+      this->compressed.append(bytes, length);
+      break;
+    }
+  }
+}
+
+std::string SegmentDecoder::finish() {
+  if (this->compression == SC_ZSTD and not this->frameEnded) {
+    throw std::runtime_error("Result segment ended early");
+  }
+  if (this->compression == SC_LZ4) {
+    if (this->compressed.size() > INT_MAX or this->rows.size() > INT_MAX) {
+      throw std::runtime_error("Result segment is too large to decompress");
+    }
+    int decompressed =
+        LZ4_decompress_safe(this->compressed.data(),
+                            this->rows.data(),
+                            static_cast<int>(this->compressed.size()),
+                            static_cast<int>(this->rows.size()));
+    if (decompressed < 0 or
+        static_cast<size_t>(decompressed) != this->rows.size()) {
+      throw std::runtime_error("Could not decompress result segment");
+    }
+    this->rowsLength = this->rows.size();
+  }
+  this->rows.resize(this->rowsLength);
+  return std::move(this->rows);
+}
+
+std::string decodeSegment(const std::string& bytes,
+                          SegmentCompression compression,
+                          size_t uncompressedSize) {
+  SegmentDecoder decoder(compression, uncompressedSize);
+  decoder.write(bytes.data(), bytes.size());
+  return decoder.finish();
+}
+
+static std::string fetchSegment(CURL* curl, const SpooledSegment& segment) {
+  SegmentDecoder decoder(segment.compression, segment.uncompressedSize);
+  SegmentTransfer transfer = {&decoder, nullptr};
+  curl_slist* headers      = nullptr;
+  for (const std::string& header : segment.headers) {
+    headers = curl_slist_append(headers, header.c_str());
+  }
+  curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+  curl_easy_setopt(curl, CURLOPT_URL, segment.uri.c_str());
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, segmentWriteCallback);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer);
+  CURLcode res = curl_easy_perform(curl);
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, nullptr);
+  curl_slist_free_all(headers);
+
+  if (transfer.failure) {
+    std::rethrow_exception(transfer.failure);
+  }
+  if (res != CURLE_OK) {
+    throw std::runtime_error("Could not download result segment: " +
+                             std::string(curl_easy_strerror(res)));
+  }
+  // Storage that isn't reached over HTTP has no status to check.
+  long httpStatusCode = 0;
+  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpStatusCode);
+  if (httpStatusCode != 0 and httpStatusCode != 200) {
+    throw std::runtime_error("Unexpected status downloading result segment: " +
+                             std::to_string(httpStatusCode));
+  }
+  return decoder.finish();
+}
+
+/*
+Let storage know a segment can be deleted. Servers that give an
+ackUri expect a GET on it, older ones a DELETE on the segment itself.
+A failure is ignored, since storage expires segments nobody collects.
+*/
+static void acknowledgeSegment(CURL* curl, const SpooledSegment& segment) {
+  std::string ignored;
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlWriteCallback);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ignored);
+  if (not segment.ackUri.empty()) {
+    curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+    curl_easy_setopt(curl, CURLOPT_URL, segment.ackUri.c_str());
+    curl_easy_perform(curl);
+  } else {
+    curl_easy_setopt(curl, CURLOPT_URL, segment.uri.c_str());
+    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+    curl_easy_perform(curl);
+    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, nullptr);
+  }
+}
+
+SegmentDownloader::SegmentDownloader(size_t threadCount,
+                                     bool allowLocalFiles)
+    : allowLocalFiles(allowLocalFiles) {
+  for (size_t i = 0; i < threadCount; i++) {
+    this->workers.emplace_back(&SegmentDownloader::work, this);
+  }
+}
+
+SegmentDownloader::~SegmentDownloader() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+  this->wake.notify_all();
+  for (std::thread& worker : this->workers) {
+    worker.join();
+  }
+}
+
+void SegmentDownloader::work() {
+  CURL* curl = curl_easy_init();
+  curl_easy_setopt(curl, CURLOPT_SSL_OPTIONS, CURLSSLOPT_NATIVE_CA);
+  // The same stall guard as requests to the coordinator.
+  curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+  curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, 60L);
+  // A server, or a redirect from storage, mustn't be able to point the
+  // driver at a local file or any other scheme curl happens to know.
+  const char* protocols = this->allowLocalFiles ? "http,https,file"
+                                                : "http,https";
+  curl_easy_setopt(curl, CURLOPT_PROTOCOLS_STR, protocols);
+  curl_easy_setopt(curl, CURLOPT_REDIR_PROTOCOLS_STR, "http,https");
+
+  while (true) {
+    std::function<void(CURL*)> task;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->wake.wait(
+          lock, [this]() { return this->stopping or not this->tasks.empty(); });
+      if (this->tasks.empty()) {
+        break;
+      }
+      task = std::move(this->tasks.front());
+      this->tasks.pop_front();
+    }
+    task(curl);
+  }
+  curl_easy_cleanup(curl);
+}
+
+std::future<std::string>
+SegmentDownloader::download(const SpooledSegment& segment,
+                            std::shared_ptr<std::atomic<bool>> abandoned) {
+  // std::function has to be copyable, so the promise is shared.
+  auto rows = std::make_shared<std::promise<std::string>>();
+  std::future<std::string> future = rows->get_future();
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->tasks.push_back([segment, abandoned, rows](CURL* curl) {
+      if (not abandoned->load()) {
+        try {
+          rows->set_value(fetchSegment(curl, segment));
+        } catch (const std::exception&) {
+          rows->set_exception(std::current_exception());
+        }
+      }
+      acknowledgeSegment(curl, segment);
+    });
+  }
+  this->wake.notify_one();
+  return future;
+}
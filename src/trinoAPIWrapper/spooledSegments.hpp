@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <curl/curl.h>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zstd.h>
+
+using json = nlohmann::json;
+
+// The encodings asked for when the DSN doesn't say, best first.
+extern const std::string DEFAULT_SPOOLING_ENCODING;
+
+/*
+The largest segment the driver decodes. Trino cuts results into
+segments of 16MB at most by default, so a segment anywhere near this
+means a misbehaving server, and the size it claims isn't allocated on
+trust.
+*/
+constexpr size_t MAX_SEGMENT_SIZE = 256 * 1024 * 1024;
+
+enum SegmentCompression {
+  SC_NONE,
+  SC_ZSTD,
+  SC_LZ4,
+};
+
+/*
+One segment of a result sent with Trino's spooling protocol. Small
+segments come inline in the response. The rest are left in storage
+for the client to download from uri, sending the headers given with
+it, and to acknowledge once it has them so storage can delete them.
+Either way, a segment's data is a JSON array of rows, compressed if
+the result's encoding calls for it and the segment was large enough
+for the server to bother.
+*/
+struct SpooledSegment {
+    bool isInline = false;
+    // The rows of an inline segment, decoded from base64 but still
+    // compressed.
+    std::string data;
+    std::string uri;
+    std::string ackUri;
+    std::vector<std::string> headers;
+    SegmentCompression compression = SC_NONE;
+    size_t uncompressedSize        = 0;
+    // How large the rows are, as far as the server said, so memory can
+    // be set aside for them before they arrive. Zero if it didn't say.
+    size_t expectedSize = 0;
+};
+
+/*
+Parse the "data" member of a response to a spooled query, which holds
+the encoding and a list of segments instead of the rows themselves.
+Throws std::invalid_argument if the encoding isn't supported or a
+segment isn't understood.
+*/
+std::vector<SpooledSegment> parseSpooledData(const json& data);
+
+/*
+Turns a segment's bytes into its rows as they arrive, so a zstd
+segment is decompressed while it downloads rather than after, and
+its compressed form is never held in full. An lz4 segment is a single
+block, which can only be decompressed once all of it is there. The
+rows are written straight into the buffer the result page keeps, and
+never grow past sizeLimit.
+*/
+class SegmentDecoder {
+  private:
+    SegmentCompression compression;
+    std::string rows;
+    size_t rowsLength = 0;
+    size_t sizeLimit  = 0;
+    std::string compressed;
+    ZSTD_DStream* zstdStream = nullptr;
+    bool frameEnded          = false;
+
+  public:
+    // Throws std::runtime_error if uncompressedSize is over sizeLimit.
+    SegmentDecoder(SegmentCompression compression,
+                   size_t uncompressedSize,
+                   size_t sizeLimit = MAX_SEGMENT_SIZE);
+    ~SegmentDecoder();
+    SegmentDecoder(const SegmentDecoder&)            = delete;
+    SegmentDecoder& operator=(const SegmentDecoder&) = delete;
+    // Throws std::runtime_error if the bytes can't be decompressed, or
+    // the rows would grow past sizeLimit.
+    void write(const char* bytes, size_t length);
+    // Returns the rows. Throws std::runtime_error if the segment ended
+    // early.
+    std::string finish();
+};
+
+// Decode a whole segment at once, like an inline one.
+std::string decodeSegment(const std::string& bytes,
+                          SegmentCompression compression,
+                          size_t uncompressedSize);
+
+/*
+Downloads spooled segments on a pool of worker threads, so a large
+result arrives as fast as storage can serve it rather than as fast as
+one connection to the coordinator goes. Each worker has its own curl
+handle, since a handle can't be used by two threads at once. Segment
+URIs come from the server, so only http and https are followed unless
+local files are allowed, which only tests do.
+*/
+class SegmentDownloader {
+  private:
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::function<void(CURL*)>> tasks;
+    std::vector<std::thread> workers;
+    bool stopping        = false;
+    bool allowLocalFiles = false;
+    void work();
+
+  public:
+    explicit SegmentDownloader(size_t threadCount,
+                               bool allowLocalFiles = false);
+    // Finishes queued acknowledgements before the workers stop.
+    ~SegmentDownloader();
+    SegmentDownloader(const SegmentDownloader&)            = delete;
+    SegmentDownloader& operator=(const SegmentDownloader&) = delete;
+    /*
+    Queue a segment to be downloaded and then acknowledged. The future
+    holds the segment's rows, or the reason they couldn't be read. If
+    abandoned is set by the time a worker gets to the segment, it's
+    only acknowledged, and the future is left without a value.
+    */
+    std::future<std::string>
+    download(const SpooledSegment& segment,
+             std::shared_ptr<std::atomic<bool>> abandoned);
+};
@@ -3,3 +3,9 @@
 AuthError::AuthError(std::string& message) : std::runtime_error(message) {};
 
 AuthError::AuthError(const char* message) : std::runtime_error(message) {};
+
+TimeoutError::TimeoutError(const std::string& message)
+    : std::runtime_error(message) {};
+
+CanceledError::CanceledError(const std::string& message)
+    : std::runtime_error(message) {};
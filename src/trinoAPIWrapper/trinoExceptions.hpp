@@ -8,3 +8,15 @@ class AuthError : public std::runtime_error {
     explicit AuthError(std::string& message);
     explicit AuthError(const char* message);
 };
+
+// A query ran out of the time SQL_ATTR_QUERY_TIMEOUT gave it.
+class TimeoutError : public std::runtime_error {
+  public:
+    explicit TimeoutError(const std::string& message);
+};
+
+// A query was canceled with SQLCancel from another thread.
+class CanceledError : public std::runtime_error {
+  public:
+    explicit CanceledError(const std::string& message);
+};
@@ -2,10 +2,11 @@
 #include <chrono>
 #include <curl/curl.h>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <ranges>
-#include <thread>
 
+#include "resultCache.hpp"
 #include "trinoExceptions.hpp"
 #include "trinoQuery.hpp"
 #include <stdexcept>
@@ -15,16 +16,26 @@
 #include "../util/writeLog.hpp"
 
 // How long should we poll between requests to Trino's nextUri?
-int API_POLL_INTERVAL_MS = 25;
+const int API_POLL_INTERVAL_MS = 25;
 
 UpdateStatus TrinoQuery::updateSelfFromResponse() {
   WriteLog(LL_TRACE, "  Entering TrinoQuery::updateSelfFromResponse");
-  json response_json = json::parse(this->connectionConfig->responseData);
+  /*
+  Everything except the row data is parsed as usual. The rows are only
+  scanned for where their cells are, in the same pass over the text,
+  and handed to a ResultPage, which only parses the cells that are
+  actually read.
+  */
+  std::string& responseData = this->connectionConfig->responseData;
+  ResponseParts response =
+      splitResponse(responseData, this->columnsJson.size());
+  json& response_json = response.envelope;
   WriteLog(LL_DEBUG, "  Response is Parsed");
   UpdateStatus updateStatus;
 
   if (response_json.contains("error")) {
-    this->error = true;
+    this->error        = true;
+    this->errorMessage = response_json["error"].value("message", "");
   }
 
   if (response_json.contains("queryId")) {
@@ -46,39 +57,34 @@ UpdateStatus TrinoQuery::updateSelfFromResponse() {
   if (response_json.contains("nextUri")) {
     this->nextUri = response_json["nextUri"];
   } else {
-    // This marks the point after which no more data will arrive,
-    // so the query is now completed.
-    this->completed = true;
+    // This marks the point after which the coordinator has nothing
+    // more to send, though spooled segments may still be on the way.
     this->nextUri.clear();
   }
+  this->publishCancelUri();
 
   if (response_json.contains("columns") and this->columnDescriptions.empty()) {
     WriteLog(LL_TRACE, "  Parsing column info from TrinoQuery data result");
-    this->columnsJson = response_json["columns"];
-    std::vector<ColumnDescription> columnDescriptions;
-    std::transform(this->columnsJson.begin(),
-                   this->columnsJson.end(),
-                   std::back_inserter(columnDescriptions),
-                   [](const json& json) { return ColumnDescription(json); });
-    this->columnDescriptions   = columnDescriptions;
+    this->setColumns(response_json["columns"]);
     updateStatus.gotColumnInfo = true;
-    for (std::function f : this->onColumnDataCallbacks) {
-      f(this);
-    }
   }
 
-  if (response_json.contains("data")) {
+  if (response.hasRows) {
     WriteLog(LL_TRACE, "  Adding data to TrinoQuery data result");
     updateStatus.gotRowData = true;
-    size_t existingRows     = this->dataJson.size();
-    size_t newRows          = response_json["data"].size();
-    // Optimization: pre-allocate enough room to hold all the
-    // rows of data up front, this avoids resizing over and
-    // over to hold an unknown quantity of rows.
-    this->dataJson.reserve(existingRows + newRows);
-    this->dataJson.insert(this->dataJson.end(),
-                          response_json["data"].begin(),
-                          response_json["data"].end());
+    // The page takes the response text over rather than copying it,
+    // and the next response goes into a buffer an earlier page is
+    // done with.
+    this->addResultPage(std::move(responseData), std::move(response.rows));
+    responseData = getResponseBufferPool().take();
+  } else if (response_json.contains("data") and
+             response_json["data"].is_object()) {
+    // A spooled result lists segments of rows rather than the rows.
+    WriteLog(LL_TRACE, "  Queueing spooled segments of TrinoQuery result");
+    this->queueSegments(parseSpooledData(response_json["data"]));
+  }
+  if (this->collectSegments(false).gotRowData) {
+    updateStatus.gotRowData = true;
   }
 
   // All "real" queries contain a state, but sideloaded
@@ -87,13 +93,320 @@ UpdateStatus TrinoQuery::updateSelfFromResponse() {
   if (response_json.contains("stats")) {
     if (response_json["stats"].contains("state")) {
       this->status = response_json["stats"]["state"];
+      if (this->status == "QUEUED" or
+          this->status == "WAITING_FOR_RESOURCES" or
+          this->status == "DISPATCHING") {
+        this->setState(QS_QUEUED);
+      } else if (this->status == "PLANNING" or this->status == "STARTING" or
+                 this->status == "RUNNING" or this->status == "FINISHING") {
+        this->setState(QS_RUNNING);
+      }
     }
   }
 
+  this->updateCompletion();
+
   WriteLog(LL_TRACE, "  Exiting TrinoQuery::updateSelfFromResponse");
   return updateStatus;
 }
 
+/*
+The query is complete once the coordinator has nothing more to send
+and every spooled segment has been read, or as soon as it fails.
+*/
+void TrinoQuery::updateCompletion() {
+  if (this->completed or not this->nextUri.empty()) {
+    return;
+  }
+  if (this->error) {
+    this->abandonSegments();
+  }
+  if (this->pendingSegments.empty()) {
+    this->completed = true;
+    this->setState(this->error ? QS_FAILED : QS_FINISHED);
+    if (not this->resultCacheKey.empty()) {
+      this->storeCapturedResult();
+    }
+  } else {
+    this->setState(QS_DRAINING);
+  }
+}
+
+/*
+Move the query on to another state. A query that has ended stays
+where it ended until it's reset, and a draining query doesn't go back
+to running because Trino still says it is.
+*/
+void TrinoQuery::setState(TrinoQueryState state) {
+  if (this->state == state or this->state == QS_FINISHED or
+      this->state == QS_FAILED or this->state == QS_CANCELED) {
+    return;
+  }
+  if (this->state == QS_DRAINING and state < QS_DRAINING) {
+    return;
+  }
+  WriteLog(LL_TRACE,
+           "  Query state " + std::to_string(this->state) + " -> " +
+               std::to_string(state));
+  this->state = state;
+}
+
+void TrinoQuery::addResultPage(std::string&& text, RowSpans&& rows) {
+  auto page = std::make_shared<ResultPage>(std::move(text), std::move(rows));
+  for (size_t i = 0; i < this->columnsInUse.size(); i++) {
+    if (this->columnsInUse[i]) {
+      page->decodeColumn(i);
+    }
+  }
+  this->addResidentBytes(page->getByteSize());
+  if (not this->resultCacheKey.empty()) {
+    this->capturedBytes += page->getByteSize();
+    if (this->capturedBytes > getResultCache().getEntryByteLimit()) {
+      WriteLog(LL_DEBUG, "  Result is too large to cache");
+      this->abandonCapturedResult();
+    } else {
+      this->capturedPages.push_back(page);
+    }
+  }
+  this->appendPage(std::move(page));
+  // A page that can wait for the application to catch up doesn't need
+  // to go to disk.
+  if (not this->ingestionPaused()) {
+    this->spillOverBudget();
+  }
+}
+
+void TrinoQuery::appendPage(std::shared_ptr<ResultPage> page) {
+  this->pageFirstRows.push_back(this->getCurrentRowCount());
+  this->bufferedRowCount += static_cast<int64_t>(page->getRowCount());
+  // Rows past maxRows stay in the page, but nothing can reach them.
+  if (this->maxRows > 0 and this->getCurrentRowCount() > this->maxRows) {
+    this->bufferedRowCount -= this->getCurrentRowCount() - this->maxRows;
+  }
+  this->resultPages.push_back(std::move(page));
+}
+
+void TrinoQuery::addResidentBytes(size_t byteSize) {
+  this->residentBytes += byteSize;
+  this->peakResidentBytes =
+      std::max(this->peakResidentBytes, this->residentBytes);
+  ConnectionConfig* config = this->connectionConfig;
+  size_t bufferedBytes     = (config->bufferedBytes += byteSize);
+  // Another statement may be raising the peak at the same time.
+  size_t peakBytes = config->peakBufferedBytes;
+  while (bufferedBytes > peakBytes and
+         not config->peakBufferedBytes.compare_exchange_weak(peakBytes,
+                                                             bufferedBytes)) {
+  }
+}
+
+void TrinoQuery::releaseResidentBytes(size_t byteSize) {
+  this->residentBytes -= byteSize;
+  this->connectionConfig->bufferedBytes -= byteSize;
+}
+
+bool TrinoQuery::overBudget() const {
+  const SpillSettings& settings = this->connectionConfig->spillSettings;
+  return (settings.statementBufferLimit > 0 and
+          this->residentBytes > settings.statementBufferLimit) or
+         (settings.connectionBufferLimit > 0 and
+          this->connectionConfig->bufferedBytes >
+              settings.connectionBufferLimit);
+}
+
+/*
+Whether the coordinator hasn't been polled for so long that Trino may
+give up on the query. Once it has nothing more to send, it doesn't
+need polling at all.
+*/
+bool TrinoQuery::pausedTooLong() const {
+  return this->pausedAt != std::chrono::steady_clock::time_point() and
+         not this->nextUri.empty() and
+         std::chrono::steady_clock::now() - this->pausedAt >=
+             this->connectionConfig->spillSettings.pauseLimit;
+}
+
+/*
+Rows read in order can wait on the server instead of piling up here.
+While the query is over budget and still has rows the application
+hasn't read, no more are asked for. Reading them checkpoints them,
+which frees their memory and lets the next poll carry on. A query with
+nothing left to read never pauses, so the application always gets
+rows, even when the connection's other statements hold the budget. A
+query paused for too long goes on and spills instead, so it's polled
+often enough for Trino to keep it.
+*/
+bool TrinoQuery::ingestionPaused() const {
+  return this->ingestionPausable and this->bufferedRowCount > 0 and
+         this->overBudget() and not this->pausedTooLong();
+}
+
+/*
+Spill buffered pages to disk until this query and its connection are
+back within their budgets. The newest pages are read last, so they go
+first. The front page is being read, and pages shared with the result
+cache would stay in memory anyway, so those are left alone.
+*/
+void TrinoQuery::spillOverBudget() {
+  for (size_t i = this->resultPages.size(); i > 1 and this->overBudget();
+       i--) {
+    std::shared_ptr<ResultPage>& page = this->resultPages[i - 1];
+    if (page->isSpilled() or page.use_count() > 1) {
+      continue;
+    }
+    if (not this->spillFile) {
+      if (this->spillUnavailable) {
+        return;
+      }
+      this->spillFile = SpillFile::create();
+      if (not this->spillFile) {
+        // Keep buffering in memory rather than failing the query.
+        this->spillUnavailable = true;
+        return;
+      }
+    }
+    size_t byteSize = page->getByteSize();
+    if (page->spill(this->spillFile)) {
+      this->releaseResidentBytes(byteSize);
+      this->spilledBytes += byteSize;
+      if (getLogLevel() <= LL_TRACE) {
+        WriteLog(LL_TRACE,
+                 "  Spilled " + std::to_string(page->getRowCount()) +
+                     " buffered rows to disk");
+      }
+    }
+  }
+}
+
+void TrinoQuery::queueSegments(std::vector<SpooledSegment> segments) {
+  if (not this->segmentsAbandoned) {
+    this->segmentsAbandoned = std::make_shared<std::atomic<bool>>(false);
+  }
+  for (SpooledSegment& segment : segments) {
+    PendingSegment pending;
+    if (segment.isInline) {
+      std::promise<std::string> rows;
+      try {
+        std::string text = decodeSegment(
+            segment.data, segment.compression, segment.uncompressedSize);
+        pending.reservedBytes = text.size();
+        rows.set_value(std::move(text));
+      } catch (const std::exception&) {
+        rows.set_exception(std::current_exception());
+      }
+      pending.rows = rows.get_future();
+    } else {
+      pending.reservedBytes = segment.expectedSize;
+      pending.rows = this->connectionConfig->getSegmentDownloader().download(
+          segment, this->segmentsAbandoned);
+    }
+    this->addResidentBytes(pending.reservedBytes);
+    this->pendingSegments.push_back(std::move(pending));
+  }
+}
+
+// Take the front segment off the queue, along with its reservation.
+void TrinoQuery::popSegment() {
+  this->releaseResidentBytes(this->pendingSegments.front().reservedBytes);
+  this->pendingSegments.pop_front();
+}
+
+/*
+Add the segments at the front of the queue that have arrived as pages,
+in order, so rows are read in the order Trino produced them. With wait
+set, block until at least the first segment is there, or the query
+runs out of time.
+*/
+UpdateStatus TrinoQuery::collectSegments(bool wait) {
+  UpdateStatus updateStatus;
+  while (not this->pendingSegments.empty()) {
+    // Downloaded segments can wait as well as the coordinator can.
+    if (not wait and this->ingestionPaused()) {
+      break;
+    }
+    std::future<std::string>& rows = this->pendingSegments.front().rows;
+    if (rows.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      if (not wait) {
+        break;
+      }
+      // Check now and then whether the query was canceled or ran out
+      // of time while waiting.
+      while (rows.wait_for(std::chrono::milliseconds(50)) !=
+             std::future_status::ready) {
+        if (this->cancelRequested) {
+          this->stopAtCancel();
+          return updateStatus;
+        }
+        if (this->timeout.count() > 0 and
+            std::chrono::steady_clock::now() >= this->deadline) {
+          this->stopAtTimeout();
+          return updateStatus;
+        }
+      }
+    }
+    wait = false;
+    std::string text;
+    try {
+      text = rows.get();
+    } catch (const std::exception& ex) {
+      WriteLog(LL_ERROR, "  ERROR: " + std::string(ex.what()));
+      this->error        = true;
+      this->errorMessage = ex.what();
+      this->popSegment();
+      this->setState(QS_FAILED);
+      this->stopQuery();
+      break;
+    }
+    this->popSegment();
+    RowSpans rowSpans;
+    scanRows(text, 0, this->columnsJson.size(), rowSpans);
+    this->addResultPage(std::move(text), std::move(rowSpans));
+    updateStatus.gotRowData = true;
+  }
+  this->updateCompletion();
+  return updateStatus;
+}
+
+/*
+Stop downloading the query's segments. Segments already being
+downloaded finish, but all of them are acknowledged so storage can
+delete them.
+*/
+void TrinoQuery::abandonSegments() {
+  if (this->segmentsAbandoned) {
+    this->segmentsAbandoned->store(true);
+    this->segmentsAbandoned.reset();
+  }
+  for (const PendingSegment& pending : this->pendingSegments) {
+    this->releaseResidentBytes(pending.reservedBytes);
+  }
+  this->pendingSegments.clear();
+}
+
+/*
+Hand a complete result over to the result cache. Every cell is decoded
+first, since other queries may read the pages at the same time.
+*/
+void TrinoQuery::storeCapturedResult() {
+  if (not this->error) {
+    StaticResult result;
+    result.columns = this->columnsJson;
+    for (const std::shared_ptr<ResultPage>& page : this->capturedPages) {
+      for (size_t column = 0; column < page->getColumnCount(); column++) {
+        page->decodeColumn(column);
+      }
+    }
+    result.pages = std::move(this->capturedPages);
+    getResultCache().store(this->resultCacheKey,
+                           this->connectionConfig->resultCacheSettings,
+                           std::move(result),
+                           this->capturedBytes);
+  }
+  this->resultCacheKey.clear();
+  this->capturedPages.clear();
+  this->capturedBytes = 0;
+}
+
 void TrinoQuery::onConnectionReset(ConnectionConfig* connectionConfig) {
   // If the connection is about to be reset, terminate any in-flight
   // queries first so they aren't left abandoned.
@@ -107,6 +420,8 @@ TrinoQuery::TrinoQuery(ConnectionConfig* connectionConfig) {
 }
 
 TrinoQuery::~TrinoQuery() {
+  this->abandonSegments();
+  this->releaseResidentBytes(this->residentBytes);
   this->connectionConfig->unregisterDisconnectCallback(
       std::bind(&TrinoQuery::onConnectionReset, this, std::placeholders::_1));
 }
@@ -119,18 +434,67 @@ const std::string& TrinoQuery::getQuery() const {
   return this->query;
 }
 
+void TrinoQuery::setPreparedStatement(const std::string& name,
+                                      const std::string& statementText) {
+  this->preparedStatementName = name;
+  this->preparedStatementText = statementText;
+}
+
 void TrinoQuery::post() {
-  CURL* curl = this->connectionConfig->getCurl();
+  this->submit().wait();
+}
+
+QueryTask TrinoQuery::submit() {
+  RequestLoop& requestLoop = *this->connectionConfig->requestLoop;
+  CURL* curl               = this->connectionConfig->getCurl();
+  this->connectionConfig->setCancelFlag(&this->cancelRequested);
 
   std::string statementURL = this->connectionConfig->getStatementUrl();
   curl_easy_setopt(curl, CURLOPT_URL, statementURL.c_str());
   curl_easy_setopt(curl, CURLOPT_POSTFIELDS, query.c_str());
 
-  CURLcode res = curl_easy_perform(curl);
+  if (not this->preparedStatementName.empty()) {
+    char* escapedText =
+        curl_easy_escape(curl,
+                         this->preparedStatementText.c_str(),
+                         static_cast<int>(this->preparedStatementText.size()));
+    this->connectionConfig->addRequestHeader(
+        "X-Trino-Prepared-Statement: " + this->preparedStatementName + "=" +
+        escapedText);
+    curl_free(escapedText);
+  }
+
+  // Ask for a spooled result. A server without spooling, or one that
+  // doesn't know the header, sends the rows inline as always.
+  if (this->connectionConfig->segmentDownloadThreads > 0) {
+    this->connectionConfig->addRequestHeader(
+        "X-Trino-Query-Data-Encoding: " +
+        this->connectionConfig->spoolingEncoding);
+  }
+
+  // Trino enforces the timeout as well, in case the driver is gone by
+  // the time it passes.
+  if (this->timeout.count() > 0) {
+    this->deadline = std::chrono::steady_clock::now() + this->timeout;
+    this->applyRequestTimeout(curl);
+    this->connectionConfig->addRequestHeader(
+        "X-Trino-Session: query_max_run_time=" +
+        std::to_string(this->timeout.count()) + "s");
+  }
+
+  this->setState(QS_SUBMITTED);
+  CURLcode res = co_await requestLoop.perform(curl);
 
   long httpStatusCode = this->connectionConfig->getLastHTTPStatusCode();
 
-  if (httpStatusCode == 200 and res == CURLE_OK) {
+  if (this->cancelRequested) {
+    // If the query got started, its nextUri is needed to stop it.
+    if (httpStatusCode == 200 and res == CURLE_OK) {
+      updateSelfFromResponse();
+    }
+    this->stopAtCancel();
+    throw CanceledError(this->errorMessage);
+  } else if (httpStatusCode == 200 and res == CURLE_OK) {
     updateSelfFromResponse();
     if (this->nextUri.empty()) {
       WriteLog(LL_ERROR,
@@ -138,6 +502,11 @@ void TrinoQuery::post() {
                    std::to_string(httpStatusCode));
       throw std::runtime_error("No NextURI in Trino POST response");
     }
+    this->stopAtMaxRows();
+  } else if (this->timeout.count() > 0 and
+             std::chrono::steady_clock::now() >= this->deadline) {
+    this->stopAtTimeout();
+    throw TimeoutError(this->errorMessage);
   } else {
     // If we get here, there was a problem posting the query.
     WriteLog(LL_ERROR,
@@ -152,22 +521,64 @@ void TrinoQuery::poll(TrinoQueryPollMode mode) {
   if (this->completed) {
     return;
   }
+  this->advance(mode).wait();
+}
 
-  CURL* curl    = this->connectionConfig->getCurl();
+QueryTask TrinoQuery::advance(TrinoQueryPollMode mode) {
+  RequestLoop& requestLoop = *this->connectionConfig->requestLoop;
+  CURL* curl               = this->connectionConfig->getCurl();
+  this->connectionConfig->setCancelFlag(&this->cancelRequested);
   int pollCount = 1;
+  // Don't ask the coordinator for more segments than the downloader
+  // can keep busy with, or for any while the ones on their way already
+  // use up the budget, since downloaded rows wait in memory. A query
+  // that was paused too long asks anyway, to keep Trino from giving up
+  // on it.
+  size_t segmentLookahead =
+      2 * std::max<size_t>(this->connectionConfig->segmentDownloadThreads, 1);
+  this->ingestionPausable =
+      mode != ToCompletion and mode != Draining and not this->retainRows;
   while (!this->completed) {
-    // Since we're reusing the curl handle, we need to clear any
-    // data returned from it. This is kind of ugly, but it is
-    // highly efficient.
-    this->connectionConfig->responseData.clear();
-    this->connectionConfig->responseHeaderData.clear();
-    curl_easy_setopt(curl, CURLOPT_URL, this->nextUri.c_str());
-
-    CURLcode res;
-    res = curl_easy_perform(curl);
+    if (this->cancelRequested) {
+      this->stopAtCancel();
+      break;
+    }
+    if (this->ingestionPaused()) {
+      WriteLog(LL_DEBUG, "  Over budget. Pausing until rows are read");
+      if (this->pausedAt == std::chrono::steady_clock::time_point()) {
+        this->pausedAt = std::chrono::steady_clock::now();
+      }
+      break;
+    }
     UpdateStatus updateStatus;
-    if (res == CURLE_OK) {
-      updateStatus = updateSelfFromResponse();
+    bool holdLookahead =
+        this->pendingSegments.size() >= segmentLookahead or
+        (not this->pendingSegments.empty() and this->overBudget());
+    if (this->nextUri.empty() or
+        (holdLookahead and not this->pausedTooLong())) {
+      updateStatus = this->collectSegments(true);
+      this->stopAtMaxRows();
+    } else {
+      // Since we're reusing the curl handle, we need to clear any
+      // data returned from it. This is kind of ugly, but it is
+      // highly efficient.
+      this->connectionConfig->responseData.clear();
+      this->connectionConfig->responseHeaderData.clear();
+      curl_easy_setopt(curl, CURLOPT_URL, this->nextUri.c_str());
+      if (not this->applyRequestTimeout(curl)) {
+        this->stopAtTimeout();
+        break;
+      }
+
+      CURLcode res = co_await requestLoop.perform(curl);
+      if (res == CURLE_OK) {
+        updateStatus = updateSelfFromResponse();
+        this->stopAtMaxRows();
+      }
+      this->pausedAt = std::chrono::steady_clock::time_point();
+    }
+    if (mode == Draining and updateStatus.gotRowData) {
+      this->checkpointRowPosition(this->getCurrentRowCount() - 1);
     }
 
     if (mode == JustOnce) {
@@ -189,11 +600,20 @@ void TrinoQuery::poll(TrinoQueryPollMode mode) {
     if (updateStatus.gotRowData or updateStatus.gotColumnInfo) {
       pollCount = 0;
     } else {
-      std::this_thread::sleep_for(
-          std::chrono::milliseconds(pollCount * API_POLL_INTERVAL_MS));
+      std::chrono::milliseconds pause(pollCount * API_POLL_INTERVAL_MS);
+      // Don't sleep through the deadline.
+      if (this->timeout.count() > 0) {
+        std::chrono::milliseconds remaining =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                this->deadline - std::chrono::steady_clock::now());
+        pause = std::min(pause, remaining);
+      }
+      // A cancel cuts the pause short.
+      co_await requestLoop.sleepFor(pause, &this->cancelRequested);
     }
     pollCount++;
   }
+  this->ingestionPausable = false;
 }
 
 /*
@@ -208,13 +628,7 @@ void TrinoQuery::poll(TrinoQueryPollMode mode) {
 */
 void TrinoQuery::cancel() {
   if (this->partialCancelUri.size() > 0) {
-    CURL* curl = this->connectionConfig->getCurl();
-    curl_easy_setopt(curl, CURLOPT_URL, this->partialCancelUri.c_str());
-    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-
-    CURLcode res = curl_easy_perform(curl);
-    UpdateStatus updateStatus;
-    if (res == CURLE_OK) {
+    if (this->sendDelete(this->partialCancelUri)) {
       // There's nothing to parse from the result of the DELETE
       // we sent to Trino, so the CURLE_OK means it was successful.
       // However, we actually need to finish reading the data
@@ -222,7 +636,8 @@ void TrinoQuery::cancel() {
       // after canceling the query. Otherwise it remains stuck
       // in the "FINISHING" state.
       WriteLog(LL_WARN, "Query Cancellation Sent. Polling to completion");
-      this->poll(ToCompletion);
+      this->setState(QS_DRAINING);
+      this->poll(Draining);
     }
   }
 }
@@ -232,14 +647,10 @@ void TrinoQuery::cancel() {
  This is accomplished by sending a DELETE to the nextUri.
 */
 void TrinoQuery::terminate() {
+  // Spooled segments on their way aren't needed any more either.
+  this->abandonSegments();
   if (not this->getIsCompleted() and this->nextUri.size() > 0) {
-    CURL* curl = this->connectionConfig->getCurl();
-    curl_easy_setopt(curl, CURLOPT_URL, this->nextUri.c_str());
-    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-
-    CURLcode res = curl_easy_perform(curl);
-    UpdateStatus updateStatus;
-    if (res == CURLE_OK) {
+    if (this->sendDelete(this->nextUri)) {
       // A success status on the terminate command means it
       // was successful. There's nothing to read after.
       // We can reset the statement in case someone tries
@@ -253,6 +664,150 @@ void TrinoQuery::terminate() {
   }
 }
 
+/*
+Closing a cursor stops an unfinished query too, but the DELETE is left
+to the connection's reaper so the application doesn't wait for it. The
+query is reset either way.
+*/
+void TrinoQuery::close() {
+  if (not this->completed and not this->nextUri.empty()) {
+    WriteLog(LL_DEBUG, "  Stopping the unfinished query in the background");
+    this->connectionConfig->reapQuery(this->nextUri);
+  }
+  this->reset();
+}
+
+/*
+Send a DELETE, which is how Trino is told to stop a query. The handle
+is put back to sending GETs afterwards, since getCurl doesn't undo a
+custom request method.
+*/
+bool TrinoQuery::sendDelete(const std::string& uri) {
+  CURL* curl = this->connectionConfig->getCurl();
+  curl_easy_setopt(curl, CURLOPT_URL, uri.c_str());
+  curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+  CURLcode res = this->connectionConfig->requestLoop->performAndWait(curl);
+  curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, nullptr);
+  return res == CURLE_OK;
+}
+
+/*
+Once the application has every row it wants, there's no point in
+letting the query run on and use up the cluster. It's stopped the way
+terminate does it, but the rows it returned can still be read.
+*/
+void TrinoQuery::stopAtMaxRows() {
+  if (this->completed or this->maxRows <= 0 or
+      this->getCurrentRowCount() < this->maxRows) {
+    return;
+  }
+  WriteLog(LL_DEBUG,
+           "  Got " + std::to_string(this->maxRows) +
+               " rows, the most the application wants. Stopping the query");
+  this->setState(QS_FINISHED);
+  this->stopQuery();
+}
+
+/*
+Stop the query on the server and mark it complete, keeping the rows
+already buffered. The result is cut short, so it can't be cached as
+the full result.
+*/
+void TrinoQuery::stopQuery() {
+  this->abandonCapturedResult();
+  this->abandonSegments();
+  if (not this->nextUri.empty() and not this->sendDelete(this->nextUri)) {
+    WriteLog(LL_WARN, "  Could not stop the query on the server");
+  }
+  this->nextUri.clear();
+  this->partialCancelUri.clear();
+  this->completed = true;
+}
+
+void TrinoQuery::abandonCapturedResult() {
+  this->resultCacheKey.clear();
+  this->capturedPages.clear();
+  this->capturedBytes = 0;
+}
+
+/*
+A request may take no longer than what's left of the query's time,
+nor longer than the connection allows any request. Returns false once
+the query has no time left.
+*/
+bool TrinoQuery::applyRequestTimeout(CURL* curl) {
+  if (this->timeout.count() == 0) {
+    return true;
+  }
+  std::chrono::milliseconds remaining =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          this->deadline - std::chrono::steady_clock::now());
+  if (remaining.count() <= 0) {
+    return false;
+  }
+  std::chrono::milliseconds connectionTimeout =
+      this->connectionConfig->connectionTimeout;
+  if (connectionTimeout.count() > 0 and connectionTimeout < remaining) {
+    remaining = connectionTimeout;
+  }
+  curl_easy_setopt(
+      curl, CURLOPT_TIMEOUT_MS, static_cast<long>(remaining.count()));
+  return true;
+}
+
+/*
+The server stops the query itself once query_max_run_time passes, but
+the driver doesn't wait to hear about it. The query is stopped the way
+terminate does it and reported as failed, so the rows it returned are
+discarded along with the rest of the result.
+*/
+void TrinoQuery::stopAtTimeout() {
+  std::string message = "Query timed out after " +
+                        std::to_string(this->timeout.count()) + " seconds";
+  WriteLog(LL_WARN, "  " + message + ". Stopping the query");
+  this->errorMessage = message;
+  this->error        = true;
+  this->timedOut     = true;
+  this->setState(QS_FAILED);
+  this->stopQuery();
+}
+
+/*
+Called on the thread running the query once it sees the cancel flag.
+The canceling thread has usually told Trino to stop already, but not if
+the query had no nextUri yet, and a second DELETE does no harm. Like a
+timeout, the query is reported as failed.
+*/
+void TrinoQuery::stopAtCancel() {
+  WriteLog(LL_WARN, "  Query was canceled. Stopping the query");
+  this->errorMessage = "Operation canceled";
+  this->error        = true;
+  this->canceled     = true;
+  this->setState(QS_CANCELED);
+  this->stopQuery();
+}
+
+void TrinoQuery::publishCancelUri() {
+  std::lock_guard<std::mutex> lock(this->cancelMutex);
+  this->cancelUri = this->nextUri;
+}
+
+void TrinoQuery::requestCancel() {
+  std::string uri;
+  {
+    std::lock_guard<std::mutex> lock(this->cancelMutex);
+    this->cancelRequested = true;
+    uri                   = this->cancelUri;
+  }
+  // The loop looks at the flag of a query paused between polls.
+  this->connectionConfig->requestLoop->interrupt();
+  WriteLog(LL_INFO, "  Cancel requested");
+  if (not uri.empty() and
+      not this->connectionConfig->sendOutOfBandDelete(uri)) {
+    WriteLog(LL_WARN, "  Could not send the cancel to the server");
+  }
+}
+
 const int64_t TrinoQuery::getAbsoluteRowCount() const {
   // The ODBC convention for row counts is that -1 represents
   // an as-yet unknown number of rows.
@@ -269,7 +824,7 @@ const int64_t TrinoQuery::getCurrentRowCount() const {
   // to provide the facade that the checkpointed rows that have
   // been discarded from memory are still around. Add one to the
   // offset position to turn it into a length/size.
-  return (this->rowOffsetPosition + 1) + this->dataJson.size();
+  return (this->rowOffsetPosition + 1) + this->bufferedRowCount;
 }
 
 const int16_t TrinoQuery::getColumnCount() {
@@ -293,6 +848,44 @@ const bool TrinoQuery::getIsCompleted() const {
   return this->completed;
 }
 
+const TrinoQueryState TrinoQuery::getState() const {
+  return this->state;
+}
+
+const bool TrinoQuery::hasError() const {
+  return this->error;
+}
+
+const bool TrinoQuery::hasTimedOut() const {
+  return this->timedOut;
+}
+
+const bool TrinoQuery::wasCanceled() const {
+  return this->canceled;
+}
+
+const std::string& TrinoQuery::getErrorMessage() const {
+  return this->errorMessage;
+}
+
+/*
+Columns normally arrive with the first page of results. They can also
+be set ahead of time when they're already known, like for a prepared
+statement, in which case the ones in the response are ignored.
+*/
+void TrinoQuery::setColumns(std::vector<json> columns) {
+  this->columnsJson = std::move(columns);
+  std::vector<ColumnDescription> columnDescriptions;
+  std::transform(this->columnsJson.begin(),
+                 this->columnsJson.end(),
+                 std::back_inserter(columnDescriptions),
+                 [](const json& json) { return ColumnDescription(json); });
+  this->columnDescriptions = columnDescriptions;
+  for (std::function f : this->onColumnDataCallbacks) {
+    f(this);
+  }
+}
+
 void TrinoQuery::sideloadResponse(json artificialResponse) {
   /*
    Most ODBC functions return a status code, not an actual result.
@@ -309,6 +902,34 @@ void TrinoQuery::sideloadResponse(json artificialResponse) {
   this->updateSelfFromResponse();
 }
 
+/*
+Keep the result of the query about to be posted, and store it in the
+result cache under cacheKey if it's read to the end without errors.
+*/
+void TrinoQuery::captureResult(const std::string& cacheKey) {
+  this->resultCacheKey = cacheKey;
+  this->capturedPages.clear();
+  this->capturedBytes = 0;
+}
+
+/*
+Attach a result the driver already has, as if a query had returned it
+in a single response. Nothing is serialized or parsed, and the pages
+are shared rather than copied.
+*/
+void TrinoQuery::sideloadResult(const StaticResult& result) {
+  if (this->columnDescriptions.empty()) {
+    this->setColumns(result.columns);
+  }
+  for (const std::shared_ptr<ResultPage>& page : result.pages) {
+    this->addResidentBytes(page->getByteSize());
+    this->appendPage(page);
+  }
+  this->completed = true;
+  this->nextUri.clear();
+  this->setState(QS_FINISHED);
+}
+
 /*
   Reset happens when an application wants to reuse a cursor with
   a different query. We need to clear out the results such that
@@ -318,18 +939,44 @@ void TrinoQuery::sideloadResponse(json artificialResponse) {
 */
 void TrinoQuery::reset() {
   WriteLog(LL_TRACE, "  TrinoQuery is resetting");
+  this->abandonSegments();
   this->query.clear();
   this->queryId.clear();
   this->infoUri.clear();
   this->partialCancelUri.clear();
   this->nextUri.clear();
   this->status.clear();
+  this->state = QS_IDLE;
   this->columnsJson.clear();
-  this->dataJson.clear();
+  this->resultPages.clear();
+  this->pageFirstRows.clear();
+  this->lastReadPage = 0;
+  this->releaseResidentBytes(this->residentBytes);
+  this->peakResidentBytes = 0;
+  this->spillFile.reset();
+  this->spillUnavailable   = false;
+  this->spilledBytes       = 0;
+  this->pausedAt           = std::chrono::steady_clock::time_point();
+  this->frontPageRowOffset = 0;
+  this->bufferedRowCount   = 0;
+  this->columnsInUse.clear();
+  this->resultCacheKey.clear();
+  this->capturedPages.clear();
+  this->capturedBytes = 0;
   this->columnDescriptions.clear();
+  this->preparedStatementName.clear();
+  this->preparedStatementText.clear();
+  this->errorMessage.clear();
   this->error             = false;
   this->completed         = false;
   this->rowOffsetPosition = -1;
+  this->maxRows           = 0;
+  this->timeout           = std::chrono::seconds(0);
+  this->timedOut          = false;
+  this->canceled          = false;
+  std::lock_guard<std::mutex> lock(this->cancelMutex);
+  this->cancelRequested = false;
+  this->cancelUri.clear();
 }
 
 void TrinoQuery::registerColumnDataChangeCallback(
@@ -342,56 +989,145 @@ const bool TrinoQuery::hasColumnData() const {
 }
 
 /*
-  We don't want dataJson to grow without bounds, otherwise
+  We don't want buffered rows to grow without bounds, otherwise
   we will run out of system memory on queries with lots of data.
 
   The solution is to allow callers to checkpoint their current position.
   This signals to the query that all rows have been read up to
   and including the completedIndex and that any memory consumed
-  by those earlier rows can be freed.
-
-  You wouldn't want to call this too frequently, since it resizes
-  a vector and would be quite computationally expensive.
+  by those earlier rows can be freed. Memory is freed a page at a
+  time, once every row in a page has been checkpointed.
 */
 void TrinoQuery::checkpointRowPosition(int64_t completedIndex) {
   // Don't do anything if we try to checkpoint before any
   // rows are read (index -1).
-  if (completedIndex < 0) {
+  // Retained rows stay buffered no matter what has been read.
+  if (completedIndex < 0 or this->retainRows) {
     return;
   }
-  // Get the position in dataJson that represents what has been
-  // completed already.
-  int64_t dataJsonPosition = completedIndex;
-  if (this->rowOffsetPosition > -1) {
-    dataJsonPosition -= (this->rowOffsetPosition + 1);
-  }
+  // The number of buffered rows that are now completed.
+  int64_t completedRows = completedIndex - this->rowOffsetPosition;
+  completedRows         = std::min(completedRows, this->bufferedRowCount);
 
-  // Watch out for unsigned integer underflow in this comparison!
-  if (dataJsonPosition == static_cast<int64_t>(dataJson.size()) - 1) {
-    // If we're erasing the whole thing, just clear it.
-    dataJson.clear();
-  } else {
-    // Otherwise, erase up to dataJsonPosition, being careful of the
-    // type of the offset for x86 vs x64 compilation.
-    dataJson.erase(dataJson.begin(),
-                   dataJson.begin() +
-                       static_cast<std::vector<int64_t>::difference_type>(
-                           dataJsonPosition));
+  this->bufferedRowCount -= completedRows;
+  this->frontPageRowOffset += static_cast<size_t>(completedRows);
+  while (not this->resultPages.empty() and
+         this->frontPageRowOffset >= this->resultPages.front()->getRowCount()) {
+    this->frontPageRowOffset -= this->resultPages.front()->getRowCount();
+    this->releaseResidentBytes(this->resultPages.front()->getByteSize());
+    this->resultPages.pop_front();
+    this->pageFirstRows.pop_front();
+    if (this->lastReadPage > 0) {
+      this->lastReadPage--;
+    }
   }
   this->rowOffsetPosition = completedIndex;
 }
 
 /*
-We need to hide the indexing into the dataJson vector
-so that we can implement the rowOffsetPosition offset. This
-gives callers the ability to track row offsets well beyond the
-number of rows that actually fit into memory from a query.
+Find the buffered page holding a row, given its absolute index. Rows
+are nearly always read in order, so the page read last is tried first
+and the rest are only searched when a scrollable cursor jumps around.
 */
-const json& TrinoQuery::getRowAtIndex(int64_t index) const {
-  if (this->rowOffsetPosition > -1) {
-    return this->dataJson[static_cast<std::vector<json>::size_type>(
-        index - (this->rowOffsetPosition + 1))];
-  } else {
-    return this->dataJson[static_cast<std::vector<json>::size_type>(index)];
+size_t TrinoQuery::findPage(int64_t rowIndex) {
+  if (this->lastReadPage < this->resultPages.size()) {
+    int64_t firstRow = this->pageFirstRows[this->lastReadPage];
+    int64_t rowCount = static_cast<int64_t>(
+        this->resultPages[this->lastReadPage]->getRowCount());
+    if (rowIndex >= firstRow and rowIndex < firstRow + rowCount) {
+      return this->lastReadPage;
+    }
+  }
+  auto after = std::upper_bound(
+      this->pageFirstRows.begin(), this->pageFirstRows.end(), rowIndex);
+  size_t page = static_cast<size_t>(after - this->pageFirstRows.begin());
+  if (page == 0 or
+      rowIndex >= this->pageFirstRows[page - 1] +
+                      static_cast<int64_t>(
+                          this->resultPages[page - 1]->getRowCount())) {
+    throw std::out_of_range("Row " + std::to_string(rowIndex) +
+                            " is not buffered");
+  }
+  page--;
+
+  // Moving to another page. A spilled page that was being read, and
+  // the one after it that was prefetched, can be unmapped again.
+  for (size_t oldPage : {this->lastReadPage, this->lastReadPage + 1}) {
+    if (oldPage < this->resultPages.size() and oldPage != page and
+        oldPage != page + 1) {
+      this->resultPages[oldPage]->unmap();
+    }
+  }
+  this->lastReadPage = page;
+  // If the next page was spilled, have it read in from disk while this
+  // one is being read.
+  if (page + 1 < this->resultPages.size()) {
+    this->resultPages[page + 1]->prefetch();
+  }
+  return page;
+}
+
+/*
+We need to hide the indexing into the buffered pages so that we can
+implement the rowOffsetPosition offset. This gives callers the ability
+to track row offsets well beyond the number of rows that actually fit
+into memory from a query.
+*/
+const json& TrinoQuery::getCellAtIndex(int64_t rowIndex, size_t columnIndex) {
+  size_t page = this->findPage(rowIndex);
+  size_t row  = static_cast<size_t>(rowIndex - this->pageFirstRows[page]);
+  return this->resultPages[page]->getCell(row, columnIndex);
+}
+
+/*
+Record that the application reads this column, either because it is
+bound or because SQLGetData asked for it. Pages that arrive from now
+on decode it right away instead of waiting for the first read.
+*/
+void TrinoQuery::markColumnInUse(size_t columnIndex) {
+  if (columnIndex >= this->columnsInUse.size()) {
+    this->columnsInUse.resize(columnIndex + 1, false);
+  }
+  this->columnsInUse[columnIndex] = true;
+}
+
+/*
+Static cursors scroll back over rows that were already read, so they
+keep the whole result. Rows that don't fit the connection's buffer
+limits spill to disk rather than being let go of.
+*/
+void TrinoQuery::setRetainRows(bool retainRows) {
+  this->retainRows = retainRows;
+}
+
+void TrinoQuery::setMaxRows(int64_t maxRows) {
+  this->maxRows = maxRows;
+}
+
+/*
+The most time the query may take, counted from when it's posted and
+across every poll after. Zero means no limit.
+*/
+void TrinoQuery::setTimeout(std::chrono::seconds timeout) {
+  this->timeout = timeout;
+}
+
+size_t TrinoQuery::getBufferedBytes() const {
+  return this->residentBytes;
+}
+
+size_t TrinoQuery::getPeakBufferedBytes() const {
+  return this->peakResidentBytes;
+}
+
+size_t TrinoQuery::getSpilledBytes() const {
+  return this->spilledBytes;
+}
+
+void TrinoQuery::pollIfStalled() {
+  if (this->completed or not this->pausedTooLong()) {
+    return;
   }
+  WriteLog(LL_DEBUG, "  Paused too long. Polling so Trino keeps the query");
+  this->poll(JustOnce);
 }
@@ -1,12 +1,20 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
 
 #include "columnDescription.hpp"
 #include "connectionConfig.hpp"
+#include "requestLoop.hpp"
+#include "resultPage.hpp"
 
 using json = nlohmann::json;
 
@@ -20,6 +28,27 @@ enum TrinoQueryPollMode {
   UntilNewData,
   UntilColumnsLoaded,
   ToCompletion,
+  // Like ToCompletion, but rows are let go of as they arrive, for
+  // queries whose rows nobody reads.
+  Draining,
+};
+
+/*
+Where a query is in its life. It's submitted once posted, follows the
+state Trino reports while it waits for resources and runs, and drains
+once the coordinator is done but rows are still on their way, or after
+a partial cancel. It ends in one of the last three states, which only
+a reset leaves.
+*/
+enum TrinoQueryState {
+  QS_IDLE,
+  QS_SUBMITTED,
+  QS_QUEUED,
+  QS_RUNNING,
+  QS_DRAINING,
+  QS_FINISHED,
+  QS_FAILED,
+  QS_CANCELED,
 };
 
 // Need to allow a few tests access to private variables
@@ -38,20 +67,116 @@ class TrinoQuery {
   private:
     ConnectionConfig* connectionConfig;
     std::string query = "UNSET";
+    // A prepared statement the query refers to by name. Trino keeps no
+    // prepared statements on the server, so the text travels with the
+    // request in a header.
+    std::string preparedStatementName;
+    std::string preparedStatementText;
     std::string queryId;
     std::string infoUri;
     std::string partialCancelUri;
     std::string nextUri;
     std::string status;
+    TrinoQueryState state = QS_IDLE;
     std::vector<json> columnsJson;
-    std::vector<json> dataJson;
+    // Buffered rows, in pages as they arrived from Trino. Rows before
+    // frontPageRowOffset in the first page have been checkpointed.
+    // Pages of a StaticResult are shared with other queries.
+    std::deque<std::shared_ptr<ResultPage>> resultPages;
+    // The absolute index of the first row of each buffered page, and
+    // the page the last cell was read from, so sequential reads don't
+    // have to search for their page.
+    std::deque<int64_t> pageFirstRows;
+    size_t lastReadPage       = 0;
+    size_t frontPageRowOffset = 0;
+    int64_t bufferedRowCount  = 0;
+    // Segments of a spooled result that haven't been added as pages
+    // yet, in order. The flag tells the downloader to skip the ones it
+    // hasn't started on once they're no longer wanted. Until a segment
+    // is added, the memory its rows will take is counted as resident.
+    struct PendingSegment {
+        std::future<std::string> rows;
+        size_t reservedBytes = 0;
+    };
+    std::deque<PendingSegment> pendingSegments;
+    std::shared_ptr<std::atomic<bool>> segmentsAbandoned;
+    // Keep every row, even after it's checkpointed, so the application
+    // can scroll back to it.
+    bool retainRows = false;
+    // The most rows the application wants, or zero for all of them.
+    // The query is stopped on the server once it has returned them.
+    int64_t maxRows = 0;
+    // SQL_ATTR_QUERY_TIMEOUT. Once the deadline passes, the query is
+    // stopped on the server and reported as timed out.
+    std::chrono::seconds timeout = std::chrono::seconds(0);
+    std::chrono::steady_clock::time_point deadline;
+    bool timedOut = false;
+    // SQLCancel sets the flag from another thread, which cuts short
+    // any pause between polls and aborts the request in flight. The
+    // query is then stopped and reported as canceled. cancelUri is a
+    // copy of nextUri the other thread can read under cancelMutex, so
+    // it can tell Trino to stop without waiting for this one.
+    std::atomic<bool> cancelRequested = false;
+    std::mutex cancelMutex;
+    std::string cancelUri;
+    bool canceled = false;
+    // Columns the application is known to read. These are decoded as
+    // soon as a page arrives, the rest only if something reads them.
+    std::vector<bool> columnsInUse;
+    // Memory held by buffered pages, and where pages go when there's
+    // more of it than the connection's SpillSettings allow.
+    size_t residentBytes     = 0;
+    size_t peakResidentBytes = 0;
+    // Set while a poll may stop early to wait for the application to
+    // read rows, which is only while it reads them in order. pausedAt
+    // is when a poll last stopped that way, or zero if the one after
+    // it went ahead.
+    bool ingestionPausable = false;
+    std::chrono::steady_clock::time_point pausedAt;
+    std::shared_ptr<SpillFile> spillFile;
+    bool spillUnavailable = false;
+    size_t spilledBytes   = 0;
+    // While resultCacheKey is set, pages are also kept here so the
+    // whole result can go into the result cache once it's complete.
+    std::string resultCacheKey;
+    std::vector<std::shared_ptr<ResultPage>> capturedPages;
+    size_t capturedBytes = 0;
     std::vector<ColumnDescription> columnDescriptions;
     bool error     = false;
     bool completed = false;
+    std::string errorMessage;
     std::vector<std::function<void(TrinoQuery*)>> onColumnDataCallbacks;
     int64_t rowOffsetPosition = -1;
+    // The query's requests, as tasks on the connection's request loop.
+    // post and poll run them and wait for them to finish.
+    QueryTask submit();
+    QueryTask advance(TrinoQueryPollMode mode);
     UpdateStatus updateSelfFromResponse();
+    void setState(TrinoQueryState state);
     void onConnectionReset(ConnectionConfig* connectionConfig);
+    void updateCompletion();
+    void addResultPage(std::string&& text, RowSpans&& rows);
+    void queueSegments(std::vector<SpooledSegment> segments);
+    UpdateStatus collectSegments(bool wait);
+    void abandonSegments();
+    void storeCapturedResult();
+    void addResidentBytes(size_t byteSize);
+    void releaseResidentBytes(size_t byteSize);
+    void popSegment();
+    bool overBudget() const;
+    bool pausedTooLong() const;
+    bool ingestionPaused() const;
+    void spillOverBudget();
+    void appendPage(std::shared_ptr<ResultPage> page);
+    size_t findPage(int64_t rowIndex);
+    bool sendDelete(const std::string& uri);
+    void abandonCapturedResult();
+    void stopQuery();
+    void stopAtMaxRows();
+    bool applyRequestTimeout(CURL* curl);
+    void stopAtTimeout();
+    void stopAtCancel();
+    void publishCancelUri();
 
     friend class MemoryReclamationTest;
 
@@ -60,19 +185,50 @@ class TrinoQuery {
     ~TrinoQuery();
     void setQuery(std::string query);
     const std::string& getQuery() const;
+    void setPreparedStatement(const std::string& name,
+                              const std::string& statementText);
     void post();
     void cancel();
     void terminate();
+    void close();
     void poll(TrinoQueryPollMode mode);
     const int64_t getCurrentRowCount() const;
     const int64_t getAbsoluteRowCount() const;
     const int16_t getColumnCount();
     const std::vector<ColumnDescription>& getColumnDescriptions();
     const bool getIsCompleted() const;
+    const TrinoQueryState getState() const;
+    const bool hasError() const;
+    const bool hasTimedOut() const;
+    const bool wasCanceled() const;
+    // Ask the thread that owns the query to stop it, the next time it
+    // sends or polls the query, or right away if it's doing so now.
+    // Safe to call from any thread, and returns without waiting for
+    // that thread. Nothing but the flag and the server is touched.
+    void requestCancel();
+    const std::string& getErrorMessage() const;
+    void setColumns(std::vector<json> columns);
     void sideloadResponse(json artificialResponse);
+    void sideloadResult(const StaticResult& result);
+    void captureResult(const std::string& cacheKey);
     void reset();
     void registerColumnDataChangeCallback(std::function<void(TrinoQuery*)> f);
     const bool hasColumnData() const;
     void checkpointRowPosition(int64_t completedIndex);
-    const json& getRowAtIndex(int64_t) const;
+    const json& getCellAtIndex(int64_t rowIndex, size_t columnIndex);
+    void markColumnInUse(size_t columnIndex);
+    void setRetainRows(bool retainRows);
+    void setMaxRows(int64_t maxRows);
+    void setTimeout(std::chrono::seconds timeout);
+    // Memory held by buffered rows now, and the most it has held since
+    // the query was posted. Segments on their way count at the size
+    // the server gave for them.
+    size_t getBufferedBytes() const;
+    size_t getPeakBufferedBytes() const;
+    // Bytes of buffered rows written to disk since the query was posted.
+    size_t getSpilledBytes() const;
+    // Poll the query once if it has been paused for longer than the
+    // connection's pauseLimit, so Trino doesn't give up on it while the
+    // application works through its buffered rows.
+    void pollIfStalled();
 };
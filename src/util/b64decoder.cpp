@@ -1,5 +1,9 @@
 #include "b64decoder.hpp"
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
 #include <unordered_map>
 #include <utility>
 
@@ -8,6 +12,11 @@
 
 #include "writeLog.hpp"
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define B64_DECODER_USE_SSE2
+#endif
+
 std::string fromBase64url(const std::string& input) {
   /*
   NOTE: base64url encoding is different from base64 encoding.
@@ -41,3 +50,166 @@ std::string fromBase64url(const std::string& input) {
   }
   return std::string(reinterpret_cast<char*>(decodedData.data()), requiredSize);
 }
+
+// Maps each base64 character to its 6 bit value, or 0xFF if it isn't one.
+static constexpr std::array<uint8_t, 256> BASE64_VALUES = [] {
+  std::array<uint8_t, 256> table{};
+  table.fill(0xFF);
+  for (int i = 0; i < 26; i++) {
+    table['A' + i] = static_cast<uint8_t>(i);
+    table['a' + i] = static_cast<uint8_t>(26 + i);
+  }
+  for (int i = 0; i < 10; i++) {
+    table['0' + i] = static_cast<uint8_t>(52 + i);
+  }
+  table['+'] = 62;
+  table['/'] = 63;
+  return table;
+}();
+
+size_t base64DecodedSize(std::string_view encoded) {
+  size_t length  = encoded.size();
+  size_t padding = 0;
+  if (length > 0 and encoded[length - 1] == '=') {
+    padding++;
+    if (length > 1 and encoded[length - 2] == '=') {
+      padding++;
+    }
+  }
+  return (length / 4) * 3 - std::min((length / 4) * 3, padding);
+}
+
+/*
+Decode one four character quantum into up to three bytes. Padding is
+only valid in the last quantum, which the caller tells us about.
+*/
+static void decodeQuantum(const char* in, bool isLast, unsigned char* out) {
+  uint8_t a = BASE64_VALUES[static_cast<uint8_t>(in[0])];
+  uint8_t b = BASE64_VALUES[static_cast<uint8_t>(in[1])];
+  bool padC = isLast and in[2] == '=' and in[3] == '=';
+  bool padD = isLast and in[3] == '=';
+  uint8_t c = padC ? 0 : BASE64_VALUES[static_cast<uint8_t>(in[2])];
+  uint8_t d = padD ? 0 : BASE64_VALUES[static_cast<uint8_t>(in[3])];
+  if ((a | b | c | d) & 0x80) {
+    throw std::invalid_argument("Invalid character in base64 data");
+  }
+  uint32_t bits = (a << 18) | (b << 12) | (c << 6) | d;
+  out[0]        = static_cast<unsigned char>(bits >> 16);
+  out[1]        = static_cast<unsigned char>(bits >> 8);
+  out[2]        = static_cast<unsigned char>(bits);
+}
+
+#ifdef B64_DECODER_USE_SSE2
+static inline __m128i inRange(__m128i input, char low, char high) {
+  return _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8(low - 1)),
+                       _mm_cmplt_epi8(input, _mm_set1_epi8(high + 1)));
+}
+
+/*
+Decode 16 characters into 12 bytes. The character classes are found
+with range compares, and each class's offset is added in one pass.
+The 6 bit values are then merged pairwise within 16 and 32 bit lanes.
+Returns false, without writing anything, if any character isn't part
+of the base64 alphabet, so the caller can report it from the scalar
+path.
+*/
+static inline bool decodeBlock(const char* in, unsigned char* out) {
+  const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+
+  const __m128i upper = inRange(input, 'A', 'Z');
+  const __m128i lower = inRange(input, 'a', 'z');
+  const __m128i digit = inRange(input, '0', '9');
+  const __m128i plus  = _mm_cmpeq_epi8(input, _mm_set1_epi8('+'));
+  const __m128i slash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+
+  const __m128i valid = _mm_or_si128(
+      _mm_or_si128(upper, lower),
+      _mm_or_si128(digit, _mm_or_si128(plus, slash)));
+  if (_mm_movemask_epi8(valid) != 0xFFFF) {
+    return false;
+  }
+
+  __m128i offset = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+  offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+  offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+  offset = _mm_or_si128(offset, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+  offset = _mm_or_si128(offset, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
+  const __m128i values = _mm_add_epi8(input, offset);
+
+  // Each 16 bit lane holds two characters, first in the low byte.
+  const __m128i pairs = _mm_or_si128(
+      _mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0x00FF)), 6),
+      _mm_srli_epi16(values, 8));
+  // Each 32 bit lane now holds two 12 bit pairs, first in the low half.
+  const __m128i quads = _mm_or_si128(
+      _mm_slli_epi32(_mm_and_si128(pairs, _mm_set1_epi32(0x0000FFFF)), 12),
+      _mm_srli_epi32(pairs, 16));
+
+  alignas(16) uint32_t bits[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(bits), quads);
+  for (int i = 0; i < 4; i++) {
+    out[3 * i]     = static_cast<unsigned char>(bits[i] >> 16);
+    out[3 * i + 1] = static_cast<unsigned char>(bits[i] >> 8);
+    out[3 * i + 2] = static_cast<unsigned char>(bits[i]);
+  }
+  return true;
+}
+#endif
+
+size_t decodeBase64Range(std::string_view encoded,
+                         size_t decodedOffset,
+                         unsigned char* output,
+                         size_t outputLength) {
+  if (encoded.size() % 4 != 0) {
+    throw std::invalid_argument("Base64 data length is not a multiple of 4");
+  }
+  size_t totalSize = base64DecodedSize(encoded);
+  if (decodedOffset >= totalSize) {
+    return 0;
+  }
+  size_t remaining   = std::min(outputLength, totalSize - decodedOffset);
+  size_t written     = 0;
+  size_t quantum     = decodedOffset / 3;
+  size_t skip        = decodedOffset % 3;
+  size_t quantaCount = encoded.size() / 4;
+  const char* in     = encoded.data();
+  unsigned char scratch[3];
+
+  // A piece that starts part way into a quantum.
+  if (skip > 0) {
+    decodeQuantum(in + 4 * quantum, quantum + 1 == quantaCount, scratch);
+    size_t take = std::min(remaining, 3 - skip);
+    std::memcpy(output, scratch + skip, take);
+    written += take;
+    remaining -= take;
+    quantum++;
+  }
+
+#ifdef B64_DECODER_USE_SSE2
+  // Whole blocks of four quanta, never including the padded last one.
+  while (remaining >= 12 and quantum + 4 < quantaCount) {
+    if (not decodeBlock(in + 4 * quantum, output + written)) {
+      break;
+    }
+    written += 12;
+    remaining -= 12;
+    quantum += 4;
+  }
+#endif
+
+  while (remaining >= 3) {
+    decodeQuantum(
+        in + 4 * quantum, quantum + 1 == quantaCount, output + written);
+    written += 3;
+    remaining -= 3;
+    quantum++;
+  }
+
+  // A piece that ends part way into a quantum.
+  if (remaining > 0) {
+    decodeQuantum(in + 4 * quantum, quantum + 1 == quantaCount, scratch);
+    std::memcpy(output + written, scratch, remaining);
+    written += remaining;
+  }
+  return written;
+}
@@ -1,5 +1,27 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 std::string fromBase64url(const std::string& encodedString);
+
+/*
+The number of bytes the standard (not url-safe) base64 text decodes to,
+taking any trailing '=' padding into account.
+*/
+size_t base64DecodedSize(std::string_view encoded);
+
+/*
+Decode part of a standard base64 string directly into a buffer.
+
+Decoding starts at decodedOffset bytes into the decoded value and
+stops once outputLength bytes are written or the value ends, which
+makes it suitable for returning a large value in pieces. Returns the
+number of bytes written. Throws std::invalid_argument if the text
+isn't valid base64.
+*/
+size_t decodeBase64Range(std::string_view encoded,
+                         size_t decodedOffset,
+                         unsigned char* output,
+                         size_t outputLength);
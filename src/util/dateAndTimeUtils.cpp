@@ -4,19 +4,26 @@
 #include <chrono>
 #include <map>
 
-std::map<std::string, const std::chrono::time_zone*> TIMEZONE_CACHE = {};
+/*
+Each thread keeps its own cache, so reading it takes no lock. The time
+zone database itself is safe to share, and the handful of zones a
+thread ever sees are cheap to look up once more.
+*/
+static thread_local std::map<std::string, const std::chrono::time_zone*>
+    TIMEZONE_CACHE;
 
 const std::chrono::time_zone* getTimezone(std::string& tzName) {
   /*
   Since we will be looking up a lot of timezones, it's probably a good idea
   to cache any responses in a variable.
   */
-  if (TIMEZONE_CACHE.count(tzName) == 0) {
+  auto cached = TIMEZONE_CACHE.find(tzName);
+  if (cached == TIMEZONE_CACHE.end()) {
     const std::chrono::time_zone* zone =
         std::chrono::get_tzdb().locate_zone(tzName);
-    TIMEZONE_CACHE[tzName] = zone;
+    cached = TIMEZONE_CACHE.emplace(tzName, zone).first;
   }
-  return TIMEZONE_CACHE[tzName];
+  return cached->second;
 }
 
 /*
@@ -30,7 +37,7 @@ Date:   2000-01-01 00:00:00.123456789999
 Index:  01234567890123456789
                            ^ - Position 19
 */
-int FRACTIONAL_SECONDS_START_OFFSET = 19;
+const int FRACTIONAL_SECONDS_START_OFFSET = 19;
 
 struct FractionParseResult {
     SQLUINTEGER fraction = 0;
@@ -1,5 +1,7 @@
 #include "decimalHelper.hpp"
 
+#include <stdexcept>
+
 /*
 I'm calling this lsbDecimalEncoder, but that's not really a good name for this.
 It's implementing the ODBC numeric struct spec as defined in the MS KB article.
@@ -7,21 +9,30 @@ It's implementing the ODBC numeric struct spec as defined in the MS KB article.
 https://learn.microsoft.com/en-us/sql/odbc/reference/appendixes/retrieve-numeric-data-sql-numeric-struct-kb222831
 */
 std::string lsbDecimalEncoder(std::string& s) {
-  signed long long num = 0;
   // Negative numbers should skip parsing the '-' sign,
-  // since the value
-  if (s[0] == '-') {
-    num = std::stoll(s.substr(1));
-  } else {
-    num = std::stoll(s);
-  }
+  // since the sign is stored separately in the struct.
+  size_t start = (not s.empty() and s[0] == '-') ? 1 : 0;
 
+  // The value is little endian and can be wider than any integer type,
+  // up to the 16 bytes of the struct's val array. Each digit multiplies
+  // what's there by ten and adds itself, a byte at a time.
   std::string output;
-
-  while (num > 0) {
-    char byte = num & 0xFF;
-    output.push_back(byte);
-    num >>= 8;
+  for (size_t i = start; i < s.size(); i++) {
+    if (s[i] < '0' or s[i] > '9') {
+      throw std::invalid_argument("Not a decimal number: " + s);
+    }
+    unsigned int carry = s[i] - '0';
+    for (char& byte : output) {
+      unsigned int product = static_cast<unsigned char>(byte) * 10 + carry;
+      byte                 = static_cast<char>(product & 0xFF);
+      carry                = product >> 8;
+    }
+    if (carry != 0) {
+      output.push_back(static_cast<char>(carry));
+    }
+    if (output.size() > NUMERIC_VALUE_BYTES) {
+      throw std::out_of_range("Decimal value is too large: " + s);
+    }
   }
 
   return output;
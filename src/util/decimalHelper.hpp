@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
+// The size of SQL_NUMERIC_STRUCT's val array, SQL_MAX_NUMERIC_LEN.
+constexpr size_t NUMERIC_VALUE_BYTES = 16;
+
 std::string lsbDecimalEncoder(std::string& s);
@@ -0,0 +1,119 @@
+#include "guidParser.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define GUID_PARSER_USE_SSE2
+#endif
+
+/*
+The 32 hex digits of a UUID sit at fixed offsets between the dashes.
+Gathering them into one contiguous array up front lets the decoder
+run over two 16 byte blocks without caring about the layout.
+*/
+static inline bool gatherHexDigits(std::string_view text, char* digits) {
+  if (text.size() != GUID_TEXT_LENGTH or text[8] != '-' or text[13] != '-' or
+      text[18] != '-' or text[23] != '-') {
+    return false;
+  }
+  const char* in = text.data();
+  std::memcpy(digits, in, 8);
+  std::memcpy(digits + 8, in + 9, 4);
+  std::memcpy(digits + 12, in + 14, 4);
+  std::memcpy(digits + 16, in + 19, 4);
+  std::memcpy(digits + 20, in + 24, 12);
+  return true;
+}
+
+#ifdef GUID_PARSER_USE_SSE2
+/*
+Turn 16 hex digits into 8 bytes. Digits and letters are classified
+with range compares, every lane is checked at once, and adjacent
+nibbles are merged with 16 bit shifts before packing down to bytes.
+*/
+static inline bool decodeHexBlock(const char* digits, uint8_t* bytes) {
+  const __m128i input =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+
+  // Signed compares, so these bounds are one outside the accepted range.
+  const __m128i digitValue = _mm_sub_epi8(input, _mm_set1_epi8('0'));
+  const __m128i isDigit =
+      _mm_and_si128(_mm_cmpgt_epi8(digitValue, _mm_set1_epi8(-1)),
+                    _mm_cmplt_epi8(digitValue, _mm_set1_epi8(10)));
+
+  const __m128i lowered    = _mm_or_si128(input, _mm_set1_epi8(0x20));
+  const __m128i letterBase = _mm_sub_epi8(lowered, _mm_set1_epi8('a'));
+  const __m128i isLetter =
+      _mm_and_si128(_mm_cmpgt_epi8(letterBase, _mm_set1_epi8(-1)),
+                    _mm_cmplt_epi8(letterBase, _mm_set1_epi8(6)));
+
+  if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) {
+    return false;
+  }
+
+  const __m128i nibbles = _mm_or_si128(
+      _mm_and_si128(isDigit, digitValue),
+      _mm_and_si128(isLetter, _mm_add_epi8(letterBase, _mm_set1_epi8(10))));
+
+  // In each 16 bit lane the first digit is the low byte and the second
+  // digit is the high byte. The first digit is the high nibble.
+  const __m128i firstDigits = _mm_and_si128(nibbles, _mm_set1_epi16(0x00FF));
+  const __m128i high        = _mm_slli_epi16(firstDigits, 4);
+  const __m128i low         = _mm_srli_epi16(nibbles, 8);
+  const __m128i merged      = _mm_or_si128(high, low);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(bytes),
+                   _mm_packus_epi16(merged, merged));
+  return true;
+}
+#else
+// Maps each character to its hex value, or 0xFF if it isn't a hex digit.
+static constexpr std::array<uint8_t, 256> HEX_VALUES = [] {
+  std::array<uint8_t, 256> table{};
+  table.fill(0xFF);
+  for (int i = 0; i < 10; i++) {
+    table['0' + i] = static_cast<uint8_t>(i);
+  }
+  for (int i = 0; i < 6; i++) {
+    table['a' + i] = static_cast<uint8_t>(10 + i);
+    table['A' + i] = static_cast<uint8_t>(10 + i);
+  }
+  return table;
+}();
+
+static inline bool decodeHexBlock(const char* digits, uint8_t* bytes) {
+  // Accumulate rather than branch on every digit. Any invalid digit
+  // sets the high bit, which is checked once at the end.
+  uint8_t invalid = 0;
+  for (size_t i = 0; i < 8; i++) {
+    uint8_t high = HEX_VALUES[static_cast<uint8_t>(digits[2 * i])];
+    uint8_t low  = HEX_VALUES[static_cast<uint8_t>(digits[2 * i + 1])];
+    invalid |= high | low;
+    bytes[i] = static_cast<uint8_t>((high << 4) | (low & 0x0F));
+  }
+  return (invalid & 0x80) == 0;
+}
+#endif
+
+bool parseGuid(std::string_view text, SQLGUID& guid) {
+  char digits[32];
+  uint8_t bytes[16];
+  if (not gatherHexDigits(text, digits) or
+      not decodeHexBlock(digits, bytes) or
+      not decodeHexBlock(digits + 16, bytes + 8)) {
+    return false;
+  }
+
+  // The text is big endian, but the first three SQLGUID fields are
+  // native integers.
+  guid.Data1 = (static_cast<uint32_t>(bytes[0]) << 24) |
+               (static_cast<uint32_t>(bytes[1]) << 16) |
+               (static_cast<uint32_t>(bytes[2]) << 8) |
+               static_cast<uint32_t>(bytes[3]);
+  guid.Data2 = static_cast<uint16_t>((bytes[4] << 8) | bytes[5]);
+  guid.Data3 = static_cast<uint16_t>((bytes[6] << 8) | bytes[7]);
+  std::memcpy(guid.Data4, bytes + 8, 8);
+  return true;
+}
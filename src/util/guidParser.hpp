@@ -0,0 +1,17 @@
+#pragma once
+
+#include "windowsLean.hpp"
+#include <sql.h>
+
+#include <cstddef>
+#include <string_view>
+
+// The canonical textual form, "00000000-0000-0000-0000-000000000000".
+constexpr size_t GUID_TEXT_LENGTH = 36;
+
+/*
+Parse the canonical 36 character form of a UUID directly into a
+SQLGUID. Upper and lower case hex digits are both accepted. Returns
+false, leaving guid untouched, if the text isn't exactly in that form.
+*/
+bool parseGuid(std::string_view text, SQLGUID& guid);
@@ -0,0 +1,258 @@
+#include "parameterMarkers.hpp"
+
+#include <cctype>
+
+/*
+If pos starts a string literal, quoted identifier or comment, return
+the offset just past it. Otherwise return pos unchanged.
+
+SQL escapes a quote inside quotes by doubling it, which needs no
+special handling: the doubled quote just reads as the end of one
+quoted section and the start of the next.
+*/
+static size_t skipNonCode(std::string_view text, size_t pos) {
+  char c = text[pos];
+  size_t end;
+  if (c == '\'' or c == '"') {
+    end = text.find(c, pos + 1);
+    return end == std::string_view::npos ? text.size() : end + 1;
+  }
+  if (text.substr(pos, 2) == "--") {
+    end = text.find('\n', pos);
+    return end == std::string_view::npos ? text.size() : end;
+  }
+  if (text.substr(pos, 2) == "/*") {
+    end = text.find("*/", pos + 2);
+    return end == std::string_view::npos ? text.size() : end + 2;
+  }
+  return pos;
+}
+
+std::vector<size_t> findParameterMarkers(std::string_view statementText) {
+  std::vector<size_t> markers;
+  size_t pos = 0;
+  while (pos < statementText.size()) {
+    size_t next = skipNonCode(statementText, pos);
+    if (next != pos) {
+      pos = next;
+      continue;
+    }
+    if (statementText[pos] == '?') {
+      markers.push_back(pos);
+    }
+    pos++;
+  }
+  return markers;
+}
+
+static bool isWordChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) or c == '_';
+}
+
+static bool isKeywordAt(std::string_view text,
+                        size_t pos,
+                        std::string_view keyword) {
+  if (pos + keyword.size() > text.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < keyword.size(); i++) {
+    if (std::toupper(static_cast<unsigned char>(text[pos + i])) != keyword[i]) {
+      return false;
+    }
+  }
+  bool boundaryBefore = pos == 0 or not isWordChar(text[pos - 1]);
+  bool boundaryAfter  = pos + keyword.size() == text.size() or
+                       not isWordChar(text[pos + keyword.size()]);
+  return boundaryBefore and boundaryAfter;
+}
+
+/*
+Skip whitespace and comments, returning the offset of the next
+character that means something.
+*/
+static size_t skipSpace(std::string_view text, size_t pos) {
+  while (pos < text.size()) {
+    if (std::isspace(static_cast<unsigned char>(text[pos]))) {
+      pos++;
+    } else if (text[pos] != '\'' and text[pos] != '"' and
+               skipNonCode(text, pos) != pos) {
+      pos = skipNonCode(text, pos);
+    } else {
+      break;
+    }
+  }
+  return pos;
+}
+
+bool findInsertValuesRow(std::string_view statementText,
+                         const std::vector<size_t>& markers,
+                         size_t& rowBegin,
+                         size_t& rowEnd) {
+  size_t pos = skipSpace(statementText, 0);
+  if (not isKeywordAt(statementText, pos, "INSERT")) {
+    return false;
+  }
+
+  // Find VALUES outside of any quotes or comments.
+  size_t valuesPos = std::string_view::npos;
+  while (pos < statementText.size()) {
+    size_t next = skipNonCode(statementText, pos);
+    if (next != pos) {
+      pos = next;
+    } else if (isKeywordAt(statementText, pos, "VALUES")) {
+      valuesPos = pos;
+      break;
+    } else {
+      pos++;
+    }
+  }
+  if (valuesPos == std::string_view::npos) {
+    return false;
+  }
+
+  pos = skipSpace(statementText, valuesPos + 6);
+  if (pos >= statementText.size() or statementText[pos] != '(') {
+    return false;
+  }
+  rowBegin  = pos;
+  int depth = 0;
+  while (pos < statementText.size()) {
+    size_t next = skipNonCode(statementText, pos);
+    if (next != pos) {
+      pos = next;
+      continue;
+    }
+    char c = statementText[pos];
+    if (c == '(') {
+      depth++;
+    } else if (c == ')' and --depth == 0) {
+      break;
+    }
+    pos++;
+  }
+  if (pos >= statementText.size()) {
+    return false;
+  }
+  rowEnd = pos;
+
+  // Nothing but a semicolon may follow the row, which rules out a
+  // second row or an ON CONFLICT style clause.
+  pos = skipSpace(statementText, rowEnd + 1);
+  if (pos < statementText.size() and statementText[pos] == ';') {
+    pos = skipSpace(statementText, pos + 1);
+  }
+  if (pos != statementText.size()) {
+    return false;
+  }
+  return not markers.empty() and markers.front() > rowBegin and
+         markers.back() < rowEnd;
+}
+
+void appendWithParameters(std::string& output,
+                          std::string_view statementText,
+                          size_t begin,
+                          size_t end,
+                          const std::vector<size_t>& markers,
+                          std::span<const std::pmr::string> literals) {
+  size_t literalIndex = 0;
+  size_t copiedTo     = begin;
+  for (size_t marker : markers) {
+    if (marker < begin) {
+      continue;
+    }
+    if (marker >= end) {
+      break;
+    }
+    output.append(statementText.substr(copiedTo, marker - copiedTo));
+    output.append(literals[literalIndex++]);
+    copiedTo = marker + 1;
+  }
+  output.append(statementText.substr(copiedTo, end - copiedTo));
+}
+
+std::string normalizeStatementText(std::string_view statementText) {
+  std::string normalized;
+  normalized.reserve(statementText.size());
+  bool pendingSpace = false;
+  size_t pos        = 0;
+  while (pos < statementText.size()) {
+    char c      = statementText[pos];
+    size_t next = skipNonCode(statementText, pos);
+    if (next != pos and (c == '\'' or c == '"')) {
+      if (pendingSpace and not normalized.empty()) {
+        normalized.push_back(' ');
+      }
+      pendingSpace = false;
+      normalized.append(statementText.substr(pos, next - pos));
+      pos = next;
+    } else if (next != pos or std::isspace(static_cast<unsigned char>(c))) {
+      // Comments separate tokens the same way whitespace does.
+      pendingSpace = true;
+      pos          = next != pos ? next : pos + 1;
+    } else {
+      if (pendingSpace and not normalized.empty()) {
+        normalized.push_back(' ');
+      }
+      pendingSpace = false;
+      normalized.push_back(c);
+      pos++;
+    }
+  }
+  while (not normalized.empty() and
+         (normalized.back() == ';' or normalized.back() == ' ')) {
+    normalized.pop_back();
+  }
+  return normalized;
+}
+
+bool isReadOnlyStatement(std::string_view statementText) {
+  size_t pos = skipSpace(statementText, 0);
+  while (pos < statementText.size() and statementText[pos] == '(') {
+    pos = skipSpace(statementText, pos + 1);
+  }
+  return isKeywordAt(statementText, pos, "SELECT") or
+         isKeywordAt(statementText, pos, "WITH") or
+         isKeywordAt(statementText, pos, "VALUES") or
+         isKeywordAt(statementText, pos, "TABLE");
+}
+
+bool addRowLimit(std::string_view statementText,
+                 uint64_t maxRows,
+                 std::string& limitedText) {
+  size_t pos = skipSpace(statementText, 0);
+  if (not isKeywordAt(statementText, pos, "SELECT") and
+      not isKeywordAt(statementText, pos, "WITH")) {
+    return false;
+  }
+  // Only the clauses outside of any parentheses belong to the query
+  // itself. A LIMIT in a subquery doesn't limit the result.
+  int depth = 0;
+  while (pos < statementText.size()) {
+    size_t next = skipNonCode(statementText, pos);
+    if (next != pos) {
+      pos = next;
+      continue;
+    }
+    char c = statementText[pos];
+    if (c == '(') {
+      depth++;
+    } else if (c == ')') {
+      depth--;
+    } else if (depth == 0 and
+               (c == ';' or isKeywordAt(statementText, pos, "LIMIT") or
+                isKeywordAt(statementText, pos, "FETCH"))) {
+      // A semicolon can only end the statement. Anything after it is
+      // more than one statement, which is left alone.
+      if (c != ';' or
+          skipSpace(statementText, pos + 1) < statementText.size()) {
+        return false;
+      }
+    }
+    pos++;
+  }
+  // Normalizing drops trailing comments and semicolons, which would
+  // otherwise swallow the LIMIT or end the statement before it.
+  limitedText = normalizeStatementText(statementText) + " LIMIT " +
+                std::to_string(maxRows);
+  return true;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+Find the offsets of the ? parameter markers in a SQL statement. Question
+marks inside string literals, quoted identifiers and comments are not
+markers and are skipped.
+*/
+std::vector<size_t> findParameterMarkers(std::string_view statementText);
+
+/*
+Check if a statement is an INSERT whose only parameter markers are in
+a single VALUES row at the very end, like
+  INSERT INTO t (a, b) VALUES (?, ?)
+If so, set the offsets of the row's opening and closing parentheses.
+Such a statement can take many rows of parameters in one statement by
+repeating the row.
+*/
+bool findInsertValuesRow(std::string_view statementText,
+                         const std::vector<size_t>& markers,
+                         size_t& rowBegin,
+                         size_t& rowEnd);
+
+/*
+Append statementText[begin, end) to output, replacing the markers in
+that range with literals, in order. Markers before begin consume no
+literals, so the markers passed in should start at begin.
+*/
+void appendWithParameters(std::string& output,
+                          std::string_view statementText,
+                          size_t begin,
+                          size_t end,
+                          const std::vector<size_t>& markers,
+                          std::span<const std::pmr::string> literals);
+
+/*
+Normalize a statement's text for comparing statements: comments and
+runs of whitespace become a single space, and leading and trailing
+whitespace and semicolons are dropped. String literals and quoted
+identifiers are left exactly as they are.
+*/
+std::string normalizeStatementText(std::string_view statementText);
+
+/*
+Check if a statement only reads data: a query starting with SELECT,
+WITH, VALUES or TABLE, possibly in parentheses.
+*/
+bool isReadOnlyStatement(std::string_view statementText);
+
+/*
+Build a copy of a query that returns at most maxRows rows, by adding a
+LIMIT clause. This only works for a single SELECT, possibly with a WITH
+clause, that doesn't already end with LIMIT or FETCH. Returns false for
+anything else, in which case the query has to be stopped some other way.
+*/
+bool addRowLimit(std::string_view statementText,
+                 uint64_t maxRows,
+                 std::string& limitedText);
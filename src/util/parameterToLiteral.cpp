@@ -0,0 +1,394 @@
+#include "parameterToLiteral.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <type_traits>
+
+#include "unicodeTranscoder.hpp"
+
+size_t cDataTypeSize(SQLSMALLINT cDataType) {
+  switch (cDataType) {
+    case SQL_C_BIT:
+    case SQL_C_TINYINT:
+    case SQL_C_STINYINT:
+    case SQL_C_UTINYINT:
+      return 1;
+    case SQL_C_SHORT:
+    case SQL_C_SSHORT:
+    case SQL_C_USHORT:
+      return sizeof(SQLSMALLINT);
+    case SQL_C_LONG:
+    case SQL_C_SLONG:
+    case SQL_C_ULONG:
+      return sizeof(SQLINTEGER);
+    case SQL_BIGINT:
+    case SQL_C_SBIGINT:
+    case SQL_C_UBIGINT:
+      return sizeof(SQLBIGINT);
+    case SQL_C_FLOAT:
+      return sizeof(SQLREAL);
+    case SQL_C_DOUBLE:
+      return sizeof(SQLDOUBLE);
+    case SQL_C_NUMERIC:
+      return sizeof(SQL_NUMERIC_STRUCT);
+    case SQL_C_DATE:
+    case SQL_C_TYPE_DATE:
+      return sizeof(SQL_DATE_STRUCT);
+    case SQL_C_TIME:
+    case SQL_C_TYPE_TIME:
+      return sizeof(SQL_TIME_STRUCT);
+    case SQL_C_TIMESTAMP:
+    case SQL_C_TYPE_TIMESTAMP:
+      return sizeof(SQL_TIMESTAMP_STRUCT);
+    case SQL_C_GUID:
+      return sizeof(SQLGUID);
+    default:
+      return 0;
+  }
+}
+
+/*
+Work out how many bytes of a character or binary value to read. A
+null length pointer or SQL_NTS means the value is null terminated,
+in which case the terminator is searched for without reading past
+the buffer.
+*/
+static bool variableLength(const void* value,
+                           SQLLEN bufferLength,
+                           const SQLLEN* strLenOrIndPtr,
+                           size_t unitSize,
+                           size_t& length) {
+  if (strLenOrIndPtr and *strLenOrIndPtr != SQL_NTS) {
+    if (*strLenOrIndPtr < 0) {
+      return false;
+    }
+    length = static_cast<size_t>(*strLenOrIndPtr);
+    return true;
+  }
+  size_t maxUnits = SIZE_MAX;
+  if (bufferLength > 0) {
+    maxUnits = static_cast<size_t>(bufferLength) / unitSize;
+  }
+  length = 0;
+  if (unitSize == 1) {
+    const char* text = static_cast<const char*>(value);
+    while (length < maxUnits and text[length] != '\0') {
+      length++;
+    }
+  } else {
+    const char16_t* text = static_cast<const char16_t*>(value);
+    while (length < maxUnits and text[length] != u'\0') {
+      length++;
+    }
+    length *= unitSize;
+  }
+  return true;
+}
+
+template <typename T>
+static void numberToText(const void* value, std::pmr::string& text) {
+  T number;
+  std::memcpy(&number, value, sizeof(T));
+  if constexpr (std::is_floating_point_v<T>) {
+    if (std::isnan(number)) {
+      text.assign("NaN");
+      return;
+    }
+    if (std::isinf(number)) {
+      text.assign(number > 0 ? "Infinity" : "-Infinity");
+      return;
+    }
+  }
+  char scratch[32];
+  std::to_chars_result result =
+      std::to_chars(scratch, scratch + sizeof(scratch), number);
+  text.assign(scratch, result.ptr);
+}
+
+/*
+SQL_NUMERIC_STRUCT holds the unscaled value as a 128 bit little endian
+integer. Peel decimal digits off it by long division, then place the
+decimal point according to the scale.
+*/
+static void numericToText(const SQL_NUMERIC_STRUCT& numeric,
+                          std::pmr::string& digits) {
+  unsigned char magnitude[SQL_MAX_NUMERIC_LEN];
+  std::memcpy(magnitude, numeric.val, SQL_MAX_NUMERIC_LEN);
+  digits.clear();
+  bool isZero = false;
+  while (not isZero) {
+    unsigned int remainder = 0;
+    isZero                 = true;
+    for (int i = SQL_MAX_NUMERIC_LEN - 1; i >= 0; i--) {
+      unsigned int current = (remainder << 8) | magnitude[i];
+      magnitude[i]         = static_cast<unsigned char>(current / 10);
+      remainder            = current % 10;
+      if (magnitude[i] != 0) {
+        isZero = false;
+      }
+    }
+    digits.insert(digits.begin(), static_cast<char>('0' + remainder));
+  }
+
+  int scale = numeric.scale;
+  if (scale < 0) {
+    digits.append(static_cast<size_t>(-scale), '0');
+  } else if (scale > 0) {
+    if (digits.size() <= static_cast<size_t>(scale)) {
+      digits.insert(0, static_cast<size_t>(scale) - digits.size() + 1, '0');
+    }
+    digits.insert(digits.size() - static_cast<size_t>(scale), 1, '.');
+  }
+  // The sign field is 1 for positive values and 0 for negative ones.
+  if (numeric.sign == 0) {
+    digits.insert(digits.begin(), '-');
+  }
+}
+
+static void appendTimeOfDay(SQLUSMALLINT hour,
+                            SQLUSMALLINT minute,
+                            SQLUSMALLINT second,
+                            SQLUINTEGER fraction,
+                            std::pmr::string& text) {
+  std::format_to(
+      std::back_inserter(text), "{:02}:{:02}:{:02}", hour, minute, second);
+  if (fraction > 0) {
+    // The fraction is in nanoseconds. Trailing zeros would only make
+    // the literal's precision larger than it needs to be.
+    char nanos[9];
+    std::format_to_n(nanos, sizeof(nanos), "{:09}", fraction);
+    size_t length = sizeof(nanos);
+    while (nanos[length - 1] == '0') {
+      length--;
+    }
+    text.push_back('.');
+    text.append(nanos, length);
+  }
+}
+
+/*
+Read the bound value into text, which for character types is just the
+characters themselves. Returns false if the C type is not supported.
+Everything but wide characters is written straight into text, so the
+value takes no memory other than text's.
+*/
+static bool valueToText(SQLSMALLINT cDataType,
+                        const void* value,
+                        SQLLEN bufferLength,
+                        const SQLLEN* strLenOrIndPtr,
+                        std::pmr::string& text) {
+  text.clear();
+  switch (cDataType) {
+    case SQL_C_CHAR:
+    case SQL_C_BINARY: {
+      size_t length = 0;
+      if (not variableLength(value, bufferLength, strLenOrIndPtr, 1, length)) {
+        return false;
+      }
+      text.assign(static_cast<const char*>(value), length);
+      return true;
+    }
+    case SQL_C_WCHAR: {
+      size_t length = 0;
+      if (not variableLength(value,
+                             bufferLength,
+                             strLenOrIndPtr,
+                             sizeof(char16_t),
+                             length)) {
+        return false;
+      }
+      text.assign(utf16ToUtf8(static_cast<const char16_t*>(value),
+                              length / sizeof(char16_t)));
+      return true;
+    }
+    case SQL_C_BIT:
+    case SQL_C_UTINYINT:
+      numberToText<unsigned char>(value, text);
+      return true;
+    case SQL_C_TINYINT:
+    case SQL_C_STINYINT:
+      numberToText<signed char>(value, text);
+      return true;
+    case SQL_C_SHORT:
+    case SQL_C_SSHORT:
+      numberToText<SQLSMALLINT>(value, text);
+      return true;
+    case SQL_C_USHORT:
+      numberToText<SQLUSMALLINT>(value, text);
+      return true;
+    case SQL_C_LONG:
+    case SQL_C_SLONG:
+      numberToText<SQLINTEGER>(value, text);
+      return true;
+    case SQL_C_ULONG:
+      numberToText<SQLUINTEGER>(value, text);
+      return true;
+    case SQL_BIGINT:
+    case SQL_C_SBIGINT:
+      numberToText<SQLBIGINT>(value, text);
+      return true;
+    case SQL_C_UBIGINT:
+      numberToText<SQLUBIGINT>(value, text);
+      return true;
+    case SQL_C_FLOAT:
+      numberToText<SQLREAL>(value, text);
+      return true;
+    case SQL_C_DOUBLE:
+      numberToText<SQLDOUBLE>(value, text);
+      return true;
+    case SQL_C_NUMERIC: {
+      SQL_NUMERIC_STRUCT numeric;
+      std::memcpy(&numeric, value, sizeof(numeric));
+      numericToText(numeric, text);
+      return true;
+    }
+    case SQL_C_DATE:
+    case SQL_C_TYPE_DATE: {
+      SQL_DATE_STRUCT date;
+      std::memcpy(&date, value, sizeof(date));
+      std::format_to(std::back_inserter(text),
+                     "{:04}-{:02}-{:02}",
+                     date.year,
+                     date.month,
+                     date.day);
+      return true;
+    }
+    case SQL_C_TIME:
+    case SQL_C_TYPE_TIME: {
+      SQL_TIME_STRUCT time;
+      std::memcpy(&time, value, sizeof(time));
+      appendTimeOfDay(time.hour, time.minute, time.second, 0, text);
+      return true;
+    }
+    case SQL_C_TIMESTAMP:
+    case SQL_C_TYPE_TIMESTAMP: {
+      SQL_TIMESTAMP_STRUCT ts;
+      std::memcpy(&ts, value, sizeof(ts));
+      std::format_to(std::back_inserter(text),
+                     "{:04}-{:02}-{:02} ",
+                     ts.year,
+                     ts.month,
+                     ts.day);
+      appendTimeOfDay(ts.hour, ts.minute, ts.second, ts.fraction, text);
+      return true;
+    }
+    case SQL_C_GUID: {
+      SQLGUID guid;
+      std::memcpy(&guid, value, sizeof(guid));
+      std::format_to(std::back_inserter(text),
+                     "{:08x}-{:04x}-{:04x}-{:02x}{:02x}-",
+                     static_cast<uint32_t>(guid.Data1),
+                     guid.Data2,
+                     guid.Data3,
+                     guid.Data4[0],
+                     guid.Data4[1]);
+      for (int i = 2; i < 8; i++) {
+        std::format_to(std::back_inserter(text), "{:02x}", guid.Data4[i]);
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+/*
+The type named in front of a quoted literal for each SQL type, or
+nullptr for the character types, which are plain string literals.
+*/
+static const char* literalTypeName(SQLSMALLINT sqlDataType) {
+  switch (sqlDataType) {
+    case SQL_BIT:
+      return "BOOLEAN";
+    case SQL_TINYINT:
+      return "TINYINT";
+    case SQL_SMALLINT:
+      return "SMALLINT";
+    case SQL_INTEGER:
+      return "INTEGER";
+    case SQL_BIGINT:
+      return "BIGINT";
+    case SQL_REAL:
+      return "REAL";
+    case SQL_FLOAT:
+    case SQL_DOUBLE:
+      return "DOUBLE";
+    case SQL_DECIMAL:
+    case SQL_NUMERIC:
+      return "DECIMAL";
+    case SQL_DATE:
+    case SQL_TYPE_DATE:
+      return "DATE";
+    case SQL_TIME:
+    case SQL_TYPE_TIME:
+      return "TIME";
+    case SQL_TIMESTAMP:
+    case SQL_TYPE_TIMESTAMP:
+      return "TIMESTAMP";
+    case SQL_GUID:
+      return "UUID";
+    default:
+      return nullptr;
+  }
+}
+
+static bool isBinarySqlType(SQLSMALLINT sqlDataType) {
+  return sqlDataType == SQL_BINARY or sqlDataType == SQL_VARBINARY or
+         sqlDataType == SQL_LONGVARBINARY;
+}
+
+bool parameterToLiteral(SQLSMALLINT cDataType,
+                        SQLSMALLINT sqlDataType,
+                        const void* value,
+                        SQLLEN bufferLength,
+                        const SQLLEN* strLenOrIndPtr,
+                        std::pmr::string& literal) {
+  if (strLenOrIndPtr and *strLenOrIndPtr == SQL_NULL_DATA) {
+    literal = "NULL";
+    return true;
+  }
+  if (not value) {
+    return false;
+  }
+  // Raw bytes only go into a binary literal. In a string literal they
+  // could carry NULs or invalid UTF-8.
+  if (cDataType == SQL_C_BINARY and not isBinarySqlType(sqlDataType)) {
+    return false;
+  }
+
+  // The value's text comes from the same memory as the literal.
+  std::pmr::string text(literal.get_allocator());
+  if (not valueToText(cDataType, value, bufferLength, strLenOrIndPtr, text)) {
+    return false;
+  }
+
+  if (isBinarySqlType(sqlDataType)) {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    literal.assign("X'");
+    for (unsigned char byte : text) {
+      literal.push_back(HEX_DIGITS[byte >> 4]);
+      literal.push_back(HEX_DIGITS[byte & 0x0F]);
+    }
+    literal.push_back('\'');
+    return true;
+  }
+
+  literal.clear();
+  if (const char* typeName = literalTypeName(sqlDataType)) {
+    literal.append(typeName).push_back(' ');
+  }
+  // Doubling quotes is the only escaping a Trino string literal has.
+  literal.push_back('\'');
+  for (char c : text) {
+    if (c == '\'') {
+      literal.push_back('\'');
+    }
+    literal.push_back(c);
+  }
+  literal.push_back('\'');
+  return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "windowsLean.hpp"
+#include <sql.h>
+#include <sqlext.h>
+
+#include <memory_resource>
+#include <string>
+
+/*
+The size of one value of a fixed-length C type, or zero for the
+variable-length character and binary types. Parameter arrays bound
+column-wise step through values of fixed-length types by this size.
+*/
+size_t cDataTypeSize(SQLSMALLINT cDataType);
+
+/*
+Render a bound parameter value as a Trino SQL literal, such as
+'it''s', DATE '2024-01-31' or X'CAFE'.
+
+The value is read as cDataType and written as a literal of the SQL
+type the application declared for the parameter. Everything except
+binary data and NULL is written as a quoted string, with a type
+prefix for non-character SQL types, so no value can break out of
+its literal. The literal, and the value's text on the way to it, are
+built in the literal's own memory resource.
+
+Returns false if the value can't be read, such as for an unknown
+C type or a data-at-execution length, or if it's SQL_C_BINARY bound
+to anything but a binary SQL type.
+*/
+bool parameterToLiteral(SQLSMALLINT cDataType,
+                        SQLSMALLINT sqlDataType,
+                        const void* value,
+                        SQLLEN bufferLength,
+                        const SQLLEN* strLenOrIndPtr,
+                        std::pmr::string& literal);
@@ -1,13 +1,21 @@
 #include "rowToBuffer.hpp"
 
 #include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
-#include <iomanip>
-#include <sstream>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
+#include "b64decoder.hpp"
 #include "dateAndTimeUtils.hpp"
 #include "decimalHelper.hpp"
+#include "guidParser.hpp"
+#include "unicodeTranscoder.hpp"
 #include "writeLog.hpp"
 
 ColumnToBufferStatus::ColumnToBufferStatus(bool isSuccess,
@@ -16,16 +24,177 @@ ColumnToBufferStatus::ColumnToBufferStatus(bool isSuccess,
   this->isVariableLength = isVariableLength;
 }
 
-SQLRETURN copyStrToBuffer(const json& rowData,
+// Big enough for any int64, uint64, or shortest round-trip double.
+constexpr size_t SCALAR_TEXT_SCRATCH_SIZE = 32;
+
+/*
+Get a text view of a scalar JSON value without allocating. Strings
+are viewed in place. Numbers and booleans are rendered into the
+caller's scratch buffer with std::to_chars, so the view is only valid
+as long as the scratch buffer is. Either way, the view's data is null
+terminated.
+
+Booleans render as "1" and "0", which is what the ODBC spec asks for
+when converting SQL_BIT to character data. Reals arrive as JSON
+doubles, so they're narrowed back to float first to avoid printing
+digits the column never had.
+*/
+static std::string_view scalarToText(const json& value,
+                                     SQLSMALLINT odbcDataType,
+                                     char* scratch) {
+  char* scratchEnd = scratch + SCALAR_TEXT_SCRATCH_SIZE;
+  std::to_chars_result result{};
+  switch (value.type()) {
+    case json::value_t::string:
+      return value.get_ref<const std::string&>();
+    case json::value_t::boolean:
+      return value.get<bool>() ? "1" : "0";
+    case json::value_t::number_integer:
+      result =
+          std::to_chars(scratch, scratchEnd, value.get<json::number_integer_t>());
+      break;
+    case json::value_t::number_unsigned:
+      result = std::to_chars(
+          scratch, scratchEnd, value.get<json::number_unsigned_t>());
+      break;
+    case json::value_t::number_float:
+      if (odbcDataType == SQL_REAL) {
+        result = std::to_chars(
+            scratch, scratchEnd, static_cast<float>(value.get<double>()));
+      } else {
+        result = std::to_chars(scratch, scratchEnd, value.get<double>());
+      }
+      break;
+    default:
+      throw std::invalid_argument(
+          "Cannot convert a value of JSON type " +
+          std::string(value.type_name()) + " to character data");
+  }
+  if (result.ec != std::errc() or result.ptr == scratchEnd) {
+    throw std::invalid_argument("Could not render value as text");
+  }
+  *result.ptr = '\0';
+  return std::string_view(scratch, result.ptr - scratch);
+}
+
+// SQL_NUMERIC_STRUCT holds up to 38 decimal digits.
+constexpr int MAX_NUMERIC_DIGITS = 38;
+// Big enough for 38 digits after "-0.", and a null terminator.
+constexpr size_t DECIMAL_TEXT_SCRATCH_SIZE = 48;
+
+/*
+Render a floating point value in fixed notation for SQL_C_NUMERIC, and
+set the precision and scale to the digits written, since a double has
+no scale of its own. The shortest round trip form is used where its
+fraction fits in 38 digits. Only values below one can need more, and
+those are rounded to 38. Values with more than 38 whole digits are out
+of range.
+*/
+static std::string_view floatToDecimalText(const json& value,
+                                           SQLSMALLINT odbcDataType,
+                                           char* scratch,
+                                           SQLCHAR& precision,
+                                           SQLCHAR& scale) {
+  double number = value.get<double>();
+  if (not std::isfinite(number) or std::fabs(number) >= 1e38) {
+    throw std::out_of_range("Numeric value out of range: " + value.dump());
+  }
+  char* scratchEnd = scratch + DECIMAL_TEXT_SCRATCH_SIZE;
+  auto render      = [scratch, scratchEnd](auto real) {
+    std::to_chars_result result =
+        std::to_chars(scratch, scratchEnd, real, std::chars_format::fixed);
+    if (result.ec == std::errc() and result.ptr != scratchEnd and
+        result.ptr - std::find(scratch, result.ptr, '.') <=
+            MAX_NUMERIC_DIGITS + 1) {
+      return result.ptr;
+    }
+    result = std::to_chars(scratch,
+                           scratchEnd,
+                           real,
+                           std::chars_format::fixed,
+                           MAX_NUMERIC_DIGITS);
+    if (result.ec != std::errc() or result.ptr == scratchEnd) {
+      throw std::invalid_argument("Could not render value as text");
+    }
+    while (result.ptr[-1] == '0') {
+      result.ptr--;
+    }
+    if (result.ptr[-1] == '.') {
+      result.ptr--;
+    }
+    return result.ptr;
+  };
+  // Reals are narrowed back to float, as in scalarToText.
+  char* end = odbcDataType == SQL_REAL ? render(static_cast<float>(number))
+                                       : render(number);
+  *end = '\0';
+
+  std::string_view text(scratch, end - scratch);
+  size_t sign           = text.starts_with('-') ? 1 : 0;
+  size_t dot            = std::min(text.find('.'), text.size());
+  bool belowOne         = text.substr(sign, dot - sign) == "0";
+  size_t wholeDigits    = belowOne ? 0 : dot - sign;
+  size_t fractionDigits = dot == text.size() ? 0 : text.size() - dot - 1;
+
+  precision = static_cast<SQLCHAR>(
+      std::max<size_t>(wholeDigits + fractionDigits, 1));
+  scale = static_cast<SQLCHAR>(fractionDigits);
+  return text;
+}
+
+/*
+Parse text into an arithmetic type with std::from_chars. This covers
+the case of an application binding a numeric C type to a varchar or
+decimal column. A fractional part is dropped when parsing into an
+integer type, the way a cast would, but any other trailing characters
+are an error.
+*/
+template <typename T>
+static T textToNumber(std::string_view text) {
+  const char* first = text.data();
+  const char* last  = text.data() + text.size();
+  // from_chars doesn't accept a leading plus sign.
+  if (first != last and *first == '+') {
+    first++;
+  }
+  T value{};
+  std::from_chars_result result = std::from_chars(first, last, value);
+  if (result.ec == std::errc::result_out_of_range) {
+    throw std::out_of_range("Numeric value out of range: " +
+                            std::string(text));
+  }
+  bool valid = result.ec == std::errc();
+  if constexpr (std::is_integral_v<T>) {
+    if (valid and result.ptr != last and *result.ptr == '.') {
+      const char* digit = result.ptr + 1;
+      while (digit != last and *digit >= '0' and *digit <= '9') {
+        digit++;
+      }
+      result.ptr = digit;
+    }
+  }
+  if (not valid or result.ptr != last) {
+    throw std::invalid_argument("Invalid character value for cast: " +
+                                std::string(text));
+  }
+  return value;
+}
+
+SQLRETURN copyStrToBuffer(const json& cellData,
                           SQLULEN columnNumber,
+                          SQLSMALLINT odbcDataType,
                           void* buffer,
                           SQLLEN bufferLength,
                           SQLLEN* strLen_or_IndPtr,
-                          std::string cTypeName) {
+                          const char* cTypeName) {
   try {
-    std::string value = rowData[columnNumber - 1].get<std::string>();
+    char scratch[SCALAR_TEXT_SCRATCH_SIZE];
+    std::string_view value =
+        scalarToText(cellData, odbcDataType, scratch);
     if (getLogLevel() <= LL_TRACE) {
-      WriteLog(LL_TRACE, "  Detected bound " + cTypeName + " : " + value);
+      WriteLog(LL_TRACE,
+               "  Detected bound " + std::string(cTypeName) + " : " +
+                   std::string(value));
     }
 
     // We need to be sure not to copy past the end of the buffer.
@@ -35,7 +204,7 @@ SQLRETURN copyStrToBuffer(const json& rowData,
     }
 
     // Copy characters into the buffer up to the calculated end.
-    std::memcpy(buffer, value.c_str(), copyLength);
+    std::memcpy(buffer, value.data(), copyLength);
 
     // Don't forget a null terminating char at the end.
     if (bufferLength > 0) {
@@ -48,37 +217,189 @@ SQLRETURN copyStrToBuffer(const json& rowData,
     return SQL_SUCCESS;
   } catch (const std::exception& e) {
     WriteLog(LL_ERROR,
-             "  ERROR: extracting " + cTypeName + " value for column index: " +
+             "  ERROR: extracting " + std::string(cTypeName) +
+                 " value for column index: " + std::to_string(columnNumber) +
+                 " - " + e.what());
+    return SQL_ERROR;
+  }
+}
+
+
+SQLRETURN copyWStrToBuffer(const json& cellData,
+                           SQLULEN columnNumber,
+                           SQLSMALLINT odbcDataType,
+                           void* buffer,
+                           SQLLEN bufferLength,
+                           SQLLEN* strLen_or_IndPtr) {
+  try {
+    char scratch[SCALAR_TEXT_SCRATCH_SIZE];
+    std::string_view value =
+        scalarToText(cellData, odbcDataType, scratch);
+    if (getLogLevel() <= LL_TRACE) {
+      WriteLog(LL_TRACE, "  Detected bound WCHAR : " + std::string(value));
+    }
+
+    // bufferLength is in bytes, but the transcoder works in code units.
+    // Reserve one unit for the null terminator.
+    bool hasRoom =
+        buffer and bufferLength >= static_cast<SQLLEN>(sizeof(SQLWCHAR));
+    size_t capacity = 0;
+    if (hasRoom) {
+      capacity = static_cast<size_t>(bufferLength) / sizeof(SQLWCHAR) - 1;
+    }
+    char16_t* output = reinterpret_cast<char16_t*>(buffer);
+    size_t required =
+        utf8ToUtf16(value.data(), value.size(), output, capacity);
+
+    if (hasRoom) {
+      size_t written = std::min(required, capacity);
+      // Don't leave half of a surrogate pair at the end of a truncated value.
+      if (written < required and written > 0 and
+          isHighSurrogate(output[written - 1])) {
+        written--;
+      }
+      output[written] = u'\0';
+    }
+
+    if (strLen_or_IndPtr) {
+      *strLen_or_IndPtr = static_cast<SQLLEN>(required * sizeof(SQLWCHAR));
+    }
+    return SQL_SUCCESS;
+  } catch (const std::exception& e) {
+    WriteLog(LL_ERROR,
+             "  ERROR: extracting WCHAR value for column index: " +
+                 std::to_string(columnNumber) + " - " + e.what());
+    return SQL_ERROR;
+  }
+}
+
+
+/*
+Copy binary data into the buffer, starting sourceOffset bytes into the
+value so that SQLGetData can return a large value in pieces. Trino
+sends varbinary values base64 encoded, and they're decoded straight
+into the buffer. For any other column the bytes of the text are used
+as they are.
+*/
+SQLRETURN copyBinaryToBuffer(const json& cellData,
+                             SQLULEN columnNumber,
+                             SQLSMALLINT odbcDataType,
+                             void* buffer,
+                             SQLLEN bufferLength,
+                             SQLLEN* strLen_or_IndPtr,
+                             SQLLEN sourceOffset) {
+  try {
+    std::string_view value =
+        cellData.get_ref<const std::string&>();
+    size_t offset   = static_cast<size_t>(sourceOffset);
+    size_t capacity = (buffer and bufferLength > 0)
+                          ? static_cast<size_t>(bufferLength)
+                          : 0;
+    unsigned char* output = static_cast<unsigned char*>(buffer);
+
+    size_t totalSize = 0;
+    if (odbcDataType == SQL_VARBINARY or odbcDataType == SQL_LONGVARBINARY) {
+      totalSize = base64DecodedSize(value);
+      if (capacity > 0) {
+        decodeBase64Range(value, offset, output, capacity);
+      }
+    } else {
+      totalSize = value.size();
+      if (capacity > 0 and offset < totalSize) {
+        std::memcpy(output,
+                    value.data() + offset,
+                    std::min(capacity, totalSize - offset));
+      }
+    }
+
+    if (strLen_or_IndPtr) {
+      // The length remaining from the offset, not the whole value.
+      *strLen_or_IndPtr =
+          static_cast<SQLLEN>(totalSize - std::min(offset, totalSize));
+    }
+    return SQL_SUCCESS;
+  } catch (const std::exception& e) {
+    WriteLog(LL_ERROR,
+             "  ERROR: extracting BINARY value for column index: " +
                  std::to_string(columnNumber) + " - " + e.what());
     return SQL_ERROR;
   }
 }
 
 
+/*
+Convert a JSON number into an arithmetic type. json::get would cast it
+and wrap around, or worse, when the value doesn't fit, so the range is
+checked first. As with text, a fractional part is dropped when
+converting into an integer type.
+*/
 template <typename T>
-SQLRETURN copyFixedLenToBuffer(const json& rowData,
-                               SQLULEN columnNumber,
-                               void* buffer,
-                               SQLLEN* strLen_or_IndPtr,
-                               std::string cTypeName) {
+static T jsonToNumber(const json& value) {
+  if constexpr (std::is_integral_v<T>) {
+    if (value.is_number_unsigned()) {
+      uint64_t number = value.get<uint64_t>();
+      if (std::in_range<T>(number)) {
+        return static_cast<T>(number);
+      }
+    } else if (value.is_number_integer()) {
+      int64_t number = value.get<int64_t>();
+      if (std::in_range<T>(number)) {
+        return static_cast<T>(number);
+      }
+    } else if (value.is_number_float()) {
+      double number = std::trunc(value.get<double>());
+      // The upper bound is exclusive, since the maximum of a 64 bit type
+      // isn't a double but the next number up is. NaN fails both tests.
+      if (number >= static_cast<double>(std::numeric_limits<T>::lowest()) and
+          number < static_cast<double>(std::numeric_limits<T>::max()) + 1.0) {
+        return static_cast<T>(number);
+      }
+    } else {
+      return value.get<T>();
+    }
+  } else {
+    double number = value.get<double>();
+    if (not std::isfinite(number) or
+        std::abs(number) <= std::numeric_limits<T>::max()) {
+      return static_cast<T>(number);
+    }
+  }
+  throw std::out_of_range("Numeric value out of range: " + value.dump());
+}
+
+
+template <typename T>
+ColumnToBufferStatus copyFixedLenToBuffer(const json& cellData,
+                                          SQLULEN columnNumber,
+                                          void* buffer,
+                                          SQLLEN* strLen_or_IndPtr,
+                                          const char* cTypeName) {
   try {
-    const json& jsonValue = rowData[columnNumber - 1];
-    T value               = jsonValue.get<T>();
+    const json& jsonValue = cellData;
+    // Decimals, and anything an application binds to a varchar
+    // column, arrive as JSON strings rather than numbers.
+    T value = jsonValue.is_string()
+                  ? textToNumber<T>(jsonValue.get_ref<const std::string&>())
+                  : jsonToNumber<T>(jsonValue);
     if (getLogLevel() <= LL_TRACE) {
       WriteLog(LL_TRACE,
-               "  Detected bound " + cTypeName + " : " + std::to_string(value));
+               "  Detected bound " + std::string(cTypeName) + " : " +
+                   std::to_string(value));
     }
     *reinterpret_cast<T*>(buffer) = value;
     if (strLen_or_IndPtr) {
       *strLen_or_IndPtr = sizeof(T);
     }
-    return SQL_SUCCESS;
+    return ColumnToBufferStatus(true, false);
 
   } catch (const std::exception& e) {
     WriteLog(LL_ERROR,
-             "  ERROR: extracting " + cTypeName + " value for column index: " +
-                 std::to_string(columnNumber) + " - " + e.what());
-    return SQL_ERROR;
+             "  ERROR: extracting " + std::string(cTypeName) +
+                 " value for column index: " + std::to_string(columnNumber) +
+                 " - " + e.what());
+    ColumnToBufferStatus status(false, false);
+    status.isOutOfRange = dynamic_cast<const std::out_of_range*>(&e);
+    return status;
   }
 }
 
@@ -233,7 +554,7 @@ SQLRETURN copyDecimalToBuffer(SQLULEN columnNumber,
     // Last, set the val array on the struct in hex format.
     std::string stringValue     = wholePartStr + fractionalPartStr;
     std::string lsbEncodedValue = lsbDecimalEncoder(stringValue);
-    size_t valueLength          = std::max(lsbEncodedValue.size(),
+    size_t valueLength          = std::min(lsbEncodedValue.size(),
                                   static_cast<size_t>(SQL_MAX_NUMERIC_LEN));
     std::fill_n(numeric->val, SQL_MAX_NUMERIC_LEN, '\0');
     std::memcpy(numeric->val, lsbEncodedValue.c_str(), valueLength);
@@ -248,114 +569,113 @@ SQLRETURN copyDecimalToBuffer(SQLULEN columnNumber,
 }
 
 SQLRETURN copyGuidToBuffer(SQLULEN columnNumber,
-                           const char* valueChars,
+                           std::string_view value,
                            void* buffer,
                            SQLLEN bufferLength,
                            SQLLEN* strLen_or_IndPtr) {
-  try {
-    if (strLen_or_IndPtr) {
-      // Sixteen bytes in a GUID.
-      *strLen_or_IndPtr = sizeof(SQLGUID);
-    }
-    std::stringstream ss(valueChars);
-    unsigned int data1        = 0;
-    unsigned short data2      = 0;
-    unsigned short data3      = 0;
-    unsigned short data4Part1 = 0;
-    int64_t data4Part2        = 0;
-
-    char dash;
-
-    // Parse the dword part.
-    ss >> std::hex >> data1 >> dash;
-    // Parse the first word part.
-    ss >> std::hex >> data2 >> dash;
-    // Parse the second word part.
-    ss >> std::hex >> data3 >> dash;
-    // Parse the first 4 characters of the last data component.
-    ss >> std::hex >> data4Part1 >> dash;
-    // Parse the last 12 bytes (6 hex characters) into the byte array
-    ss >> std::hex >> data4Part2;
-
-    // Combine the bits from the two different data4 parts
-    // into a combined byte array. To preserve correct endianness, we
-    // have to handle this one byte at a time.
-    unsigned char data4Combined[8];
-    // The first 4 chars (2 bytes)
-    data4Combined[0] = (data4Part1 >> 8) & 0xFF;
-    data4Combined[1] = (data4Part1 >> 0) & 0xFF;
-    // The last 12 chars (6 bytes)
-    data4Combined[2] = (data4Part2 >> 40) & 0xFF;
-    data4Combined[3] = (data4Part2 >> 32) & 0xFF;
-    data4Combined[4] = (data4Part2 >> 24) & 0xFF;
-    data4Combined[5] = (data4Part2 >> 16) & 0xFF;
-    data4Combined[6] = (data4Part2 >> 8) & 0xFF;
-    data4Combined[7] = (data4Part2 >> 0) & 0xFF;
-
-    SQLGUID* guid = reinterpret_cast<SQLGUID*>(buffer);
-    guid->Data1   = data1;
-    guid->Data2   = data2;
-    guid->Data3   = data3;
-    std::memcpy(guid->Data4, data4Combined, 8);
-
-    return SQL_SUCCESS;
-  } catch (const std::exception& e) {
+  if (strLen_or_IndPtr) {
+    // Sixteen bytes in a GUID.
+    *strLen_or_IndPtr = sizeof(SQLGUID);
+  }
+  if (not parseGuid(value, *reinterpret_cast<SQLGUID*>(buffer))) {
     WriteLog(LL_ERROR,
              "  ERROR: extracting GUID for column index: " +
-                 std::to_string(columnNumber) + " - " + e.what());
+                 std::to_string(columnNumber) +
+                 " - invalid value: " + std::string(value));
     return SQL_ERROR;
   }
+  return SQL_SUCCESS;
 }
 
 ColumnToBufferStatus columnToBuffer(SQLSMALLINT cDataType,
                                     SQLSMALLINT odbcDataType,
-                                    const json& rowData,
+                                    const json& cellData,
                                     SQLULEN columnNumber,
                                     void* buffer,
                                     SQLLEN bufferLength,
                                     SQLLEN* strLen_or_IndPtr,
                                     SQLCHAR precision,
-                                    SQLCHAR scale) {
+                                    SQLCHAR scale,
+                                    SQLLEN sourceOffset) {
+  /*
+  The conversion is driven by the C type the application asked for and
+  the JSON type Trino sent, which follows from the column's ODBC type.
+  Numbers and booleans render to text, text parses to numbers, and
+  dates and times are already text on the wire.
+  */
   switch (cDataType) {
     case SQL_C_CHAR: { // 1
-      // Char pointers are used in a bunch of different ways. How to use
-      // it might depend on the ODBC type. If we need to do something
-      // dynamically based on the SQL data type, this is where it would happen.
-      // For now, we're treating everything as a varchar. This seems to work
-      // for GUIDs and Decimals as well.
-      copyStrToBuffer(rowData,
-                      columnNumber,
-                      buffer,
-                      bufferLength,
-                      strLen_or_IndPtr,
-                      "CHAR");
-      return ColumnToBufferStatus(true, true);
+      SQLRETURN ret = copyStrToBuffer(cellData,
+                                      columnNumber,
+                                      odbcDataType,
+                                      buffer,
+                                      bufferLength,
+                                      strLen_or_IndPtr,
+                                      "CHAR");
+      return ColumnToBufferStatus(ret == SQL_SUCCESS, true);
+    }
+    case SQL_C_WCHAR: { // -8
+      // Trino sends text as UTF-8, so this is transcoded into UTF-16 code
+      // units on the way into the buffer. Lengths are reported in bytes.
+      SQLRETURN ret = copyWStrToBuffer(cellData,
+                                       columnNumber,
+                                       odbcDataType,
+                                       buffer,
+                                       bufferLength,
+                                       strLen_or_IndPtr);
+      return ColumnToBufferStatus(ret == SQL_SUCCESS, true);
+    }
+    case SQL_C_BINARY: { // -2
+      SQLRETURN ret = copyBinaryToBuffer(cellData,
+                                         columnNumber,
+                                         odbcDataType,
+                                         buffer,
+                                         bufferLength,
+                                         strLen_or_IndPtr,
+                                         sourceOffset);
+      return ColumnToBufferStatus(ret == SQL_SUCCESS, true);
     }
     case SQL_C_NUMERIC: { // 2
-      // Trino decimals return as strings, '123.456'
-      std::string value      = rowData[columnNumber - 1].get<std::string>();
-      const char* valueChars = value.c_str();
-      copyDecimalToBuffer(columnNumber,
-                          valueChars,
-                          buffer,
-                          bufferLength,
-                          strLen_or_IndPtr,
-                          precision,
-                          scale);
-
-      return ColumnToBufferStatus(true, false);
+      // Trino decimals return as strings, '123.456', but integer
+      // and floating point columns are JSON numbers.
+      char scratch[DECIMAL_TEXT_SCRATCH_SIZE];
+      SQLRETURN ret     = SQL_ERROR;
+      bool isOutOfRange = false;
+      try {
+        std::string_view value =
+            cellData.is_number_float()
+                ? floatToDecimalText(
+                      cellData, odbcDataType, scratch, precision, scale)
+                : scalarToText(cellData, odbcDataType, scratch);
+        ret = copyDecimalToBuffer(columnNumber,
+                                  value.data(),
+                                  buffer,
+                                  bufferLength,
+                                  strLen_or_IndPtr,
+                                  precision,
+                                  scale);
+      } catch (const std::exception& e) {
+        WriteLog(LL_ERROR,
+                 "  ERROR: extracting NUMERIC value for column index: " +
+                     std::to_string(columnNumber) + " - " + e.what());
+        isOutOfRange = dynamic_cast<const std::out_of_range*>(&e);
+      }
+      ColumnToBufferStatus status(ret == SQL_SUCCESS, false);
+      status.isOutOfRange = isOutOfRange;
+      return status;
     }
     case SQL_C_GUID: { // -11
       // Trino guids are strings, "00000000-0000-0000-0000-000000000000"
-      std::string value      = rowData[columnNumber - 1].get<std::string>();
-      const char* valueChars = value.c_str();
-      copyGuidToBuffer(
-          columnNumber, valueChars, buffer, bufferLength, strLen_or_IndPtr);
-      return ColumnToBufferStatus(true, false);
+      const std::string& value =
+          cellData.get_ref<const std::string&>();
+      SQLRETURN ret = copyGuidToBuffer(
+          columnNumber, value, buffer, bufferLength, strLen_or_IndPtr);
+      return ColumnToBufferStatus(ret == SQL_SUCCESS, false);
     }
     case SQL_C_DATE:        // 9
     case SQL_C_TYPE_DATE: { // 91
-      std::string value    = rowData[columnNumber - 1].get<std::string>();
+      const std::string& value =
+          cellData.get_ref<const std::string&>();
       SQL_DATE_STRUCT date = parseDate(value);
       copyDateToBuffer(
           columnNumber, date, buffer, bufferLength, strLen_or_IndPtr);
@@ -363,7 +683,8 @@ ColumnToBufferStatus columnToBuffer(SQLSMALLINT cDataType,
     }
     case SQL_C_TIME:        // 10
     case SQL_C_TYPE_TIME: { // 92
-      std::string value    = rowData[columnNumber - 1].get<std::string>();
+      const std::string& value =
+          cellData.get_ref<const std::string&>();
       SQL_TIME_STRUCT time = parseTime(value);
       copyTimeToBuffer(
           columnNumber, time, buffer, bufferLength, strLen_or_IndPtr);
@@ -371,7 +692,8 @@ ColumnToBufferStatus columnToBuffer(SQLSMALLINT cDataType,
     }
     case SQL_C_TIMESTAMP:        // 11
     case SQL_C_TYPE_TIMESTAMP: { // 93
-      std::string value         = rowData[columnNumber - 1].get<std::string>();
+      const std::string& value =
+          cellData.get_ref<const std::string&>();
       ParsedTimestamp timestamp = parseTimestamp(value);
       copyTimestampToBuffer(
           columnNumber, timestamp, buffer, bufferLength, strLen_or_IndPtr);
@@ -380,37 +702,47 @@ ColumnToBufferStatus columnToBuffer(SQLSMALLINT cDataType,
     case SQL_C_BIT:        // -7
     case SQL_C_TINYINT:    // -6
     case SQL_C_STINYINT: { // -26
-      copyFixedLenToBuffer<int8_t>(
-          rowData, columnNumber, buffer, strLen_or_IndPtr, "BIT/[S]TINYINT");
-      return ColumnToBufferStatus(true, false);
+      return copyFixedLenToBuffer<int8_t>(
+          cellData, columnNumber, buffer, strLen_or_IndPtr, "BIT/[S]TINYINT");
+    }
+    case SQL_C_UTINYINT: { // -28
+      return copyFixedLenToBuffer<uint8_t>(
+          cellData, columnNumber, buffer, strLen_or_IndPtr, "UTINYINT");
     }
     case SQL_C_SHORT:    // 5
     case SQL_C_SSHORT: { // -15
-      copyFixedLenToBuffer<int16_t>(
-          rowData, columnNumber, buffer, strLen_or_IndPtr, "SHORT/SSHORT");
-      return ColumnToBufferStatus(true, false);
+      return copyFixedLenToBuffer<int16_t>(
+          cellData, columnNumber, buffer, strLen_or_IndPtr, "SHORT/SSHORT");
+    }
+    case SQL_C_USHORT: { // -17
+      return copyFixedLenToBuffer<uint16_t>(
+          cellData, columnNumber, buffer, strLen_or_IndPtr, "USHORT");
     }
     case SQL_C_LONG:    // 4
     case SQL_C_SLONG: { // -16
-      copyFixedLenToBuffer<int32_t>(
-          rowData, columnNumber, buffer, strLen_or_IndPtr, "LONG/SLONG");
-      return ColumnToBufferStatus(true, false);
+      return copyFixedLenToBuffer<int32_t>(
+          cellData, columnNumber, buffer, strLen_or_IndPtr, "LONG/SLONG");
+    }
+    case SQL_C_ULONG: { // -18
+      return copyFixedLenToBuffer<uint32_t>(
+          cellData, columnNumber, buffer, strLen_or_IndPtr, "ULONG");
     }
     case SQL_BIGINT:      // -5
     case SQL_C_SBIGINT: { // -25
-      copyFixedLenToBuffer<int64_t>(
-          rowData, columnNumber, buffer, strLen_or_IndPtr, "BIGINT/SBIGINT");
-      return ColumnToBufferStatus(true, false);
+      return copyFixedLenToBuffer<int64_t>(
+          cellData, columnNumber, buffer, strLen_or_IndPtr, "BIGINT/SBIGINT");
+    }
+    case SQL_C_UBIGINT: { // -27
+      return copyFixedLenToBuffer<uint64_t>(
+          cellData, columnNumber, buffer, strLen_or_IndPtr, "UBIGINT");
     }
     case SQL_C_FLOAT: { // 7
-      copyFixedLenToBuffer<float>(
-          rowData, columnNumber, buffer, strLen_or_IndPtr, "FLOAT");
-      return ColumnToBufferStatus(true, false);
+      return copyFixedLenToBuffer<float>(
+          cellData, columnNumber, buffer, strLen_or_IndPtr, "FLOAT");
     }
     case SQL_C_DOUBLE: { // 8
-      copyFixedLenToBuffer<double>(
-          rowData, columnNumber, buffer, strLen_or_IndPtr, "DOUBLE");
-      return ColumnToBufferStatus(true, false);
+      return copyFixedLenToBuffer<double>(
+          cellData, columnNumber, buffer, strLen_or_IndPtr, "DOUBLE");
     }
     default: {
       WriteLog(LL_ERROR,
@@ -11,15 +11,18 @@ class ColumnToBufferStatus {
   public:
     bool isSuccess        = false;
     bool isVariableLength = false;
+    // The value couldn't be converted because it doesn't fit the C type.
+    bool isOutOfRange = false;
     ColumnToBufferStatus(bool isSuccess, bool isVariableLength);
 };
 
 ColumnToBufferStatus columnToBuffer(SQLSMALLINT cDataType,
                                     SQLSMALLINT odbcDataType,
-                                    const json& rowData,
+                                    const json& cellData,
                                     SQLULEN columnNumber,
                                     void* buffer,
                                     SQLLEN bufferLength,
                                     SQLLEN* strLen_or_IndPtr,
                                     SQLCHAR precision,
-                                    SQLCHAR scale);
+                                    SQLCHAR scale,
+                                    SQLLEN sourceOffset = 0);
@@ -1,5 +1,7 @@
 #include "stringFromChar.hpp"
 
+#include "unicodeTranscoder.hpp"
+
 
 std::string stringFromChar(unsigned char* text, long textLength) {
   // Sometimes textLength is the actual length. Other times it's
@@ -22,3 +24,16 @@ std::string stringFromChar(char* text, long textLength) {
 
   return std::string(reinterpret_cast<char*>(text), inputLength);
 }
+
+std::string stringFromChar(char16_t* text, long textLength) {
+  size_t inputLength = 0;
+  if (textLength == CHAR_IS_NTS) {
+    while (text[inputLength] != u'\0') {
+      inputLength++;
+    }
+  } else {
+    inputLength = static_cast<size_t>(textLength);
+  }
+
+  return utf16ToUtf8(text, inputLength);
+}
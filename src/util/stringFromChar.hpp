@@ -7,3 +7,7 @@ constexpr long CHAR_IS_NTS = -3;
 
 std::string stringFromChar(char* text, long textLength);
 std::string stringFromChar(unsigned char* text, long textLength);
+
+// Wide (UTF-16) text from the W entry points, converted to UTF-8.
+// The length is a count of characters, not bytes.
+std::string stringFromChar(char16_t* text, long textLength);
@@ -0,0 +1,236 @@
+#include "unicodeTranscoder.hpp"
+
+#include <cstdint>
+
+// Every x86 and x64 Windows target supports SSE2, so this is only
+// excluded for ARM builds, which fall back to the scalar loops.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TRANSCODER_USE_SSE2
+#endif
+
+constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+/*
+Write a single code unit if there is room for it. Either way, count it
+so the caller learns the total length of the converted string.
+*/
+static inline void emitUnit(char16_t unit,
+                            char16_t* output,
+                            size_t outputCapacity,
+                            size_t& written) {
+  if (written < outputCapacity) {
+    output[written] = unit;
+  }
+  written++;
+}
+
+static inline void emitCodePoint(char32_t codePoint,
+                                 char16_t* output,
+                                 size_t outputCapacity,
+                                 size_t& written) {
+  if (codePoint < 0x10000) {
+    emitUnit(static_cast<char16_t>(codePoint), output, outputCapacity, written);
+  } else {
+    codePoint -= 0x10000;
+    emitUnit(static_cast<char16_t>(0xD800 + (codePoint >> 10)),
+             output,
+             outputCapacity,
+             written);
+    emitUnit(static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF)),
+             output,
+             outputCapacity,
+             written);
+  }
+}
+
+static inline bool isContinuation(unsigned char c) {
+  return (c & 0xC0) == 0x80;
+}
+
+/*
+Decode one multi-byte UTF-8 sequence starting at in[i]. Advances i past
+the sequence and returns the code point, or returns U+FFFD and advances
+by a single byte if the sequence is malformed, overlong, or encodes a
+surrogate.
+*/
+static char32_t decodeMultiByte(const unsigned char* in,
+                                size_t inputLength,
+                                size_t& i) {
+  unsigned char lead = in[i];
+  size_t remaining   = inputLength - i;
+
+  if (lead >= 0xC2 and lead <= 0xDF) {
+    if (remaining >= 2 and isContinuation(in[i + 1])) {
+      char32_t codePoint = ((lead & 0x1F) << 6) | (in[i + 1] & 0x3F);
+      i += 2;
+      return codePoint;
+    }
+  } else if (lead >= 0xE0 and lead <= 0xEF) {
+    if (remaining >= 3 and isContinuation(in[i + 1]) and
+        isContinuation(in[i + 2])) {
+      // E0 must not be overlong, ED must not encode a surrogate.
+      bool valid = not(lead == 0xE0 and in[i + 1] < 0xA0) and
+                   not(lead == 0xED and in[i + 1] >= 0xA0);
+      if (valid) {
+        char32_t codePoint = ((lead & 0x0F) << 12) |
+                             ((in[i + 1] & 0x3F) << 6) | (in[i + 2] & 0x3F);
+        i += 3;
+        return codePoint;
+      }
+    }
+  } else if (lead >= 0xF0 and lead <= 0xF4) {
+    if (remaining >= 4 and isContinuation(in[i + 1]) and
+        isContinuation(in[i + 2]) and isContinuation(in[i + 3])) {
+      // F0 must not be overlong, F4 must not exceed U+10FFFF.
+      bool valid = not(lead == 0xF0 and in[i + 1] < 0x90) and
+                   not(lead == 0xF4 and in[i + 1] >= 0x90);
+      if (valid) {
+        char32_t codePoint = ((lead & 0x07) << 18) |
+                             ((in[i + 1] & 0x3F) << 12) |
+                             ((in[i + 2] & 0x3F) << 6) | (in[i + 3] & 0x3F);
+        i += 4;
+        return codePoint;
+      }
+    }
+  }
+  i += 1;
+  return REPLACEMENT_CHARACTER;
+}
+
+size_t utf8ToUtf16(const char* input,
+                   size_t inputLength,
+                   char16_t* output,
+                   size_t outputCapacity) {
+  /*
+  Nearly all the text Trino returns is ASCII: identifiers, numbers
+  rendered as text, dates, uuids, and most varchar data. ASCII bytes
+  map one-to-one onto UTF-16 code units, so the fast path checks
+  16 bytes at a time for a set high bit and, if none is set, widens
+  them with two unpack instructions. Anything else drops to the
+  scalar decoder until the next ASCII run.
+  */
+  const unsigned char* in = reinterpret_cast<const unsigned char*>(input);
+  size_t i                = 0;
+  size_t written          = 0;
+
+  while (i < inputLength) {
+#ifdef TRANSCODER_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    while (i + 16 <= inputLength) {
+      __m128i chunk =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+      if (_mm_movemask_epi8(chunk) != 0) {
+        break;
+      }
+      if (written + 16 <= outputCapacity) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written),
+                         _mm_unpacklo_epi8(chunk, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written + 8),
+                         _mm_unpackhi_epi8(chunk, zero));
+        written += 16;
+      } else {
+        for (size_t k = 0; k < 16; k++) {
+          emitUnit(in[i + k], output, outputCapacity, written);
+        }
+      }
+      i += 16;
+    }
+    if (i >= inputLength) {
+      break;
+    }
+#endif
+    unsigned char lead = in[i];
+    if (lead < 0x80) {
+      emitUnit(lead, output, outputCapacity, written);
+      i++;
+    } else {
+      char32_t codePoint = decodeMultiByte(in, inputLength, i);
+      emitCodePoint(codePoint, output, outputCapacity, written);
+    }
+  }
+  return written;
+}
+
+std::u16string utf8ToUtf16(const std::string& input) {
+  // ASCII input is the common case, and it converts to exactly one
+  // code unit per byte. Size for that, and shrink if we overshot.
+  std::u16string output(input.size(), u'\0');
+  size_t required =
+      utf8ToUtf16(input.data(), input.size(), output.data(), output.size());
+  if (required > output.size()) {
+    output.resize(required);
+    utf8ToUtf16(input.data(), input.size(), output.data(), output.size());
+  } else {
+    output.resize(required);
+  }
+  return output;
+}
+
+static inline void appendUtf8(char32_t codePoint, std::string& output) {
+  if (codePoint < 0x80) {
+    output.push_back(static_cast<char>(codePoint));
+  } else if (codePoint < 0x800) {
+    output.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+    output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else if (codePoint < 0x10000) {
+    output.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+    output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else {
+    output.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+    output.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+    output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+}
+
+std::string utf16ToUtf8(const char16_t* input, size_t inputLength) {
+  std::string output;
+  // Reserve for the all-ASCII case, which is what query text usually is.
+  output.reserve(inputLength);
+  size_t i = 0;
+
+  while (i < inputLength) {
+#ifdef TRANSCODER_USE_SSE2
+    const __m128i nonAsciiMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+    const __m128i zero         = _mm_setzero_si128();
+    while (i + 8 <= inputLength) {
+      __m128i chunk =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+      __m128i highBits = _mm_and_si128(chunk, nonAsciiMask);
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(highBits, zero)) != 0xFFFF) {
+        break;
+      }
+      // Every unit is below 0x80, so saturating packs are exact.
+      char narrowed[16];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(narrowed),
+                       _mm_packus_epi16(chunk, chunk));
+      output.append(narrowed, 8);
+      i += 8;
+    }
+    if (i >= inputLength) {
+      break;
+    }
+#endif
+    char16_t unit = input[i];
+    if (unit < 0x80) {
+      output.push_back(static_cast<char>(unit));
+      i++;
+    } else if (isHighSurrogate(unit) and i + 1 < inputLength and
+               input[i + 1] >= 0xDC00 and input[i + 1] <= 0xDFFF) {
+      char32_t codePoint =
+          0x10000 + ((static_cast<char32_t>(unit) - 0xD800) << 10) +
+          (static_cast<char32_t>(input[i + 1]) - 0xDC00);
+      appendUtf8(codePoint, output);
+      i += 2;
+    } else if (unit >= 0xD800 and unit <= 0xDFFF) {
+      appendUtf8(REPLACEMENT_CHARACTER, output);
+      i++;
+    } else {
+      appendUtf8(unit, output);
+      i++;
+    }
+  }
+  return output;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/*
+Transcode UTF-8 input into UTF-16 code units.
+
+At most outputCapacity code units are written to output. The return
+value is always the total number of code units the complete conversion
+requires, so callers can detect truncation and report the full length
+the way ODBC expects. Passing a null output with a zero capacity just
+measures the input.
+
+Invalid UTF-8 sequences are replaced with U+FFFD.
+*/
+size_t utf8ToUtf16(const char* input,
+                   size_t inputLength,
+                   char16_t* output,
+                   size_t outputCapacity);
+
+std::u16string utf8ToUtf16(const std::string& input);
+
+/*
+Transcode UTF-16 input into a UTF-8 string. Unpaired surrogates
+are replaced with U+FFFD.
+*/
+std::string utf16ToUtf8(const char16_t* input, size_t inputLength);
+
+/*
+True if the code unit is the first half of a surrogate pair. Useful
+for callers that truncate output and must not split a pair.
+*/
+constexpr bool isHighSurrogate(char16_t codeUnit) {
+  return codeUnit >= 0xD800 and codeUnit <= 0xDBFF;
+}
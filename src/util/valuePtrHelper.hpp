@@ -4,8 +4,11 @@
 #include <sql.h>
 #include <sqlext.h>
 
+#include <algorithm>
 #include <string>
 
+#include "unicodeTranscoder.hpp"
+
 /*
 Write a string to the buffer at InfoValuePtr,
 and the length of the string to StringLengthPtr.
@@ -31,3 +34,31 @@ void writeNullTermStringToPtr(SQLPOINTER InfoValuePtr,
     *StringLengthPtr = static_cast<T>(length);
   }
 }
+
+/*
+Write a UTF-8 string to a SQLWCHAR buffer as null terminated UTF-16.
+
+Unlike the narrow variant, this respects the buffer size, which the
+wide entry points always supply as a count of characters. A truncated
+value never ends in half of a surrogate pair.
+
+Returns the number of characters the full value needs, not counting
+the null terminator, so callers can report it and detect truncation.
+*/
+inline size_t writeNullTermWideStringToPtr(SQLPOINTER valuePtr,
+                                           const std::string& s,
+                                           SQLLEN bufferChars) {
+  if (not valuePtr or bufferChars <= 0) {
+    return utf8ToUtf16(s.data(), s.size(), nullptr, 0);
+  }
+  char16_t* output = reinterpret_cast<char16_t*>(valuePtr);
+  size_t capacity  = static_cast<size_t>(bufferChars - 1);
+  size_t required  = utf8ToUtf16(s.data(), s.size(), output, capacity);
+  size_t written   = std::min(required, capacity);
+  if (written < required and written > 0 and
+      isHighSurrogate(output[written - 1])) {
+    written--;
+  }
+  output[written] = u'\0';
+  return required;
+}
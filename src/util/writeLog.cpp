@@ -1,50 +1,67 @@
 #include "writeLog.hpp"
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <fstream>
+#include <mutex>
 #include <thread>
 
 /*
 The default log level is the log level that is in effect
 when the driver starts up. Once a DSN is loaded, the
-log level defined in the DSN will override this default
-level.
+log level defined in the DSN applies to its connection's
+calls.
 */
 #ifdef DEBUG
-LogLevel DEFAULT_LOG_LEVEL = LL_TRACE;
+const LogLevel DEFAULT_LOG_LEVEL = LL_TRACE;
 #else
-LogLevel DEFAULT_LOG_LEVEL = LL_NONE;
+const LogLevel DEFAULT_LOG_LEVEL = LL_NONE;
 #endif
 
-LogLevel CURRENT_LOG_LEVEL = DEFAULT_LOG_LEVEL;
+// Every connection reads this outside of its own calls.
+static std::atomic<LogLevel> PROCESS_LOG_LEVEL = DEFAULT_LOG_LEVEL;
 
-std::ofstream* logStreamPtr = nullptr;
+// Set while a LogLevelScope is open on the thread.
+static thread_local bool THREAD_LOG_SCOPED    = false;
+static thread_local LogLevel THREAD_LOG_LEVEL = DEFAULT_LOG_LEVEL;
 
-static std::ofstream* getLogStream() {
-  if (logStreamPtr == nullptr) {
-    logStreamPtr =
-        new std::ofstream("C:\\temp\\odbclog.txt", std::ios_base::app);
-  }
-  return logStreamPtr;
-}
+// Writes from different threads would otherwise interleave. Nothing
+// takes the lock unless the message is going to be logged.
+static std::mutex LOG_MUTEX;
 
-std::wofstream* wideLogStreamPtr = nullptr;
+static std::ofstream& getLogStream() {
+  static std::ofstream logStream("C:\\temp\\odbclog.txt", std::ios_base::app);
+  return logStream;
+}
 
-static std::wofstream* getWideLogStream() {
-  if (wideLogStreamPtr == nullptr) {
-    wideLogStreamPtr =
-        new std::wofstream("C:\\temp\\odbclog.txt", std::ios_base::app);
-  }
-  return wideLogStreamPtr;
+static std::wofstream& getWideLogStream() {
+  static std::wofstream wideLogStream("C:\\temp\\odbclog.txt",
+                                      std::ios_base::app);
+  return wideLogStream;
 }
 
 void setLogLevel(LogLevel level) {
-  CURRENT_LOG_LEVEL = level;
+  PROCESS_LOG_LEVEL = level;
 }
 
 LogLevel getLogLevel() {
-  return CURRENT_LOG_LEVEL;
+  if (THREAD_LOG_SCOPED) {
+    return THREAD_LOG_LEVEL;
+  }
+  return PROCESS_LOG_LEVEL.load(std::memory_order_relaxed);
+}
+
+LogLevelScope::LogLevelScope(LogLevel level) {
+  this->previousLevel    = THREAD_LOG_LEVEL;
+  this->previouslyScoped = THREAD_LOG_SCOPED;
+  THREAD_LOG_LEVEL       = level;
+  THREAD_LOG_SCOPED      = true;
+}
+
+LogLevelScope::~LogLevelScope() {
+  THREAD_LOG_LEVEL  = this->previousLevel;
+  THREAD_LOG_SCOPED = this->previouslyScoped;
 }
 
 tm getTime() {
@@ -79,31 +96,31 @@ std::wstring wgetLogPrefix() {
 }
 
 void WriteLog(LogLevel level, std::ostringstream& oss) {
-  if (level < CURRENT_LOG_LEVEL) {
+  if (level < getLogLevel()) {
     return;
   }
-  std::ofstream* log = getLogStream();
   // Trace-level logging includes a thread id suffix on every log entry.
-  if (CURRENT_LOG_LEVEL == LL_TRACE) {
+  if (getLogLevel() == LL_TRACE) {
     oss << " [Thread " << std::this_thread::get_id() << "]";
   }
-  *log << oss.str() << std::endl;
+  std::lock_guard<std::mutex> lock(LOG_MUTEX);
+  getLogStream() << oss.str() << std::endl;
 }
 
 void WriteLog(LogLevel level, std::wostringstream& oss) {
-  if (level < CURRENT_LOG_LEVEL) {
+  if (level < getLogLevel()) {
     return;
   }
-  std::wofstream* log = getWideLogStream();
   // Trace-level logging includes a thread id suffix on every log entry.
-  if (CURRENT_LOG_LEVEL == LL_TRACE) {
+  if (getLogLevel() == LL_TRACE) {
     oss << " [Thread " << std::this_thread::get_id() << "]";
   }
-  *log << oss.str() << std::endl;
+  std::lock_guard<std::mutex> lock(LOG_MUTEX);
+  getWideLogStream() << oss.str() << std::endl;
 }
 
 void WriteLog(LogLevel level, const std::string& s) {
-  if (level < CURRENT_LOG_LEVEL) {
+  if (level < getLogLevel()) {
     return;
   }
   std::ostringstream oss;
@@ -112,7 +129,7 @@ void WriteLog(LogLevel level, const std::string& s) {
 }
 
 void WriteLog(LogLevel level, const std::wstring& s) {
-  if (level < CURRENT_LOG_LEVEL) {
+  if (level < getLogLevel()) {
     return;
   }
   std::wostringstream oss;
@@ -121,7 +138,7 @@ void WriteLog(LogLevel level, const std::wstring& s) {
 }
 
 void WriteLog(LogLevel level, const char* message) {
-  if (level < CURRENT_LOG_LEVEL) {
+  if (level < getLogLevel()) {
     return;
   }
   std::ostringstream oss;
@@ -137,7 +154,7 @@ void WriteLog(LogLevel level, unsigned char* message, int length) {
   If the length value is negative, we interpret this to mean it is
   null terminated.
   */
-  if (level < CURRENT_LOG_LEVEL) {
+  if (level < getLogLevel()) {
     return;
   }
 
@@ -153,7 +170,7 @@ void WriteLog(LogLevel level, unsigned char* message, int length) {
 }
 
 void WriteLog(LogLevel level, const std::map<std::string, std::string>& m) {
-  if (level < CURRENT_LOG_LEVEL) {
+  if (level < getLogLevel()) {
     return;
   }
   std::ostringstream oss;
@@ -169,7 +186,7 @@ void WriteLog(LogLevel level, const json& jsonData) {
 }
 
 void WriteLog(LogLevel level, void* p) {
-  if (level < CURRENT_LOG_LEVEL) {
+  if (level < getLogLevel()) {
     return;
   }
   std::ostringstream oss;
@@ -178,7 +195,7 @@ void WriteLog(LogLevel level, void* p) {
 }
 
 void WriteLog(LogLevel level, unsigned int i) {
-  if (level < CURRENT_LOG_LEVEL) {
+  if (level < getLogLevel()) {
     return;
   }
   std::ostringstream oss;
@@ -187,7 +204,7 @@ void WriteLog(LogLevel level, unsigned int i) {
 }
 
 void WriteLog(LogLevel level, int64_t i) {
-  if (level < CURRENT_LOG_LEVEL) {
+  if (level < getLogLevel()) {
     return;
   }
   std::ostringstream oss;
@@ -196,7 +213,7 @@ void WriteLog(LogLevel level, int64_t i) {
 }
 
 void WriteLog(LogLevel level, uint64_t i) {
-  if (level < CURRENT_LOG_LEVEL) {
+  if (level < getLogLevel()) {
     return;
   }
   std::ostringstream oss;
@@ -38,6 +38,29 @@ void WriteLog(LogLevel level, int64_t i);
 
 void WriteLog(LogLevel level, uint64_t i);
 
+/*
+The process's log level applies outside of any connection's calls,
+like on background threads. Connecting to a DSN doesn't change it.
+*/
 void setLogLevel(LogLevel level);
 
+// The level in effect on the calling thread.
 LogLevel getLogLevel();
+
+/*
+Log at a connection's own level, rather than the process's, on this
+thread for as long as the scope lasts. Calls on a statement open one,
+so the LogLevel of one DSN doesn't change what another's statements
+log. Scopes nest.
+*/
+class LogLevelScope {
+  private:
+    LogLevel previousLevel;
+    bool previouslyScoped;
+
+  public:
+    explicit LogLevelScope(LogLevel level);
+    ~LogLevelScope();
+    LogLevelScope(const LogLevelScope&)            = delete;
+    LogLevelScope& operator=(const LogLevelScope&) = delete;
+};
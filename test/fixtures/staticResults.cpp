@@ -0,0 +1,12 @@
+#include "staticResults.hpp"
+
+StaticResult makeResult(const std::string& value) {
+  StaticResult result;
+  result.columns = {json{{"name", "value"}}};
+  result.pages   = {std::make_shared<ResultPage>(json::array({{value}}))};
+  return result;
+}
+
+std::string valueOf(const StaticResult& result) {
+  return result.pages[0]->getCell(0, 0).get<std::string>();
+}
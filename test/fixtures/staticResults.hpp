@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+#include "../../src/trinoAPIWrapper/resultPage.hpp"
+
+// A result with a single row and column holding value, for the tests
+// of the caches that keep results.
+StaticResult makeResult(const std::string& value);
+
+// The value held by a result from makeResult.
+std::string valueOf(const StaticResult& result);
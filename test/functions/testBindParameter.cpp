@@ -0,0 +1,146 @@
+#include <windows.h>
+
+#include <gtest/gtest.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <string>
+
+#include "../fixtures/sqlDriverConnectFixture.hpp"
+
+class SQLBindParameterTest : public SQLDriverConnectFixture {};
+
+TEST_F(SQLBindParameterTest, PreparedIntegerParameter) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  std::string query = "SELECT name FROM tpch.tiny.nation WHERE nationkey = ?";
+  ret               = SQLPrepare(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  SQLINTEGER nationKey = 0;
+
+  ret = SQLBindParameter(hStmt,
+                         1,
+                         SQL_PARAM_INPUT,
+                         SQL_C_SLONG,
+                         SQL_INTEGER,
+                         0,
+                         0,
+                         &nationKey,
+                         0,
+                         nullptr);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  // The same prepared statement runs with a new value each time.
+  std::string expectedNames[] = {"ALGERIA", "ARGENTINA", "BRAZIL"};
+  for (nationKey = 0; nationKey < 3; nationKey++) {
+    ret = SQLExecute(hStmt);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+    ret = SQLFetch(hStmt);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+
+    SQLCHAR name[64];
+    SQLLEN indicator = 0;
+    ret = SQLGetData(hStmt, 1, SQL_C_CHAR, name, sizeof(name), &indicator);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+    EXPECT_STREQ((const char*)name, expectedNames[nationKey].c_str());
+
+    ret = SQLFetch(hStmt);
+    ASSERT_EQ(ret, SQL_NO_DATA);
+    ret = SQLFreeStmt(hStmt, SQL_CLOSE);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+  }
+
+  ret = SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+}
+
+TEST_F(SQLBindParameterTest, ExecDirectStringParameter) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  // Quotes in the value must come back exactly as they went in.
+  char value[]     = "it's '; a test --";
+  SQLLEN valueSize = SQL_NTS;
+
+  ret = SQLBindParameter(hStmt,
+                         1,
+                         SQL_PARAM_INPUT,
+                         SQL_C_CHAR,
+                         SQL_VARCHAR,
+                         sizeof(value),
+                         0,
+                         value,
+                         sizeof(value),
+                         &valueSize);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  std::string query = "SELECT ? AS echoed";
+  ret = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLFetch(hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  SQLCHAR echoed[64];
+  SQLLEN indicator = 0;
+  ret = SQLGetData(hStmt, 1, SQL_C_CHAR, echoed, sizeof(echoed), &indicator);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_STREQ((const char*)echoed, value);
+
+  ret = SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+}
+
+TEST_F(SQLBindParameterTest, ParameterArrayStatuses) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  constexpr SQLULEN SET_COUNT      = 3;
+  SQLBIGINT values[SET_COUNT]      = {1, 2, 3};
+  SQLLEN indicators[SET_COUNT]     = {0, SQL_NULL_DATA, 0};
+  SQLUSMALLINT statuses[SET_COUNT] = {};
+  SQLULEN processed                = 0;
+
+  ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)SET_COUNT, 0);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_STATUS_PTR, statuses, 0);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLBindParameter(hStmt,
+                         1,
+                         SQL_PARAM_INPUT,
+                         SQL_C_SBIGINT,
+                         SQL_BIGINT,
+                         0,
+                         0,
+                         values,
+                         0,
+                         indicators);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  std::string query = "SELECT ? + 1";
+  ret = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(processed, SET_COUNT);
+  for (SQLULEN i = 0; i < SET_COUNT; i++) {
+    EXPECT_EQ(statuses[i], SQL_PARAM_SUCCESS);
+  }
+
+  ret = SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+}
+
+TEST_F(SQLBindParameterTest, UnboundMarkerFails) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  std::string query = "SELECT ?, ?";
+  ret               = SQLPrepare(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLExecute(hStmt);
+  ASSERT_EQ(ret, SQL_ERROR);
+
+  ret = SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+}
@@ -1,9 +1,11 @@
 #include <windows.h>
 
+#include <chrono>
 #include <gtest/gtest.h>
 #include <iostream>
 #include <sql.h>
 #include <sqlext.h>
+#include <thread>
 
 #include "../constants.hpp"
 
@@ -48,3 +50,44 @@ TEST_F(SQLCancelTest, TestCancelQuery) {
   ret = SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
   ASSERT_EQ(ret, SQL_SUCCESS);
 }
+
+TEST_F(SQLCancelTest, CancelFromAnotherThreadStopsFetch) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  // Counting a large table returns nothing until it's done, so the
+  // fetch blocks polling Trino the whole time.
+  std::string query = "SELECT count(*) FROM tpch.sf1000.lineitem";
+  ret               = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  SQLRETURN fetchRet = SQL_SUCCESS;
+  std::thread fetcher([&]() { fetchRet = SQLFetch(hStmt); });
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+
+  auto canceledAt = std::chrono::steady_clock::now();
+  ret             = SQLCancel(hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  fetcher.join();
+  // The fetch gives up promptly rather than waiting out the query.
+  EXPECT_LT(std::chrono::steady_clock::now() - canceledAt,
+            std::chrono::seconds(5));
+  ASSERT_EQ(fetchRet, SQL_ERROR);
+
+  SQLCHAR sqlState[6] = {0};
+  SQLCHAR errorMsg[1024];
+  SQLINTEGER nativeError;
+  SQLSMALLINT msgLength;
+  ret = SQLGetDiagRec(SQL_HANDLE_STMT,
+                      hStmt,
+                      1,
+                      sqlState,
+                      &nativeError,
+                      errorMsg,
+                      sizeof(errorMsg),
+                      &msgLength);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_STREQ((char*)sqlState, "HY008");
+
+  ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hStmt), SQL_SUCCESS);
+}
@@ -0,0 +1,70 @@
+#include <windows.h>
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <sql.h>
+#include <sqlext.h>
+
+#include "../constants.hpp"
+
+#include "../fixtures/sqlDriverConnectFixture.hpp"
+
+class SQLCloseCursorTest : public SQLDriverConnectFixture {};
+
+TEST_F(SQLCloseCursorTest, ClosingAnUnfinishedQueryIsQuick) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  // Far more rows than anyone reads before giving up.
+  std::string query = "SELECT * FROM tpch.sf100.lineitem";
+  ret               = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLFetch(hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  // The query is stopped in the background, so closing doesn't wait
+  // for a round trip to Trino.
+  auto closing = std::chrono::steady_clock::now();
+  ret          = SQLCloseCursor(hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_LT(std::chrono::steady_clock::now() - closing,
+            std::chrono::milliseconds(100));
+
+  // The statement can run again right away.
+  query = "SELECT 1";
+  ret   = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLFetch(hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hStmt), SQL_SUCCESS);
+}
+
+TEST_F(SQLCloseCursorTest, ClosingWithoutACursorIsAnError) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  ret = SQLCloseCursor(hStmt);
+  ASSERT_EQ(ret, SQL_ERROR);
+
+  SQLCHAR sqlState[6] = {0};
+  SQLCHAR errorMsg[1024];
+  SQLINTEGER nativeError;
+  SQLSMALLINT msgLength;
+  ret = SQLGetDiagRec(SQL_HANDLE_STMT,
+                      hStmt,
+                      1,
+                      sqlState,
+                      &nativeError,
+                      errorMsg,
+                      sizeof(errorMsg),
+                      &msgLength);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_STREQ((char*)sqlState, "24000");
+
+  // SQLFreeStmt with SQL_CLOSE doesn't mind.
+  ret = SQLFreeStmt(hStmt, SQL_CLOSE);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hStmt), SQL_SUCCESS);
+}
@@ -0,0 +1,81 @@
+#include <windows.h>
+
+#include <gtest/gtest.h>
+#include <sql.h>
+#include <sqlext.h>
+
+#include "../constants.hpp"
+
+#include "../fixtures/sqlDriverConnectFixture.hpp"
+
+class SQLFetchScrollTest : public SQLDriverConnectFixture {
+  protected:
+    // Run a query returning the numbers 1 to 5000 on a static cursor,
+    // with its only column bound to value.
+    void executeScrollable(SQLBIGINT* value, SQLLEN* indicator) {
+      SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+      ASSERT_EQ(ret, SQL_SUCCESS);
+      ret = SQLSetStmtAttr(
+          hStmt, SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)SQL_CURSOR_STATIC, 0);
+      ASSERT_EQ(ret, SQL_SUCCESS);
+      std::string query = "SELECT x FROM UNNEST(sequence(1, 5000)) AS t(x)";
+      ret = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+      ASSERT_EQ(ret, SQL_SUCCESS);
+      ret = SQLBindCol(hStmt, 1, SQL_C_SBIGINT, value, 0, indicator);
+      ASSERT_EQ(ret, SQL_SUCCESS);
+    }
+};
+
+TEST_F(SQLFetchScrollTest, ScrollsInEveryDirection) {
+  SQLBIGINT value  = 0;
+  SQLLEN indicator = 0;
+  executeScrollable(&value, &indicator);
+
+  ASSERT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0), SQL_SUCCESS);
+  EXPECT_EQ(value, 1);
+  ASSERT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_LAST, 0), SQL_SUCCESS);
+  EXPECT_EQ(value, 5000);
+  ASSERT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_PRIOR, 0), SQL_SUCCESS);
+  EXPECT_EQ(value, 4999);
+  ASSERT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, 42), SQL_SUCCESS);
+  EXPECT_EQ(value, 42);
+  ASSERT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_RELATIVE, -40), SQL_SUCCESS);
+  EXPECT_EQ(value, 2);
+  ASSERT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, -10), SQL_SUCCESS);
+  EXPECT_EQ(value, 4991);
+  ASSERT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_FIRST, 0), SQL_SUCCESS);
+  EXPECT_EQ(value, 1);
+
+  ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hStmt), SQL_SUCCESS);
+}
+
+TEST_F(SQLFetchScrollTest, ScrollsBackFromPastTheEnds) {
+  SQLBIGINT value  = 0;
+  SQLLEN indicator = 0;
+  executeScrollable(&value, &indicator);
+
+  EXPECT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_PRIOR, 0), SQL_NO_DATA);
+  ASSERT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0), SQL_SUCCESS);
+  EXPECT_EQ(value, 1);
+  EXPECT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_ABSOLUTE, 5001), SQL_NO_DATA);
+  ASSERT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_PRIOR, 0), SQL_SUCCESS);
+  EXPECT_EQ(value, 5000);
+  EXPECT_EQ(SQLFetch(hStmt), SQL_NO_DATA);
+  ASSERT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_RELATIVE, -1), SQL_SUCCESS);
+  EXPECT_EQ(value, 5000);
+
+  ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hStmt), SQL_SUCCESS);
+}
+
+TEST_F(SQLFetchScrollTest, ForwardOnlyCursorsOnlyFetchNext) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  std::string query = "SELECT 1";
+  ret               = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  EXPECT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_FIRST, 0), SQL_ERROR);
+  EXPECT_EQ(SQLFetchScroll(hStmt, SQL_FETCH_NEXT, 0), SQL_SUCCESS);
+
+  ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hStmt), SQL_SUCCESS);
+}
@@ -0,0 +1,57 @@
+#include <windows.h>
+
+#include <gtest/gtest.h>
+#include <sql.h>
+#include <sqlext.h>
+
+#include "../constants.hpp"
+
+#include "../fixtures/sqlDriverConnectFixture.hpp"
+
+class SQLFreeHandleTest : public SQLDriverConnectFixture {};
+
+TEST_F(SQLFreeHandleTest, ReusedStatementsStartOverClean) {
+  // A freed statement is kept for the next allocation, so leave this
+  // one with everything an application might have changed.
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLSetStmtAttr(hStmt, SQL_ATTR_MAX_ROWS, (SQLPOINTER)2, 0);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  SQLINTEGER custKey = 0;
+  SQLLEN custKeyInd  = 0;
+  ret = SQLBindCol(hStmt, 1, SQL_C_SLONG, &custKey, 0, &custKeyInd);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  std::string query = "SELECT custkey FROM tpch.tiny.customer";
+  ret               = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ASSERT_EQ(SQLFetch(hStmt), SQL_SUCCESS);
+  ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hStmt), SQL_SUCCESS);
+
+  // Thousands of statements allocated and freed one after another.
+  for (int i = 0; i < 1000; i++) {
+    ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+    ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hStmt), SQL_SUCCESS);
+  }
+
+  ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  SQLULEN maxRows = 99;
+  ret = SQLGetStmtAttr(hStmt, SQL_ATTR_MAX_ROWS, &maxRows, 0, nullptr);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(maxRows, 0);
+
+  // No row limit and no bound column carried over.
+  custKey = -1;
+  ret     = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  int rowCount = 0;
+  while ((ret = SQLFetch(hStmt)) == SQL_SUCCESS) {
+    ++rowCount;
+  }
+  EXPECT_EQ(ret, SQL_NO_DATA);
+  EXPECT_EQ(rowCount, 1500);
+  EXPECT_EQ(custKey, -1);
+
+  ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hStmt), SQL_SUCCESS);
+}
@@ -0,0 +1,165 @@
+#include <windows.h>
+
+#include <gtest/gtest.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <string>
+
+#include "../fixtures/sqlDriverConnectFixture.hpp"
+
+class SQLPrepareTest : public SQLDriverConnectFixture {};
+
+TEST_F(SQLPrepareTest, DescribeBeforeExecute) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  std::string query = R"SQL(
+      SELECT nationkey, name, CAST(1.5 AS DECIMAL(5, 2)) AS price
+      FROM tpch.tiny.nation
+  )SQL";
+  ret = SQLPrepare(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  SQLSMALLINT columnCount = 0;
+  ret                     = SQLNumResultCols(hStmt, &columnCount);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(columnCount, 3);
+
+  SQLCHAR colName[128];
+  SQLSMALLINT nameLen       = 0;
+  SQLSMALLINT dataType      = 0;
+  SQLULEN colSize           = 0;
+  SQLSMALLINT decimalDigits = 0;
+  SQLSMALLINT nullable      = 0;
+
+  ret = SQLDescribeCol(hStmt,
+                       2,
+                       colName,
+                       sizeof(colName),
+                       &nameLen,
+                       &dataType,
+                       &colSize,
+                       &decimalDigits,
+                       &nullable);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_STREQ((const char*)colName, "name");
+  EXPECT_EQ(dataType, SQL_VARCHAR);
+
+  SQLSMALLINT paramCount = -1;
+  ret                    = SQLNumParams(hStmt, &paramCount);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(paramCount, 0);
+
+  ret = SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+}
+
+TEST_F(SQLPrepareTest, DescribeAfterClosingTheCursor) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  std::string query = "SELECT nationkey, name FROM tpch.tiny.nation";
+  ret               = SQLPrepare(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLExecute(hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLFetch(hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  // Closing the cursor leaves the statement prepared, columns and all.
+  ret = SQLFreeStmt(hStmt, SQL_CLOSE);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  SQLSMALLINT columnCount = 0;
+  ret                     = SQLNumResultCols(hStmt, &columnCount);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(columnCount, 2);
+
+  SQLCHAR colName[128];
+  SQLSMALLINT nameLen       = 0;
+  SQLSMALLINT dataType      = 0;
+  SQLULEN colSize           = 0;
+  SQLSMALLINT decimalDigits = 0;
+  SQLSMALLINT nullable      = 0;
+
+  ret = SQLDescribeCol(hStmt,
+                       2,
+                       colName,
+                       sizeof(colName),
+                       &nameLen,
+                       &dataType,
+                       &colSize,
+                       &decimalDigits,
+                       &nullable);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_STREQ((const char*)colName, "name");
+  EXPECT_EQ(dataType, SQL_VARCHAR);
+
+  ret = SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+}
+
+TEST_F(SQLPrepareTest, ExecuteRepeatedly) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  std::string query = "SELECT count(*) FROM tpch.tiny.nation";
+  ret               = SQLPrepare(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  for (int run = 0; run < 3; run++) {
+    ret = SQLExecute(hStmt);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+
+    ret = SQLFetch(hStmt);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+    SQLBIGINT count  = 0;
+    SQLLEN indicator = 0;
+    ret = SQLGetData(hStmt, 1, SQL_C_SBIGINT, &count, 0, &indicator);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+    EXPECT_EQ(count, 25);
+
+    ret = SQLFetch(hStmt);
+    ASSERT_EQ(ret, SQL_NO_DATA);
+    ret = SQLFreeStmt(hStmt, SQL_CLOSE);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+  }
+
+  ret = SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+}
+
+TEST_F(SQLPrepareTest, CountsParameterMarkers) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  std::string query = R"SQL(
+      SELECT name FROM tpch.tiny.nation
+      WHERE nationkey = ? AND name <> '?' AND regionkey = ?
+  )SQL";
+  ret = SQLPrepare(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  SQLSMALLINT paramCount = 0;
+  ret                    = SQLNumParams(hStmt, &paramCount);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(paramCount, 2);
+
+  ret = SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+}
+
+TEST_F(SQLPrepareTest, InvalidStatementFails) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  std::string query = "SELEKT 1";
+  ret               = SQLPrepare(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_ERROR);
+
+  ret = SQLExecute(hStmt);
+  ASSERT_EQ(ret, SQL_ERROR);
+
+  ret = SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+}
@@ -0,0 +1,96 @@
+#include <windows.h>
+
+#include <gtest/gtest.h>
+#include <sql.h>
+#include <sqlext.h>
+
+#include "../constants.hpp"
+
+#include "../fixtures/sqlDriverConnectFixture.hpp"
+
+class SQLSetStmtAttrTest : public SQLDriverConnectFixture {
+  protected:
+    // Fetch every row of the statement's result, returning how many
+    // there were.
+    int countRows() {
+      int rows = 0;
+      while (SQLFetch(hStmt) == SQL_SUCCESS) {
+        rows++;
+      }
+      return rows;
+    }
+};
+
+TEST_F(SQLSetStmtAttrTest, MaxRowsLimitsSimpleSelect) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLSetStmtAttr(hStmt, SQL_ATTR_MAX_ROWS, (SQLPOINTER)10, 0);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  SQLULEN maxRows = 0;
+  ret = SQLGetStmtAttr(hStmt, SQL_ATTR_MAX_ROWS, &maxRows, 0, nullptr);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(maxRows, 10);
+
+  std::string query = "SELECT * FROM tpch.sf1.orders";
+  ret               = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(countRows(), 10);
+
+  ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hStmt), SQL_SUCCESS);
+}
+
+TEST_F(SQLSetStmtAttrTest, MaxRowsStopsQueriesThatCantBeLimited) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLSetStmtAttr(hStmt, SQL_ATTR_MAX_ROWS, (SQLPOINTER)25, 0);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  // A LIMIT larger than SQL_ATTR_MAX_ROWS is left in place, so the
+  // driver has to stop the query itself.
+  std::string query = "SELECT * FROM tpch.sf1.orders LIMIT 100000";
+  ret               = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(countRows(), 25);
+
+  ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hStmt), SQL_SUCCESS);
+}
+
+TEST_F(SQLSetStmtAttrTest, QueryTimeoutStopsLongQueries) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLSetStmtAttr(hStmt, SQL_ATTR_QUERY_TIMEOUT, (SQLPOINTER)1, 0);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  SQLULEN queryTimeout = 0;
+  ret                  = SQLGetStmtAttr(
+      hStmt, SQL_ATTR_QUERY_TIMEOUT, &queryTimeout, 0, nullptr);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(queryTimeout, 1);
+
+  // Counting a large table takes far longer than a second, and returns
+  // nothing until it's done.
+  std::string query = "SELECT count(*) FROM tpch.sf1000.lineitem";
+  ret               = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  if (ret == SQL_SUCCESS) {
+    ret = SQLFetch(hStmt);
+  }
+  ASSERT_EQ(ret, SQL_ERROR);
+
+  SQLCHAR sqlState[6] = {0};
+  SQLCHAR errorMsg[1024];
+  SQLINTEGER nativeError;
+  SQLSMALLINT msgLength;
+  ret = SQLGetDiagRec(SQL_HANDLE_STMT,
+                      hStmt,
+                      1,
+                      sqlState,
+                      &nativeError,
+                      errorMsg,
+                      sizeof(errorMsg),
+                      &msgLength);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_STREQ((char*)sqlState, "HYT00");
+
+  ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hStmt), SQL_SUCCESS);
+}
@@ -3,7 +3,10 @@
 #include <gtest/gtest.h>
 #include <sql.h>
 #include <sqlext.h>
+#include <string>
+#include <vector>
 
+#include "../../src/driver/constants/connectionAttrs.hpp"
 #include "../constants.hpp"
 
 #include "../fixtures/sqlDriverConnectFixture.hpp"
@@ -71,3 +74,69 @@ TEST_F(GetTablesTest, GetCatalogs) {
   std::string firstCatalogName(result, indicator);
   ASSERT_TRUE(not firstCatalogName.empty());
 }
+
+static std::vector<std::string> readCatalogNames(SQLHSTMT hStmt) {
+  std::string catalog = SQL_ALL_CATALOGS;
+  std::vector<std::string> names;
+
+  SQLRETURN ret = SQLTables(hStmt,
+                            (SQLCHAR*)catalog.c_str(),
+                            static_cast<SQLSMALLINT>(catalog.size()),
+                            (SQLCHAR*)"",
+                            0,
+                            (SQLCHAR*)"",
+                            0,
+                            (SQLCHAR*)"",
+                            0);
+  EXPECT_EQ(ret, SQL_SUCCESS) << "Failed to execute SQLTables";
+
+  char result[128] = "";
+  SQLLEN indicator = 0;
+  while (SQLFetch(hStmt) == SQL_SUCCESS) {
+    SQLGetData(hStmt, 1, SQL_C_CHAR, result, sizeof(result), &indicator);
+    names.push_back(std::string(result, indicator));
+  }
+  SQLFreeStmt(hStmt, SQL_CLOSE);
+  return names;
+}
+
+TEST_F(GetTablesTest, RepeatedCallsReturnSameResult) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, this->hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS) << "Failed to allocate statement handle";
+
+  // The second call is answered from the connection's metadata cache,
+  // and the third goes back to the server after the cache is cleared.
+  std::vector<std::string> first = readCatalogNames(hStmt);
+  ASSERT_FALSE(first.empty());
+  EXPECT_EQ(readCatalogNames(hStmt), first);
+
+  ret = SQLSetConnectAttr(
+      this->hDbc, SQL_ATTR_METADATA_CACHE_INVALIDATE, (SQLPOINTER)1, 0);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(readCatalogNames(hStmt), first);
+}
+
+TEST_F(GetTablesTest, MaxRowsLimitsCatalogResults) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, this->hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS) << "Failed to allocate statement handle";
+  std::vector<std::string> all = readCatalogNames(hStmt);
+  ASSERT_GT(all.size(), 1);
+
+  // The limited call is answered from the cache, and cuts the result
+  // short without changing what's cached.
+  ret = SQLSetStmtAttr(hStmt, SQL_ATTR_MAX_ROWS, (SQLPOINTER)1, 0);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  std::vector<std::string> limited = readCatalogNames(hStmt);
+  ASSERT_EQ(limited.size(), 1);
+  EXPECT_EQ(limited[0], all[0]);
+
+  // The same goes for a call that misses the cache.
+  ret = SQLSetConnectAttr(
+      this->hDbc, SQL_ATTR_METADATA_CACHE_INVALIDATE, (SQLPOINTER)1, 0);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(readCatalogNames(hStmt).size(), 1);
+
+  ret = SQLSetStmtAttr(hStmt, SQL_ATTR_MAX_ROWS, (SQLPOINTER)0, 0);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(readCatalogNames(hStmt), all);
+}
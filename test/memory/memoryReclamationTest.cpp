@@ -1,9 +1,11 @@
 #include <windows.h>
 
+#include <chrono>
 #include <gtest/gtest.h>
 #include <sql.h>
 #include <sqlext.h>
 #include <string>
+#include <thread>
 
 #include "../fixtures/sqlDriverConnectFixture.hpp"
 
@@ -38,7 +40,7 @@ class MemoryReclamationTest : public SQLDriverConnectFixture {
     to have tests of the memory behavior.
     */
     size_t CheckTrinoQueryInternalRowCount(TrinoQuery* trinoQuery) {
-      return trinoQuery->dataJson.size();
+      return trinoQuery->bufferedRowCount;
     }
 };
 
@@ -189,3 +191,105 @@ TEST_F(MemoryReclamationTest, TestCorrectAnswerWithMemoryReclamation) {
   // Free statement handle
   SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
 }
+
+class BufferBudgetTest : public SQLDriverConnectFixture {
+  protected:
+    void SetUp() override {
+      // A 1 MB budget, far smaller than the result.
+      return SQLDriverConnectFixture::SetUp(
+          "LogLevel=Warn;statementBufferLimit=1");
+    }
+};
+
+TEST_F(BufferBudgetTest, TestIngestionPausesOverBudget) {
+  std::string big_query = R"SQL(
+    SELECT *
+    FROM tpch.sf1.lineitem
+    LIMIT 200000
+  )SQL";
+
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLExecDirect(hStmt, (SQLCHAR*)big_query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  int nRows = 0;
+  while ((ret = SQLFetch(hStmt)) == SQL_SUCCESS) {
+    nRows++;
+  }
+  ASSERT_EQ(ret, SQL_NO_DATA);
+  ASSERT_EQ(nRows, 200000);
+
+  SQLULEN peakBytes = 0;
+  ret               = SQLGetStmtAttr(
+      hStmt, SQL_ATTR_PEAK_BUFFERED_BYTES, &peakBytes, 0, nullptr);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  // Rows aren't asked for while the budget is used up, so no more than
+  // a response or two over the budget is ever held. Well over 1 MB of
+  // rows went through.
+  EXPECT_GT(peakBytes, 0);
+  EXPECT_LT(peakBytes, 16 * 1024 * 1024);
+
+  // The application kept up, so the budget was kept by pausing, and
+  // nothing had to go to disk.
+  SQLULEN spilledBytes = 0;
+  ret                  = SQLGetStmtAttr(
+      hStmt, SQL_ATTR_SPILLED_BYTES, &spilledBytes, 0, nullptr);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_EQ(spilledBytes, 0);
+
+  SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+}
+
+TEST_F(BufferBudgetTest, TestStalledIngestionSpills) {
+  std::string big_query = R"SQL(
+    SELECT *
+    FROM tpch.sf1.lineitem
+    LIMIT 200000
+  )SQL";
+
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  Statement* actualStatementPtr = nullptr;
+  ret                           = SQLGetStmtAttr(hStmt,
+                       SQL_ATTR_RAW_STATEMENT_HANDLE,
+                       &actualStatementPtr,
+                       SQL_IS_POINTER,
+                       nullptr);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  // Any second page puts the statement over budget, and a pause only
+  // lasts a second rather than minutes.
+  SpillSettings& spillSettings =
+      actualStatementPtr->connectionConfig->spillSettings;
+  spillSettings.statementBufferLimit = 1;
+  spillSettings.pauseLimit           = std::chrono::seconds(1);
+
+  ret = SQLExecDirect(hStmt, (SQLCHAR*)big_query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLFetch(hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  // Ask for more while rows are still unread, which pauses ingestion.
+  TrinoQuery* trinoQuery = actualStatementPtr->trinoQuery;
+  trinoQuery->poll(UntilNewData);
+  ASSERT_FALSE(trinoQuery->getIsCompleted());
+  EXPECT_EQ(trinoQuery->getSpilledBytes(), 0);
+
+  // The application stalls for longer than a pause may last, so the
+  // next fetch polls anyway and spills what doesn't fit.
+  std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+  int nRows = 1;
+  while ((ret = SQLFetch(hStmt)) == SQL_SUCCESS) {
+    nRows++;
+  }
+  ASSERT_EQ(ret, SQL_NO_DATA);
+  ASSERT_EQ(nRows, 200000);
+
+  SQLULEN spilledBytes = 0;
+  ret                  = SQLGetStmtAttr(
+      hStmt, SQL_ATTR_SPILLED_BYTES, &spilledBytes, 0, nullptr);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_GT(spilledBytes, 0);
+
+  SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+}
@@ -0,0 +1,185 @@
+#include <windows.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <sstream>
+#include <sql.h>
+#include <sqlext.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../constants.hpp"
+
+/*
+Every thread gets its own environment, connection, and statement, the
+way a multi-threaded application holding a connection per worker uses
+the driver. Returns how many rows the thread fetched, or -1 if any call
+failed, since gtest assertions only stop the thread that makes them.
+*/
+static long long connectAndCountRows(const std::string& extraConnStr,
+                                     const std::string& query) {
+  SQLHENV hEnv   = nullptr;
+  SQLHDBC hDbc   = nullptr;
+  SQLHSTMT hStmt = nullptr;
+  long long rows = -1;
+
+  std::string inConnectionStr = "DSN=" + TEST_DSN + ";" + extraConnStr;
+  SQLSMALLINT outConnStrLen   = 0;
+  if (SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &hEnv) == SQL_SUCCESS and
+      SQLSetEnvAttr(
+          hEnv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0) ==
+          SQL_SUCCESS and
+      SQLAllocHandle(SQL_HANDLE_DBC, hEnv, &hDbc) == SQL_SUCCESS and
+      SQLDriverConnect(hDbc,
+                       nullptr,
+                       (SQLCHAR*)inConnectionStr.c_str(),
+                       static_cast<SQLSMALLINT>(inConnectionStr.size()),
+                       nullptr,
+                       0,
+                       &outConnStrLen,
+                       SQL_DRIVER_NOPROMPT) == SQL_SUCCESS) {
+    if (SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt) == SQL_SUCCESS and
+        SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS) ==
+            SQL_SUCCESS) {
+      SQLRETURN ret;
+      rows = 0;
+      while ((ret = SQLFetch(hStmt)) == SQL_SUCCESS) {
+        ++rows;
+      }
+      if (ret != SQL_NO_DATA) {
+        rows = -1;
+      }
+    }
+    if (hStmt) {
+      SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+    }
+    SQLDisconnect(hDbc);
+  }
+  if (hDbc) {
+    SQLFreeHandle(SQL_HANDLE_DBC, hDbc);
+  }
+  if (hEnv) {
+    SQLFreeHandle(SQL_HANDLE_ENV, hEnv);
+  }
+  return rows;
+}
+
+// Runs the query on threadCount connections at once and returns how
+// long it took them all, in milliseconds.
+static long long runConcurrently(size_t threadCount,
+                                 const std::string& query,
+                                 long long expectedNumRows) {
+  std::vector<long long> rows(threadCount, -1);
+  std::vector<std::thread> threads;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < threadCount; i++) {
+    threads.emplace_back([&rows, i, &query]() {
+      rows[i] = connectAndCountRows("LogLevel=Warn;", query);
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < threadCount; i++) {
+    EXPECT_EQ(rows[i], expectedNumRows)
+        << "Connection " << i << " of " << threadCount << " failed";
+  }
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end - begin)
+      .count();
+}
+
+// Compiling in debug mode makes these performance tests significantly
+// slower. We should only trust them for release mode tests.
+
+TEST(ConcurrencyPerformanceTest, ScalesWithConnections) {
+  const std::string query =
+      "SELECT name FROM tpch.sf1.customer WHERE custkey <= 50000";
+  size_t maxThreads =
+      std::max<size_t>(std::thread::hardware_concurrency(), 4);
+
+  // The first run pays for loading the driver and warming up Trino.
+  runConcurrently(1, query, 50000);
+  long long singleDuration = runConcurrently(1, query, 50000);
+  for (size_t threadCount = 2; threadCount <= maxThreads; threadCount *= 2) {
+    long long duration = runConcurrently(threadCount, query, 50000);
+    double speedup = static_cast<double>(singleDuration) * threadCount /
+                     std::max<long long>(duration, 1);
+    std::cout << threadCount << " connections took " << duration << "ms, "
+              << "one took " << singleDuration << "ms, a speedup of "
+              << speedup << std::endl;
+    // Connections share no locks on the fetch path, so running several
+    // at once should get at least half of the ideal speedup. Merely
+    // beating running them in turn would let a lock serializing most
+    // of the work go unnoticed.
+    ASSERT_GE(speedup, static_cast<double>(threadCount) / 2)
+        << "Concurrent connections didn't scale";
+  }
+}
+
+// Where the driver writes its log.
+static const char* LOG_PATH = "C:\\temp\\odbclog.txt";
+
+/*
+What the driver logged since its log was offset bytes long.
+*/
+static std::string readLogFrom(std::streamoff offset) {
+  std::ifstream log(LOG_PATH, std::ios::binary);
+  log.seekg(offset);
+  std::ostringstream text;
+  text << log.rdbuf();
+  return text.str();
+}
+
+static std::streamoff logSize() {
+  std::error_code error;
+  uintmax_t size = std::filesystem::file_size(LOG_PATH, error);
+  return error ? 0 : static_cast<std::streamoff>(size);
+}
+
+TEST(ConcurrencyPerformanceTest, ConnectionsKeepTheirOwnLogLevels) {
+  // A chatty connection beside quiet ones shouldn't change what the
+  // quiet ones log, or break either of them. Queries are logged at the
+  // debug level, and each connection's query is marked so its lines
+  // can be told apart.
+  std::string run = std::to_string(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+  auto queryFor = [&run](size_t connection) {
+    return "SELECT custkey, 'logLevel-" + run + "-" +
+           std::to_string(connection) +
+           "' FROM tpch.tiny.customer WHERE custkey <= 1000";
+  };
+  std::streamoff logStart = logSize();
+
+  std::vector<long long> rows(8, -1);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < rows.size(); i++) {
+    threads.emplace_back([&rows, i, &queryFor]() {
+      std::string logLevel = i == 0 ? "LogLevel=Debug;" : "LogLevel=Warn;";
+      rows[i]              = connectAndCountRows(logLevel, queryFor(i));
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (long long count : rows) {
+    EXPECT_EQ(count, 1000);
+  }
+
+  // Once the chatty connection is gone, a quiet one stays quiet.
+  EXPECT_EQ(connectAndCountRows("LogLevel=Warn;", queryFor(rows.size())),
+            1000);
+
+  std::string log = readLogFrom(logStart);
+  EXPECT_NE(log.find(queryFor(0)), std::string::npos)
+      << "The debug connection's query wasn't logged";
+  for (size_t i = 1; i <= rows.size(); i++) {
+    EXPECT_EQ(log.find(queryFor(i)), std::string::npos)
+        << "Quiet connection " << i << " logged its query";
+  }
+}
@@ -166,6 +166,66 @@ TEST_F(FetchGetDataTest, SelectUUIDVarchar) {
       SQL_C_CHAR);
 }
 
+TEST_F(FetchGetDataTest, SelectIntAsChar) {
+  executeAndValidateQuery("SELECT -42", std::string("-42"), SQL_C_CHAR);
+}
+
+TEST_F(FetchGetDataTest, SelectDoubleAsChar) {
+  executeAndValidateQuery(
+      "SELECT CAST(1.5 AS DOUBLE)", std::string("1.5"), SQL_C_CHAR);
+}
+
+TEST_F(FetchGetDataTest, SelectRealAsChar) {
+  executeAndValidateQuery(
+      "SELECT CAST(1.1 AS REAL)", std::string("1.1"), SQL_C_CHAR);
+}
+
+TEST_F(FetchGetDataTest, SelectBooleanAsChar) {
+  executeAndValidateQuery("SELECT true", std::string("1"), SQL_C_CHAR);
+}
+
+TEST_F(FetchGetDataTest, SelectVarcharAsInt) {
+  executeAndValidateQuery("SELECT '1234'", (SQLINTEGER)1234, SQL_C_SLONG);
+}
+
+TEST_F(FetchGetDataTest, SelectDecimalAsDouble) {
+  executeAndValidateQuery(
+      "SELECT CAST(12.25 AS DECIMAL(4, 2))", (SQLDOUBLE)12.25, SQL_C_DOUBLE);
+}
+
+TEST_F(FetchGetDataTest, SelectBigIntAsSmallIntIsOutOfRange) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  std::string query = "SELECT CAST(70000 AS BIGINT)";
+  ret               = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ret = SQLFetch(hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  // 70000 doesn't fit in a short, and mustn't come back wrapped around.
+  SQLSMALLINT result = 0;
+  SQLLEN indicator   = 0;
+  ret = SQLGetData(hStmt, 1, SQL_C_SSHORT, &result, 0, &indicator);
+  ASSERT_EQ(ret, SQL_ERROR);
+
+  SQLCHAR sqlState[6] = {0};
+  SQLCHAR errorMsg[1024];
+  SQLINTEGER nativeError;
+  SQLSMALLINT msgLength;
+  ret = SQLGetDiagRec(SQL_HANDLE_STMT,
+                      hStmt,
+                      1,
+                      sqlState,
+                      &nativeError,
+                      errorMsg,
+                      sizeof(errorMsg),
+                      &msgLength);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  EXPECT_STREQ((char*)sqlState, "22003");
+
+  SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+}
+
 TEST_F(FetchGetDataTest, SelectGUID) {
   SQLGUID expectedGuid = {1, 2, 3, {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H'}};
 
@@ -276,6 +336,38 @@ TEST_F(FetchGetDataTest, SelectIntegralDecimal) {
   }
 }
 
+TEST_F(FetchGetDataTest, SelectDoubleAsNumeric) {
+  // A double has no scale of its own, so the struct takes the scale of
+  // the digits the value needs: 1.5 is 15 with a scale of 1.
+  tagSQL_NUMERIC_STRUCT res = executeAndValidateQuery<tagSQL_NUMERIC_STRUCT>(
+      "SELECT CAST(1.5 AS DOUBLE)", SQL_C_NUMERIC);
+
+  ASSERT_EQ(res.precision, 2);
+  ASSERT_EQ(res.scale, 1);
+  ASSERT_EQ(res.sign, 1);
+  ASSERT_EQ(res.val[0], 15);
+  for (auto i = 1; i < SQL_MAX_NUMERIC_LEN; i++) {
+    ASSERT_EQ(res.val[i], 0);
+  }
+}
+
+TEST_F(FetchGetDataTest, SelectLargeDoubleAsNumeric) {
+  // 1e20 is too wide for a 64 bit integer, and mustn't be read as the
+  // digits of "1e+20". Its little endian encoding is 0x56BC75E2D63100000.
+  SQLCHAR val[SQL_MAX_NUMERIC_LEN] = {
+      0x00, 0x00, 0x10, 0x63, 0x2D, 0x5E, 0xC7, 0x6B, 0x05};
+
+  tagSQL_NUMERIC_STRUCT res = executeAndValidateQuery<tagSQL_NUMERIC_STRUCT>(
+      "SELECT CAST(1e20 AS DOUBLE)", SQL_C_NUMERIC);
+
+  ASSERT_EQ(res.precision, 21);
+  ASSERT_EQ(res.scale, 0);
+  ASSERT_EQ(res.sign, 1);
+  for (auto i = 0; i < SQL_MAX_NUMERIC_LEN; i++) {
+    ASSERT_EQ(res.val[i], val[i]);
+  }
+}
+
 TEST_F(FetchGetDataTest, SelectDecimalVarchar) {
   // We'll let trino truncate some digits (with rounding!)
   // for this test.
@@ -369,3 +461,66 @@ TEST_F(FetchGetDataTest, SelectTimestampWithTimeZone) {
   ASSERT_EQ(res.second, expectedTimestamp.second);
   ASSERT_EQ(res.fraction, expectedTimestamp.fraction);
 }
+
+TEST_F(FetchGetDataTest, SelectWideVarchar) {
+  // The query itself goes through the wide entry point too, so the
+  // non-ASCII literal makes the round trip in both directions.
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  std::wstring query = L"SELECT 'caf\u00E9 \U0001F600'";
+  ret = SQLExecDirectW(hStmt, (SQLWCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  ret = SQLFetch(hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  SQLWCHAR result[32] = {0};
+  SQLLEN indicator    = 0;
+  ret = SQLGetData(hStmt, 1, SQL_C_WCHAR, result, sizeof(result), &indicator);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  std::wstring expected = L"caf\u00E9 \U0001F600";
+  ASSERT_EQ(std::wstring((wchar_t*)result), expected);
+  ASSERT_EQ(indicator, expected.size() * sizeof(SQLWCHAR));
+
+  SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+}
+
+TEST_F(FetchGetDataTest, SelectVarbinaryInPieces) {
+  SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hDbc, &hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  std::string query = "SELECT to_utf8('abcdefghij')";
+  ret = SQLExecDirect(hStmt, (SQLCHAR*)query.c_str(), SQL_NTS);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  ret = SQLFetch(hStmt);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+
+  // Read the ten bytes four at a time.
+  std::string result;
+  unsigned char piece[4] = {0};
+  SQLLEN indicator       = 0;
+  ret = SQLGetData(hStmt, 1, SQL_C_BINARY, piece, sizeof(piece), &indicator);
+  ASSERT_EQ(ret, SQL_SUCCESS_WITH_INFO);
+  ASSERT_EQ(indicator, 10);
+  result.append((char*)piece, 4);
+
+  ret = SQLGetData(hStmt, 1, SQL_C_BINARY, piece, sizeof(piece), &indicator);
+  ASSERT_EQ(ret, SQL_SUCCESS_WITH_INFO);
+  ASSERT_EQ(indicator, 6);
+  result.append((char*)piece, 4);
+
+  ret = SQLGetData(hStmt, 1, SQL_C_BINARY, piece, sizeof(piece), &indicator);
+  ASSERT_EQ(ret, SQL_SUCCESS);
+  ASSERT_EQ(indicator, 2);
+  result.append((char*)piece, 2);
+
+  ret = SQLGetData(hStmt, 1, SQL_C_BINARY, piece, sizeof(piece), &indicator);
+  ASSERT_EQ(ret, SQL_NO_DATA);
+
+  ASSERT_EQ(result, "abcdefghij");
+
+  SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+}
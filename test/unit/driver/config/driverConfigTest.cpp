@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+
+#include "../../../../src/driver/config/driverConfig.hpp"
+
+TEST(DriverConfigTest, ReadsNumberSettings) {
+  DriverConfig config = driverConfigFromKVPs({
+      {"metadataCacheTTL", "120"},
+      {"segmentdownloadthreads", "8"},
+  });
+  EXPECT_EQ(config.getMetadataCacheTTLNum(), 120);
+  EXPECT_EQ(config.getSegmentDownloadThreadsNum(), 8);
+}
+
+TEST(DriverConfigTest, BadNumberSettingsFallBackToDefaults) {
+  // A cleared DSN entry, a word, and trailing junk mustn't throw out of
+  // SQLConnect or SQLDriverConnect.
+  DriverConfig config = driverConfigFromKVPs({
+      {"metadataCacheTTL", ""},
+      {"resultcachesize", "lots"},
+      {"segmentDownloadThreads", "4x"},
+      {"connectionBufferLimit", "-1"},
+  });
+  EXPECT_EQ(config.getMetadataCacheTTLNum(), 60);
+  EXPECT_EQ(config.getResultCacheSizeNum(), 256);
+  EXPECT_EQ(config.getSegmentDownloadThreadsNum(), 4);
+  EXPECT_EQ(config.getConnectionBufferLimitNum(), 0);
+}
@@ -0,0 +1,46 @@
+#include "gtest/gtest.h"
+#include <string>
+
+#include "../../../src/trinoAPIWrapper/columnDescription.hpp"
+
+TEST(ColumnDescriptionTest, TypeWithoutArguments) {
+  ColumnDescription column(columnInfoFromTypeText("id", "bigint"));
+  EXPECT_EQ(column.getName(), "id");
+  EXPECT_EQ(column.getType(), "bigint");
+  EXPECT_EQ(column.getRawType(), "bigint");
+  EXPECT_TRUE(column.getTypeArguments().empty());
+}
+
+TEST(ColumnDescriptionTest, DecimalArguments) {
+  ColumnDescription column(columnInfoFromTypeText("price", "decimal(12, 2)"));
+  EXPECT_EQ(column.getRawType(), "decimal");
+  ASSERT_EQ(column.getTypeArguments().size(), 2);
+  EXPECT_EQ(column.getTypeArguments()[0]["value"], 12);
+  EXPECT_EQ(column.getTypeArguments()[1]["value"], 2);
+}
+
+TEST(ColumnDescriptionTest, Varchar) {
+  ColumnDescription bounded(columnInfoFromTypeText("a", "varchar(25)"));
+  EXPECT_EQ(bounded.getRawType(), "varchar");
+  EXPECT_EQ(bounded.getTypeArguments()[0]["value"], 25);
+
+  ColumnDescription unbounded(columnInfoFromTypeText("b", "varchar"));
+  EXPECT_EQ(unbounded.getRawType(), "varchar");
+  EXPECT_EQ(unbounded.getTypeArguments()[0]["value"], 2147483647);
+}
+
+TEST(ColumnDescriptionTest, ArgumentsBeforeSuffix) {
+  ColumnDescription column(
+      columnInfoFromTypeText("ts", "timestamp(3) with time zone"));
+  EXPECT_EQ(column.getRawType(), "timestamp with time zone");
+  EXPECT_EQ(column.getTypeArguments()[0]["value"], 3);
+}
+
+TEST(ColumnDescriptionTest, NestedTypes) {
+  ColumnDescription column(
+      columnInfoFromTypeText("r", "row(a decimal(3,1), b array(integer))"));
+  EXPECT_EQ(column.getRawType(), "row");
+  ASSERT_EQ(column.getTypeArguments().size(), 2);
+  EXPECT_EQ(column.getTypeArguments()[0]["value"], "a decimal(3,1)");
+  EXPECT_EQ(column.getTypeArguments()[1]["value"], "b array(integer)");
+}
@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+
+#include "../../../src/trinoAPIWrapper/metadataCache.hpp"
+#include "../../fixtures/staticResults.hpp"
+
+TEST(MetadataCacheTest, DisabledByDefault) {
+  MetadataCache cache;
+  EXPECT_FALSE(cache.isEnabled());
+  cache.store("key", makeResult("value"));
+  EXPECT_EQ(cache.lookup("key"), nullptr);
+}
+
+TEST(MetadataCacheTest, StoresAndFinds) {
+  MetadataCache cache;
+  cache.configure(std::chrono::minutes(1), 10, false);
+  EXPECT_EQ(cache.lookup("key"), nullptr);
+  cache.store("key", makeResult("value"));
+  const StaticResult* found = cache.lookup("key");
+  ASSERT_NE(found, nullptr);
+  EXPECT_EQ(valueOf(*found), "value");
+}
+
+TEST(MetadataCacheTest, StoreReplacesEntry) {
+  MetadataCache cache;
+  cache.configure(std::chrono::minutes(1), 10, false);
+  cache.store("key", makeResult("old"));
+  cache.store("key", makeResult("new"));
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(valueOf(*cache.lookup("key")), "new");
+}
+
+TEST(MetadataCacheTest, EntriesExpire) {
+  MetadataCache cache;
+  cache.configure(std::chrono::milliseconds(10), 10, false);
+  cache.store("key", makeResult("value"));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(cache.lookup("key"), nullptr);
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(MetadataCacheTest, EvictsLeastRecentlyUsed) {
+  MetadataCache cache;
+  cache.configure(std::chrono::minutes(1), 2, false);
+  cache.store("a", makeResult("1"));
+  cache.store("b", makeResult("2"));
+  // Reading "a" makes "b" the least recently used entry.
+  EXPECT_NE(cache.lookup("a"), nullptr);
+  cache.store("c", makeResult("3"));
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_NE(cache.lookup("a"), nullptr);
+  EXPECT_EQ(cache.lookup("b"), nullptr);
+  EXPECT_NE(cache.lookup("c"), nullptr);
+}
+
+TEST(MetadataCacheTest, SchemaTakesOneEntry) {
+  MetadataCache cache;
+  cache.configure(std::chrono::minutes(1), 2, true);
+  std::map<std::string, StaticResult> tables;
+  tables["a"] = makeResult("1");
+  tables["b"] = makeResult("2");
+  tables["c"] = makeResult("3");
+  cache.storeSchema("schema", makeResult("all"), std::move(tables));
+  cache.store("other", makeResult("4"));
+  // More tables than the cache holds entries, and none were evicted.
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(valueOf(*cache.lookupTable("schema", "a")), "1");
+  EXPECT_EQ(valueOf(*cache.lookupTable("schema", "c")), "3");
+  EXPECT_EQ(cache.lookupTable("schema", "d"), nullptr);
+  EXPECT_EQ(valueOf(*cache.lookup("schema")), "all");
+  // A table isn't an entry of its own.
+  EXPECT_EQ(cache.lookup("a"), nullptr);
+}
+
+TEST(MetadataCacheTest, Invalidate) {
+  MetadataCache cache;
+  cache.configure(std::chrono::minutes(1), 10, false);
+  cache.store("a", makeResult("1"));
+  cache.store("b", makeResult("2"));
+  cache.invalidate();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.lookup("a"), nullptr);
+}
+
+TEST(MetadataCacheTest, PrefetchNeedsEnabledCache) {
+  MetadataCache cache;
+  cache.configure(std::chrono::seconds(0), 10, true);
+  EXPECT_FALSE(cache.getPrefetchSchemas());
+  cache.configure(std::chrono::minutes(1), 10, true);
+  EXPECT_TRUE(cache.getPrefetchSchemas());
+}
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../../src/trinoAPIWrapper/requestLoop.hpp"
+
+// Requests are for local files, which curl reads like any other URI,
+// so no server is needed.
+static std::string writeFile(const std::string& name,
+                             const std::string& text) {
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / ("trinoRequestLoop_" + name);
+  std::ofstream(path, std::ios::binary) << text;
+  std::string generic = path.generic_string();
+  // Windows paths start with a drive letter rather than a slash.
+  return generic.starts_with("/") ? "file://" + generic : "file:///" + generic;
+}
+
+static size_t
+curlWriteCallback(void* contents, size_t size, size_t nmemb, std::string* s) {
+  size_t totalSize = size * nmemb;
+  s->append(static_cast<char*>(contents), totalSize);
+  return totalSize;
+}
+
+static QueryTask fetchTwice(RequestLoop& loop,
+                            const std::string& uri,
+                            std::string& body,
+                            std::thread::id& resumedOn) {
+  CURL* curl = curl_easy_init();
+  curl_easy_setopt(curl, CURLOPT_URL, uri.c_str());
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlWriteCallback);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &body);
+  CURLcode first = co_await loop.perform(curl);
+  // The same handle goes around again once the loop gives it back.
+  CURLcode second = co_await loop.perform(curl);
+  resumedOn       = std::this_thread::get_id();
+  curl_easy_cleanup(curl);
+  if (first != CURLE_OK or second != CURLE_OK) {
+    throw std::runtime_error("Transfer failed");
+  }
+}
+
+static QueryTask pause(RequestLoop& loop,
+                       std::chrono::milliseconds length,
+                       const std::atomic<bool>* interrupt) {
+  co_await loop.sleepFor(length, interrupt);
+}
+
+TEST(RequestLoopTest, RunsTasksOnTheWaitingThread) {
+  RequestLoop loop;
+  std::string uri = writeFile("body", "[[1,2]]");
+  std::string body;
+  std::thread::id resumedOn;
+  fetchTwice(loop, uri, body, resumedOn).wait();
+  EXPECT_EQ(body, "[[1,2]][[1,2]]");
+  EXPECT_EQ(resumedOn, std::this_thread::get_id());
+}
+
+TEST(RequestLoopTest, RethrowsWhatTheTaskThrew) {
+  RequestLoop loop;
+  // Tasks don't start right away, so what they refer to has to last
+  // until they're waited on.
+  std::string uri = "file:///no/such/segment";
+  std::string body;
+  std::thread::id resumedOn;
+  QueryTask task = fetchTwice(loop, uri, body, resumedOn);
+  EXPECT_THROW(task.wait(), std::runtime_error);
+}
+
+TEST(RequestLoopTest, DrivesManyTasksAtOnce) {
+  RequestLoop loop;
+  std::string uri = writeFile("many", "row");
+  std::vector<std::string> bodies(64);
+  std::vector<std::thread> threads;
+  for (std::string& body : bodies) {
+    threads.emplace_back([&loop, &uri, &body]() {
+      std::thread::id resumedOn;
+      fetchTwice(loop, uri, body, resumedOn).wait();
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (const std::string& body : bodies) {
+    EXPECT_EQ(body, "rowrow");
+  }
+}
+
+TEST(RequestLoopTest, InterruptCutsPausesShort) {
+  RequestLoop loop;
+  std::atomic<bool> canceled = false;
+  auto start                 = std::chrono::steady_clock::now();
+  pause(loop, std::chrono::milliseconds(50), &canceled).wait();
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(50));
+
+  std::thread canceler([&loop, &canceled]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    canceled = true;
+    loop.interrupt();
+  });
+  start = std::chrono::steady_clock::now();
+  pause(loop, std::chrono::seconds(30), &canceled).wait();
+  canceler.join();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST(RequestLoopTest, PerformsForCallersThatArentTasks) {
+  RequestLoop loop;
+  std::string uri = writeFile("plain", "done");
+  std::string body;
+  CURL* curl = curl_easy_init();
+  curl_easy_setopt(curl, CURLOPT_URL, uri.c_str());
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlWriteCallback);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &body);
+  EXPECT_EQ(loop.performAndWait(curl), CURLE_OK);
+  EXPECT_EQ(body, "done");
+  curl_easy_setopt(curl, CURLOPT_URL, "file:///no/such/segment");
+  EXPECT_NE(loop.performAndWait(curl), CURLE_OK);
+  curl_easy_cleanup(curl);
+}
@@ -0,0 +1,55 @@
+#include "gtest/gtest.h"
+#include <string>
+
+#include "../../../src/trinoAPIWrapper/responseBuffers.hpp"
+
+TEST(ResponseBuffersTest, KeepsOnlyHeadersTheDriverReads) {
+  ResponseHeaders headers;
+  headers.addLine("HTTP/1.1 401 Unauthorized\r\n");
+  headers.addLine("Content-Type: application/json\r\n");
+  headers.addLine("WWW-Authenticate: Bearer x_redirect_server=\"a\"\r\n");
+  headers.addLine("\r\n");
+  EXPECT_FALSE(headers.contains("content-type"));
+  ASSERT_TRUE(headers.contains("www-authenticate"));
+  EXPECT_EQ(headers.get("www-authenticate"), "Bearer x_redirect_server=\"a\"");
+  EXPECT_EQ(headers.get("content-type"), "");
+}
+
+TEST(ResponseBuffersTest, ReadsContentLength) {
+  ResponseHeaders headers;
+  headers.addLine("HTTP/1.1 100 Continue\r\n");
+  headers.addLine("content-length: 12\r\n");
+  EXPECT_EQ(headers.getContentLength(), 12);
+  // Only the final response's body counts.
+  headers.addLine("HTTP/1.1 200 OK\r\n");
+  EXPECT_EQ(headers.getContentLength(), 0);
+  headers.addLine("Content-Length: 53411\r\n");
+  EXPECT_EQ(headers.getContentLength(), 53411);
+  headers.clear();
+  EXPECT_EQ(headers.getContentLength(), 0);
+}
+
+TEST(ResponseBuffersTest, ReusesBuffers) {
+  ResponseBufferPool pool;
+  std::string buffer;
+  buffer.reserve(64 * 1024);
+  buffer.assign("[[1,2]]");
+  const char* storage = buffer.data();
+  pool.give(std::move(buffer));
+
+  std::string reused = pool.take();
+  EXPECT_TRUE(reused.empty());
+  EXPECT_GE(reused.capacity(), 64 * 1024);
+  EXPECT_EQ(reused.data(), storage);
+  // Nothing is left, so the next buffer starts out empty.
+  EXPECT_EQ(pool.take().capacity(), std::string().capacity());
+}
+
+TEST(ResponseBuffersTest, SkipsBuffersNotWorthKeeping) {
+  ResponseBufferPool pool;
+  pool.give(std::string("tiny"));
+  std::string huge;
+  huge.reserve(32 * 1024 * 1024);
+  pool.give(std::move(huge));
+  EXPECT_EQ(pool.take().capacity(), std::string().capacity());
+}
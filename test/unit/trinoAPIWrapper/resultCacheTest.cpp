@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+#include "../../../src/trinoAPIWrapper/resultCache.hpp"
+#include "../../fixtures/staticResults.hpp"
+
+static ResultCacheSettings settingsFor(std::chrono::seconds timeToLive) {
+  ResultCacheSettings settings;
+  settings.timeToLive = timeToLive;
+  settings.maxBytes   = 4000;
+  return settings;
+}
+
+TEST(ResultCacheTest, StoresAndFinds) {
+  ResultCache cache;
+  ResultCacheSettings settings = settingsFor(std::chrono::seconds(60));
+  cache.reserve(settings.maxBytes);
+  StaticResult found;
+  EXPECT_FALSE(cache.lookup("key", settings, found));
+  cache.store("key", settings, makeResult("value"), 100);
+  ASSERT_TRUE(cache.lookup("key", settings, found));
+  EXPECT_EQ(valueOf(found), "value");
+
+  ResultCacheCounters counters = cache.getCounters();
+  EXPECT_EQ(counters.hits, 1);
+  EXPECT_EQ(counters.misses, 1);
+  EXPECT_EQ(counters.stores, 1);
+}
+
+TEST(ResultCacheTest, TimeToLiveOfCallerApplies) {
+  ResultCache cache;
+  ResultCacheSettings settings = settingsFor(std::chrono::seconds(60));
+  cache.reserve(settings.maxBytes);
+  cache.store("key", settings, makeResult("value"), 100);
+  StaticResult found;
+  ResultCacheSettings expired = settingsFor(std::chrono::seconds(0));
+  EXPECT_FALSE(cache.lookup("key", expired, found));
+  // The expired entry is gone, even for callers with a longer TTL.
+  EXPECT_FALSE(cache.lookup("key", settings, found));
+}
+
+TEST(ResultCacheTest, SkipsResultsOverEntryLimit) {
+  ResultCache cache;
+  ResultCacheSettings settings = settingsFor(std::chrono::seconds(60));
+  cache.reserve(settings.maxBytes);
+  EXPECT_EQ(cache.getEntryByteLimit(), 1000);
+  cache.store("key", settings, makeResult("value"), 1001);
+  StaticResult found;
+  EXPECT_FALSE(cache.lookup("key", settings, found));
+}
+
+TEST(ResultCacheTest, EvictsLeastRecentlyUsed) {
+  ResultCache cache;
+  ResultCacheSettings settings = settingsFor(std::chrono::seconds(60));
+  cache.reserve(settings.maxBytes);
+  StaticResult found;
+  for (int i = 0; i < 4; i++) {
+    cache.store(std::to_string(i), settings, makeResult("v"), 1000);
+  }
+  // Reading "0" makes "1" the least recently used entry.
+  EXPECT_TRUE(cache.lookup("0", settings, found));
+  cache.store("4", settings, makeResult("v"), 1000);
+  EXPECT_TRUE(cache.lookup("0", settings, found));
+  EXPECT_FALSE(cache.lookup("1", settings, found));
+  EXPECT_TRUE(cache.lookup("4", settings, found));
+  EXPECT_EQ(cache.getCounters().evictions, 1);
+}
+
+TEST(ResultCacheTest, ReadsBackFromDisk) {
+  std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "trinoOdbcResultCacheTest";
+  std::filesystem::remove_all(directory);
+  ResultCacheSettings settings = settingsFor(std::chrono::seconds(60));
+  settings.diskDirectory       = directory.string();
+
+  ResultCache writer;
+  writer.reserve(settings.maxBytes);
+  writer.store("key", settings, makeResult("value"), 100);
+
+  // A fresh cache, like one in another process, finds it on disk.
+  ResultCache reader;
+  reader.reserve(settings.maxBytes);
+  StaticResult found;
+  ASSERT_TRUE(reader.lookup("key", settings, found));
+  EXPECT_EQ(valueOf(found), "value");
+  EXPECT_EQ(found.columns.size(), 1);
+  EXPECT_EQ(reader.getCounters().diskHits, 1);
+  EXPECT_FALSE(reader.lookup("other", settings, found));
+
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <string>
+
+#include "../../../src/trinoAPIWrapper/resultPage.hpp"
+
+static ResultPage makePage(const std::string& response,
+                           size_t columnCount = 0) {
+  ResponseParts parts = splitResponse(response, columnCount);
+  EXPECT_TRUE(parts.hasRows);
+  return ResultPage(std::string(response), std::move(parts.rows));
+}
+
+TEST(ResultPageTest, SplitsResponse) {
+  std::string text =
+      R"({"id":"q1","stats":{"data":[9]},"data":[[1,2]],"next":"x"})";
+  ResponseParts parts = splitResponse(text, 0);
+  ASSERT_TRUE(parts.hasRows);
+  EXPECT_EQ(parts.rows.rowCount, 1);
+  EXPECT_EQ(parts.rows.columnCount, 2);
+  EXPECT_FALSE(parts.envelope.contains("data"));
+  EXPECT_EQ(parts.envelope["id"], "q1");
+  EXPECT_EQ(parts.envelope["stats"]["data"][0], 9);
+  EXPECT_EQ(parts.envelope["next"], "x");
+}
+
+TEST(ResultPageTest, ResponseWithoutRows) {
+  ResponseParts parts = splitResponse(R"({"id":"q1","x":{"data":1}})", 0);
+  EXPECT_FALSE(parts.hasRows);
+  EXPECT_EQ(parts.envelope["x"]["data"], 1);
+  EXPECT_THROW(splitResponse("not json", 0), std::invalid_argument);
+}
+
+TEST(ResultPageTest, IgnoresKeyTextInsideStrings) {
+  std::string text    = R"({"id":"\"data\":[1]","data":[["a"]]})";
+  ResponseParts parts = splitResponse(text, 0);
+  ASSERT_TRUE(parts.hasRows);
+  EXPECT_EQ(parts.rows.rowCount, 1);
+  EXPECT_EQ(parts.envelope["id"], R"("data":[1])");
+}
+
+TEST(ResultPageTest, LeavesSpooledDataInEnvelope) {
+  ResponseParts parts =
+      splitResponse(R"({"data":{"encoding":"json","segments":[]}})", 0);
+  EXPECT_FALSE(parts.hasRows);
+  EXPECT_EQ(parts.envelope["data"]["encoding"], "json");
+}
+
+TEST(ResultPageTest, ColumnsInResponseSetColumnCount) {
+  EXPECT_THROW(
+      splitResponse(R"({"columns":[{"name":"a"},{"name":"b"}],"data":[[1]]})",
+                    0),
+      std::invalid_argument);
+}
+
+TEST(ResultPageTest, ReadsScalarCells) {
+  ResultPage page =
+      makePage(R"({"data":[[1,"one",null,true],[2,"two",3.5,false]]})");
+  ASSERT_EQ(page.getRowCount(), 2);
+  ASSERT_EQ(page.getColumnCount(), 4);
+  EXPECT_EQ(page.getCell(0, 0).get<int>(), 1);
+  EXPECT_EQ(page.getCell(0, 1).get<std::string>(), "one");
+  EXPECT_TRUE(page.getCell(0, 2).is_null());
+  EXPECT_TRUE(page.getCell(0, 3).get<bool>());
+  EXPECT_EQ(page.getCell(1, 0).get<int>(), 2);
+  EXPECT_EQ(page.getCell(1, 1).get<std::string>(), "two");
+  EXPECT_DOUBLE_EQ(page.getCell(1, 2).get<double>(), 3.5);
+  EXPECT_FALSE(page.getCell(1, 3).get<bool>());
+}
+
+TEST(ResultPageTest, ReadsNestedAndEscapedCells) {
+  ResultPage page = makePage(
+      R"({"data": [ [ [1,[2,3]] , {"k":"v]"} , "a\"b\\" ] ]})");
+  ASSERT_EQ(page.getRowCount(), 1);
+  ASSERT_EQ(page.getColumnCount(), 3);
+  EXPECT_EQ(page.getCell(0, 0), json::parse("[1,[2,3]]"));
+  EXPECT_EQ(page.getCell(0, 1)["k"].get<std::string>(), "v]");
+  EXPECT_EQ(page.getCell(0, 2).get<std::string>(), "a\"b\\");
+}
+
+TEST(ResultPageTest, DecodedColumnMatchesLazyCells) {
+  ResultPage page = makePage(R"({"data":[[1,"a"],[2,"b"],[3,"c"]]})");
+  page.decodeColumn(1);
+  EXPECT_EQ(page.getCell(2, 1).get<std::string>(), "c");
+  EXPECT_EQ(page.getCell(2, 0).get<int>(), 3);
+}
+
+TEST(ResultPageTest, EmptyData) {
+  ResultPage page = makePage(R"({"data":[]})", 2);
+  EXPECT_EQ(page.getRowCount(), 0);
+  EXPECT_EQ(page.getColumnCount(), 2);
+}
+
+TEST(ResultPageTest, RejectsRaggedRows) {
+  EXPECT_THROW(makePage(R"({"data":[[1,2],[3]]})"), std::invalid_argument);
+  EXPECT_THROW(makePage(R"({"data":[[1,2]]})", 3), std::invalid_argument);
+}
+
+TEST(ResultPageTest, RejectsMalformedRows) {
+  EXPECT_THROW(makePage(R"({"data":[[1,"unterminated]]})"),
+               std::invalid_argument);
+  EXPECT_THROW(makePage(R"({"data":[1,2]})"), std::invalid_argument);
+}
+
+TEST(ResultPageTest, BuildsFromDecodedRows) {
+  json rows = json::parse(R"([[1, "a", null], [2, "b", true]])");
+  ResultPage page(rows);
+  EXPECT_EQ(page.getRowCount(), 2);
+  EXPECT_EQ(page.getColumnCount(), 3);
+  EXPECT_EQ(page.getCell(0, 1), "a");
+  EXPECT_TRUE(page.getCell(0, 2).is_null());
+  EXPECT_EQ(page.getCell(1, 0), 2);
+  EXPECT_EQ(page.getCell(1, 2), true);
+}
+
+TEST(ResultPageTest, BuildsFromNoRows) {
+  ResultPage page(json::array());
+  EXPECT_EQ(page.getRowCount(), 0);
+}
+
+TEST(ResultPageTest, RejectsRaggedDecodedRows) {
+  json rows = json::parse(R"([[1, 2], [3]])");
+  EXPECT_THROW(ResultPage page(rows), std::invalid_argument);
+}
+
+TEST(ResultPageTest, ReadsSpilledCells) {
+  std::shared_ptr<SpillFile> file = SpillFile::create();
+  ASSERT_NE(file, nullptr);
+  ResultPage page = makePage(
+      R"({"data": [ [ 1, [2, 3], "a\"b" ], [ 4, {"k":"v"}, null ] ]})");
+  page.decodeColumn(0);
+  ASSERT_TRUE(page.spill(file));
+  EXPECT_TRUE(page.isSpilled());
+  EXPECT_EQ(page.getByteSize(), 0);
+  EXPECT_EQ(page.getRowCount(), 2);
+  EXPECT_EQ(page.getCell(0, 0).get<int>(), 1);
+  EXPECT_EQ(page.getCell(0, 1), json::parse("[2,3]"));
+  EXPECT_EQ(page.getCell(0, 2).get<std::string>(), "a\"b");
+  EXPECT_EQ(page.getCell(1, 0).get<int>(), 4);
+  EXPECT_EQ(page.getCell(1, 1)["k"].get<std::string>(), "v");
+  EXPECT_TRUE(page.getCell(1, 2).is_null());
+  // A page is only ever spilled once.
+  EXPECT_FALSE(page.spill(file));
+}
+
+TEST(ResultPageTest, SpillsPagesToOneFile) {
+  std::shared_ptr<SpillFile> file = SpillFile::create();
+  ASSERT_NE(file, nullptr);
+  ResultPage first  = makePage(R"({"data":[[1,"a"],[2,"b"]]})");
+  ResultPage second = makePage(R"({"data":[[3,"c"]]})");
+  ASSERT_TRUE(first.spill(file));
+  ASSERT_TRUE(second.spill(file));
+  second.prefetch();
+  EXPECT_EQ(second.getCell(0, 1).get<std::string>(), "c");
+  EXPECT_EQ(first.getCell(1, 1).get<std::string>(), "b");
+  EXPECT_EQ(first.getCell(0, 0).get<int>(), 1);
+}
+
+TEST(ResultPageTest, KeepsDecodedRowsInMemory) {
+  std::shared_ptr<SpillFile> file = SpillFile::create();
+  ASSERT_NE(file, nullptr);
+  ResultPage page(json::parse(R"([[1, "a"]])"));
+  EXPECT_FALSE(page.spill(file));
+  EXPECT_FALSE(page.isSpilled());
+  EXPECT_EQ(page.getCell(0, 1), "a");
+}
@@ -0,0 +1,223 @@
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <lz4.h>
+#include <stdexcept>
+#include <string>
+#include <zstd.h>
+
+#include "../../../src/trinoAPIWrapper/spooledSegments.hpp"
+
+// Segments are served from local files, which curl reads like any
+// other URI once the downloader is told to allow them, so no storage
+// server is needed.
+static std::string writeSegment(const std::string& name,
+                                const std::string& rows) {
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / ("trinoSegment_" + name);
+  std::ofstream(path, std::ios::binary) << rows;
+  std::string generic = path.generic_string();
+  // Windows paths start with a drive letter rather than a slash.
+  return generic.starts_with("/") ? "file://" + generic : "file:///" + generic;
+}
+
+// Enough rows that compressing them is worthwhile.
+static std::string manyRows() {
+  std::string rows = "[";
+  for (int i = 0; i < 5000; i++) {
+    rows += (i ? ",[" : "[") + std::to_string(i) + ",\"row\"]";
+  }
+  return rows + "]";
+}
+
+static std::string zstdCompress(const std::string& text) {
+  std::string compressed(ZSTD_compressBound(text.size()), '\0');
+  compressed.resize(ZSTD_compress(
+      compressed.data(), compressed.size(), text.data(), text.size(), 3));
+  return compressed;
+}
+
+static std::string lz4Compress(const std::string& text) {
+  std::string compressed(LZ4_compressBound(static_cast<int>(text.size())),
+                         '\0');
+  compressed.resize(LZ4_compress_default(text.data(),
+                                         compressed.data(),
+                                         static_cast<int>(text.size()),
+                                         static_cast<int>(compressed.size())));
+  return compressed;
+}
+
+static SpooledSegment spooledAt(const std::string& uri) {
+  SpooledSegment segment;
+  segment.uri = uri;
+  return segment;
+}
+
+TEST(SpooledSegmentsTest, ParsesInlineSegments) {
+  // The base64 encoding of [[1,"a"],[2,"b"]]
+  json data = json::parse(R"({
+    "encoding": "json",
+    "segments": [{
+      "type": "inline",
+      "data": "W1sxLCJhIl0sWzIsImIiXV0=",
+      "metadata": {"rowOffset": 0, "rowsCount": 2, "segmentSize": 17}
+    }]
+  })");
+  std::vector<SpooledSegment> segments = parseSpooledData(data);
+  ASSERT_EQ(segments.size(), 1);
+  EXPECT_TRUE(segments[0].isInline);
+  EXPECT_EQ(segments[0].data, R"([[1,"a"],[2,"b"]])");
+}
+
+TEST(SpooledSegmentsTest, ParsesSpooledSegments) {
+  json data = json::parse(R"({
+    "encoding": "json",
+    "segments": [{
+      "type": "spooled",
+      "uri": "https://storage/segment/1",
+      "ackUri": "https://coordinator/ack/1",
+      "headers": {"x-amz-server-side-encryption": ["AES256"]},
+      "metadata": {"rowOffset": 0, "rowsCount": 1000}
+    }]
+  })");
+  std::vector<SpooledSegment> segments = parseSpooledData(data);
+  ASSERT_EQ(segments.size(), 1);
+  EXPECT_FALSE(segments[0].isInline);
+  EXPECT_EQ(segments[0].uri, "https://storage/segment/1");
+  EXPECT_EQ(segments[0].ackUri, "https://coordinator/ack/1");
+  ASSERT_EQ(segments[0].headers.size(), 1);
+  EXPECT_EQ(segments[0].headers[0], "x-amz-server-side-encryption: AES256");
+}
+
+TEST(SpooledSegmentsTest, RejectsUnknownEncodings) {
+  json data = json::parse(R"({"encoding": "arrow", "segments": []})");
+  EXPECT_THROW(parseSpooledData(data), std::invalid_argument);
+}
+
+TEST(SpooledSegmentsTest, DownloadsSegmentsConcurrently) {
+  SegmentDownloader downloader(3, true);
+  auto abandoned = std::make_shared<std::atomic<bool>>(false);
+  std::vector<std::future<std::string>> rows;
+  for (int i = 0; i < 8; i++) {
+    std::string uri =
+        writeSegment(std::to_string(i), "[[" + std::to_string(i) + "]]");
+    rows.push_back(downloader.download(spooledAt(uri), abandoned));
+  }
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(rows[i].get(), "[[" + std::to_string(i) + "]]");
+  }
+}
+
+TEST(SpooledSegmentsTest, ReportsFailedDownloads) {
+  SegmentDownloader downloader(1, true);
+  auto abandoned = std::make_shared<std::atomic<bool>>(false);
+  std::future<std::string> rows = downloader.download(
+      spooledAt(writeSegment("missing", "") + "_not_there"), abandoned);
+  EXPECT_THROW(rows.get(), std::runtime_error);
+}
+
+TEST(SpooledSegmentsTest, OnlyFollowsHttpUnlessTold) {
+  SegmentDownloader downloader(1);
+  auto abandoned = std::make_shared<std::atomic<bool>>(false);
+  std::future<std::string> rows = downloader.download(
+      spooledAt(writeSegment("local", "[[1]]")), abandoned);
+  EXPECT_THROW(rows.get(), std::runtime_error);
+}
+
+TEST(SpooledSegmentsTest, SkipsAbandonedSegments) {
+  SegmentDownloader downloader(1, true);
+  auto abandoned = std::make_shared<std::atomic<bool>>(true);
+  std::future<std::string> rows = downloader.download(
+      spooledAt(writeSegment("abandoned", "[[1]]")), abandoned);
+  EXPECT_THROW(rows.get(), std::future_error);
+}
+
+TEST(SpooledSegmentsTest, OnlyCompressedSegmentsGiveTheirSize) {
+  json data = json::parse(R"({
+    "encoding": "json+zstd",
+    "segments": [
+      {"type": "spooled", "uri": "https://storage/1",
+       "metadata": {"rowsCount": 9000, "uncompressedSize": 250000}},
+      {"type": "spooled", "uri": "https://storage/2",
+       "metadata": {"rowsCount": 3, "segmentSize": 40}}
+    ]
+  })");
+  std::vector<SpooledSegment> segments = parseSpooledData(data);
+  ASSERT_EQ(segments.size(), 2);
+  EXPECT_EQ(segments[0].compression, SC_ZSTD);
+  EXPECT_EQ(segments[0].uncompressedSize, 250000);
+  EXPECT_EQ(segments[0].expectedSize, 250000);
+  EXPECT_EQ(segments[1].compression, SC_NONE);
+  EXPECT_EQ(segments[1].expectedSize, 40);
+}
+
+TEST(SpooledSegmentsTest, DecodesZstdAsItArrives) {
+  std::string rows       = manyRows();
+  std::string compressed = zstdCompress(rows);
+  SegmentDecoder decoder(SC_ZSTD, rows.size());
+  // Feed it the way a slow download would, a few bytes at a time.
+  for (size_t i = 0; i < compressed.size(); i += 7) {
+    decoder.write(compressed.data() + i,
+                  std::min<size_t>(7, compressed.size() - i));
+  }
+  EXPECT_EQ(decoder.finish(), rows);
+}
+
+TEST(SpooledSegmentsTest, RejectsTruncatedZstd) {
+  std::string rows       = manyRows();
+  std::string compressed = zstdCompress(rows);
+  compressed.resize(compressed.size() / 2);
+  EXPECT_THROW(decodeSegment(compressed, SC_ZSTD, rows.size()),
+               std::runtime_error);
+}
+
+TEST(SpooledSegmentsTest, DecodesLz4) {
+  std::string rows = manyRows();
+  EXPECT_EQ(decodeSegment(lz4Compress(rows), SC_LZ4, rows.size()), rows);
+  EXPECT_THROW(decodeSegment(lz4Compress(rows), SC_LZ4, rows.size() - 1),
+               std::runtime_error);
+}
+
+TEST(SpooledSegmentsTest, RejectsSegmentsOverTheLimit) {
+  // The size a server claims isn't allocated before it's checked.
+  EXPECT_THROW(decodeSegment("", SC_ZSTD, SIZE_MAX), std::runtime_error);
+
+  std::string rows = manyRows();
+  size_t limit     = rows.size() / 2;
+  // Segments that don't say how large they are still can't grow past
+  // the limit.
+  SegmentDecoder zstdDecoder(SC_ZSTD, 0, limit);
+  std::string compressed = zstdCompress(rows);
+  EXPECT_THROW(zstdDecoder.write(compressed.data(), compressed.size()),
+               std::runtime_error);
+  SegmentDecoder plainDecoder(SC_NONE, 0, limit);
+  EXPECT_THROW(plainDecoder.write(rows.data(), rows.size()),
+               std::runtime_error);
+  EXPECT_THROW(SegmentDecoder(SC_LZ4, rows.size(), limit), std::runtime_error);
+  // An lz4 block can't be larger than its rows could compress to.
+  SegmentDecoder lz4Decoder(SC_LZ4, 10, limit);
+  EXPECT_THROW(lz4Decoder.write(rows.data(), rows.size()), std::runtime_error);
+}
+
+TEST(SpooledSegmentsTest, DownloadsCompressedSegments) {
+  SegmentDownloader downloader(2, true);
+  auto abandoned   = std::make_shared<std::atomic<bool>>(false);
+  std::string rows = manyRows();
+
+  SpooledSegment zstdSegment =
+      spooledAt(writeSegment("zstd", zstdCompress(rows)));
+  zstdSegment.compression      = SC_ZSTD;
+  zstdSegment.uncompressedSize = rows.size();
+
+  SpooledSegment lz4Segment =
+      spooledAt(writeSegment("lz4", lz4Compress(rows)));
+  lz4Segment.compression      = SC_LZ4;
+  lz4Segment.uncompressedSize = rows.size();
+
+  std::future<std::string> zstdRows =
+      downloader.download(zstdSegment, abandoned);
+  std::future<std::string> lz4Rows = downloader.download(lz4Segment, abandoned);
+  EXPECT_EQ(zstdRows.get(), rows);
+  EXPECT_EQ(lz4Rows.get(), rows);
+}
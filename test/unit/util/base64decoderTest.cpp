@@ -65,3 +65,64 @@ TEST(Base64urlDecoderTest, SixChars) {
   std::string output   = fromBase64url(encodedA);
   EXPECT_EQ(output, decodedA);
 }
+
+static std::string decodeAll(const std::string& encoded) {
+  std::string output(base64DecodedSize(encoded), '\0');
+  unsigned char* outputPtr = reinterpret_cast<unsigned char*>(output.data());
+  size_t written = decodeBase64Range(encoded, 0, outputPtr, output.size());
+  output.resize(written);
+  return output;
+}
+
+TEST(Base64DecoderTest, DecodedSize) {
+  EXPECT_EQ(base64DecodedSize(""), 0);
+  EXPECT_EQ(base64DecodedSize("QQ=="), 1);
+  EXPECT_EQ(base64DecodedSize("QUE="), 2);
+  EXPECT_EQ(base64DecodedSize("QUFB"), 3);
+}
+
+TEST(Base64DecoderTest, DecodesPadding) {
+  EXPECT_EQ(decodeAll(""), "");
+  EXPECT_EQ(decodeAll("QQ=="), "A");
+  EXPECT_EQ(decodeAll("QUE="), "AA");
+  EXPECT_EQ(decodeAll("QUFB"), "AAA");
+}
+
+TEST(Base64DecoderTest, DecodesLongValue) {
+  // Long enough to use the 16 character block path, and includes
+  // every character class in the alphabet.
+  std::string encoded =
+      "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZz8+Pw==";
+  std::string decoded = "The quick brown fox jumps over the lazy dog?>?";
+  EXPECT_EQ(decodeAll(encoded), decoded);
+}
+
+TEST(Base64DecoderTest, DecodesInPieces) {
+  std::string encoded =
+      "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZz8+Pw==";
+  std::string decoded = "The quick brown fox jumps over the lazy dog?>?";
+  // Piece sizes that don't line up with quanta or blocks.
+  for (size_t pieceSize : {1, 2, 5, 7, 13}) {
+    std::string output;
+    unsigned char piece[13];
+    size_t offset = 0;
+    size_t written;
+    while ((written = decodeBase64Range(encoded, offset, piece, pieceSize)) >
+           0) {
+      output.append(reinterpret_cast<char*>(piece), written);
+      offset += written;
+    }
+    EXPECT_EQ(output, decoded);
+  }
+}
+
+TEST(Base64DecoderTest, RejectsInvalidCharacters) {
+  unsigned char output[32];
+  EXPECT_THROW(decodeBase64Range("QU-B", 0, output, 32),
+               std::invalid_argument);
+  EXPECT_THROW(decodeBase64Range("QQ==QUFB", 0, output, 32),
+               std::invalid_argument);
+  EXPECT_THROW(decodeBase64Range("QUFBQUFBQUFBQUFBQUF*QUFB", 0, output, 32),
+               std::invalid_argument);
+  EXPECT_THROW(decodeBase64Range("QUF", 0, output, 32), std::invalid_argument);
+}
@@ -0,0 +1,42 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <string_view>
+
+#include "../../../src/util/guidParser.hpp"
+
+TEST(GuidParserTest, ParsesFields) {
+  SQLGUID guid = {};
+  ASSERT_TRUE(parseGuid("00000001-0002-0003-4142-434445464748", guid));
+  EXPECT_EQ(guid.Data1, 1);
+  EXPECT_EQ(guid.Data2, 2);
+  EXPECT_EQ(guid.Data3, 3);
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(guid.Data4[i], 'A' + i);
+  }
+}
+
+TEST(GuidParserTest, ParsesMixedCaseHex) {
+  SQLGUID guid = {};
+  ASSERT_TRUE(parseGuid("DEADbeef-CafE-f00D-0123-456789abcdef", guid));
+  EXPECT_EQ(guid.Data1, 0xDEADBEEF);
+  EXPECT_EQ(guid.Data2, 0xCAFE);
+  EXPECT_EQ(guid.Data3, 0xF00D);
+  EXPECT_EQ(guid.Data4[0], 0x01);
+  EXPECT_EQ(guid.Data4[7], 0xEF);
+}
+
+TEST(GuidParserTest, RejectsBadLayout) {
+  SQLGUID guid = {};
+  EXPECT_FALSE(parseGuid("", guid));
+  EXPECT_FALSE(parseGuid("00000001-0002-0003-4142-43444546474", guid));
+  EXPECT_FALSE(parseGuid("00000001+0002-0003-4142-434445464748", guid));
+  EXPECT_FALSE(parseGuid("000000010002-0003-4142-434445464748-", guid));
+}
+
+TEST(GuidParserTest, RejectsNonHexDigits) {
+  SQLGUID guid = {};
+  EXPECT_FALSE(parseGuid("0000000g-0002-0003-4142-434445464748", guid));
+  EXPECT_FALSE(parseGuid("00000001-0002-0003-4142-43444546474:", guid));
+  EXPECT_FALSE(parseGuid("00000001-0002-0003-4142-43444546474G", guid));
+  EXPECT_FALSE(parseGuid("00000001-0002-0003-4142-4344454647\xC1" "8", guid));
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <string_view>
+#include <vector>
+
+#include "../../../src/util/parameterMarkers.hpp"
+
+TEST(ParameterMarkersTest, NoMarkers) {
+  EXPECT_TRUE(findParameterMarkers("").empty());
+  EXPECT_TRUE(findParameterMarkers("SELECT 1").empty());
+}
+
+TEST(ParameterMarkersTest, FindsMarkers) {
+  std::vector<size_t> expected = {32, 43};
+  EXPECT_EQ(
+      findParameterMarkers("SELECT * FROM t WHERE a = 1 AND ?=b OR c = ?"),
+      expected);
+}
+
+TEST(ParameterMarkersTest, SkipsStringLiterals) {
+  std::vector<size_t> expected = {25};
+  EXPECT_EQ(findParameterMarkers("SELECT '?', 'it''s ?' || ?"), expected);
+}
+
+TEST(ParameterMarkersTest, SkipsQuotedIdentifiers) {
+  std::vector<size_t> expected = {20};
+  EXPECT_EQ(findParameterMarkers("SELECT \"what?\" FROM ?"), expected);
+}
+
+TEST(ParameterMarkersTest, SkipsComments) {
+  std::vector<size_t> expected = {24};
+  EXPECT_EQ(findParameterMarkers("SELECT -- why?\n /* ? */ ?"), expected);
+}
+
+TEST(ParameterMarkersTest, UnterminatedSections) {
+  EXPECT_TRUE(findParameterMarkers("SELECT '?").empty());
+  EXPECT_TRUE(findParameterMarkers("SELECT /* ?").empty());
+  EXPECT_TRUE(findParameterMarkers("SELECT -- ?").empty());
+}
+
+TEST(ParameterMarkersTest, FindsInsertValuesRow) {
+  std::string_view text = "insert into t (a, b) values (?, lower(?));";
+  std::vector<size_t> markers = findParameterMarkers(text);
+  size_t rowBegin = 0;
+  size_t rowEnd   = 0;
+  ASSERT_TRUE(findInsertValuesRow(text, markers, rowBegin, rowEnd));
+  EXPECT_EQ(text.substr(rowBegin, rowEnd - rowBegin + 1), "(?, lower(?))");
+}
+
+TEST(ParameterMarkersTest, RejectsOtherInserts) {
+  std::vector<std::string_view> statements = {
+      "SELECT * FROM t WHERE a = ?",
+      "INSERT INTO t SELECT * FROM u WHERE a = ?",
+      "INSERT INTO t VALUES (?, 1), (2, ?)",
+      "INSERT INTO t VALUES (1, 2)",
+      "INSERT INTO t VALUES (?, ')'",
+      "UPDATE t SET a = 'insert values (?)' WHERE b = ?",
+  };
+  for (std::string_view text : statements) {
+    size_t rowBegin = 0;
+    size_t rowEnd   = 0;
+    EXPECT_FALSE(findInsertValuesRow(
+        text, findParameterMarkers(text), rowBegin, rowEnd))
+        << text;
+  }
+}
+
+TEST(ParameterMarkersTest, AppendsWithParameters) {
+  std::string_view text = "SELECT ?, '?', ?";
+  std::vector<size_t> markers = findParameterMarkers(text);
+  std::vector<std::pmr::string> literals = {"1", "'x'"};
+  std::string output;
+  appendWithParameters(output, text, 0, text.size(), markers, literals);
+  EXPECT_EQ(output, "SELECT 1, '?', 'x'");
+}
+
+TEST(ParameterMarkersTest, NormalizesStatementText) {
+  EXPECT_EQ(normalizeStatementText("  SELECT\n\ta,   b  FROM t ; "),
+            "SELECT a, b FROM t");
+  EXPECT_EQ(normalizeStatementText("SELECT 1 -- note\nFROM t"),
+            "SELECT 1 FROM t");
+  EXPECT_EQ(normalizeStatementText("SELECT/* note */1"), "SELECT 1");
+  EXPECT_EQ(normalizeStatementText("SELECT 'a  b', \"x  y\""),
+            "SELECT 'a  b', \"x  y\"");
+  EXPECT_EQ(normalizeStatementText("SELECT 'it''s'"), "SELECT 'it''s'");
+}
+
+TEST(ParameterMarkersTest, RecognizesReadOnlyStatements) {
+  EXPECT_TRUE(isReadOnlyStatement("SELECT 1"));
+  EXPECT_TRUE(isReadOnlyStatement("  select * from t"));
+  EXPECT_TRUE(isReadOnlyStatement("-- comment\nWITH a AS (SELECT 1) TABLE a"));
+  EXPECT_TRUE(isReadOnlyStatement("(SELECT 1) UNION (SELECT 2)"));
+  EXPECT_TRUE(isReadOnlyStatement("VALUES 1, 2"));
+  EXPECT_FALSE(isReadOnlyStatement("INSERT INTO t SELECT 1"));
+  EXPECT_FALSE(isReadOnlyStatement("CREATE TABLE t AS SELECT 1"));
+  EXPECT_FALSE(isReadOnlyStatement("SELECTED"));
+  EXPECT_FALSE(isReadOnlyStatement(""));
+}
+
+TEST(ParameterMarkersTest, AddsRowLimit) {
+  std::string limited;
+  ASSERT_TRUE(
+      addRowLimit("SELECT * FROM t ORDER BY a -- note\n;", 10, limited));
+  EXPECT_EQ(limited, "SELECT * FROM t ORDER BY a LIMIT 10");
+  ASSERT_TRUE(addRowLimit(
+      "WITH x AS (SELECT 1 LIMIT 5) SELECT * FROM x", 3, limited));
+  EXPECT_EQ(limited, "WITH x AS (SELECT 1 LIMIT 5) SELECT * FROM x LIMIT 3");
+  ASSERT_TRUE(addRowLimit("SELECT 'LIMIT' AS \"fetch\"", 1, limited));
+  EXPECT_EQ(limited, "SELECT 'LIMIT' AS \"fetch\" LIMIT 1");
+}
+
+TEST(ParameterMarkersTest, LeavesLimitedStatementsAlone) {
+  std::vector<std::string_view> statements = {
+      "SELECT * FROM t LIMIT 5",
+      "SELECT * FROM t ORDER BY a FETCH FIRST 5 ROWS ONLY",
+      "VALUES 1, 2",
+      "INSERT INTO t SELECT 1",
+      "SELECT 1; SELECT 2",
+  };
+  for (std::string_view text : statements) {
+    std::string limited;
+    EXPECT_FALSE(addRowLimit(text, 10, limited)) << text;
+  }
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+
+#include "../../../src/util/parameterToLiteral.hpp"
+
+static std::string render(SQLSMALLINT cDataType,
+                          SQLSMALLINT sqlDataType,
+                          const void* value,
+                          SQLLEN bufferLength = 0,
+                          const SQLLEN* strLenOrIndPtr = nullptr) {
+  std::pmr::string literal;
+  EXPECT_TRUE(parameterToLiteral(
+      cDataType, sqlDataType, value, bufferLength, strLenOrIndPtr, literal));
+  return std::string(literal);
+}
+
+TEST(ParameterToLiteralTest, Null) {
+  SQLLEN indicator = SQL_NULL_DATA;
+  EXPECT_EQ(render(SQL_C_CHAR, SQL_VARCHAR, nullptr, 0, &indicator), "NULL");
+}
+
+TEST(ParameterToLiteralTest, EscapesQuotes) {
+  const char text[] = "it's";
+  EXPECT_EQ(render(SQL_C_CHAR, SQL_VARCHAR, text), "'it''s'");
+  EXPECT_EQ(render(SQL_C_CHAR, SQL_VARCHAR, "'; DROP TABLE t; --"),
+            "'''; DROP TABLE t; --'");
+}
+
+TEST(ParameterToLiteralTest, CharacterLengths) {
+  const char text[] = "abcdef";
+  SQLLEN length     = 3;
+  EXPECT_EQ(render(SQL_C_CHAR, SQL_VARCHAR, text, sizeof(text), &length),
+            "'abc'");
+  SQLLEN nts = SQL_NTS;
+  EXPECT_EQ(render(SQL_C_CHAR, SQL_VARCHAR, text, sizeof(text), &nts),
+            "'abcdef'");
+  // Without a terminator, the buffer length bounds the value.
+  char unterminated[4] = {'w', 'x', 'y', 'z'};
+  EXPECT_EQ(render(SQL_C_CHAR, SQL_VARCHAR, unterminated, 4), "'wxyz'");
+}
+
+TEST(ParameterToLiteralTest, WideCharacters) {
+  const char16_t text[] = u"caf\u00e9";
+  EXPECT_EQ(render(SQL_C_WCHAR, SQL_WVARCHAR, text, sizeof(text)),
+            "'caf\xc3\xa9'");
+}
+
+TEST(ParameterToLiteralTest, Integers) {
+  SQLINTEGER value = -42;
+  EXPECT_EQ(render(SQL_C_SLONG, SQL_INTEGER, &value), "INTEGER '-42'");
+  SQLUBIGINT big = 18446744073709551615ULL;
+  EXPECT_EQ(render(SQL_C_UBIGINT, SQL_DECIMAL, &big),
+            "DECIMAL '18446744073709551615'");
+  unsigned char bit = 1;
+  EXPECT_EQ(render(SQL_C_BIT, SQL_BIT, &bit), "BOOLEAN '1'");
+  // Numbers bound to character columns are plain strings.
+  EXPECT_EQ(render(SQL_C_SLONG, SQL_VARCHAR, &value), "'-42'");
+}
+
+TEST(ParameterToLiteralTest, FloatingPoint) {
+  SQLDOUBLE value = 0.1;
+  EXPECT_EQ(render(SQL_C_DOUBLE, SQL_DOUBLE, &value), "DOUBLE '0.1'");
+  SQLREAL real = 1.5f;
+  EXPECT_EQ(render(SQL_C_FLOAT, SQL_REAL, &real), "REAL '1.5'");
+  SQLDOUBLE infinity = -HUGE_VAL;
+  EXPECT_EQ(render(SQL_C_DOUBLE, SQL_DOUBLE, &infinity), "DOUBLE '-Infinity'");
+}
+
+TEST(ParameterToLiteralTest, Numeric) {
+  SQL_NUMERIC_STRUCT numeric = {};
+  numeric.precision          = 5;
+  numeric.scale              = 2;
+  numeric.sign               = 0;
+  // 12345 = 0x3039, little endian.
+  numeric.val[0] = 0x39;
+  numeric.val[1] = 0x30;
+  EXPECT_EQ(render(SQL_C_NUMERIC, SQL_DECIMAL, &numeric),
+            "DECIMAL '-123.45'");
+  numeric.sign  = 1;
+  numeric.scale = 6;
+  EXPECT_EQ(render(SQL_C_NUMERIC, SQL_DECIMAL, &numeric),
+            "DECIMAL '0.012345'");
+}
+
+TEST(ParameterToLiteralTest, DatesAndTimes) {
+  SQL_DATE_STRUCT date = {2024, 2, 9};
+  EXPECT_EQ(render(SQL_C_TYPE_DATE, SQL_TYPE_DATE, &date),
+            "DATE '2024-02-09'");
+  SQL_TIME_STRUCT time = {7, 5, 3};
+  EXPECT_EQ(render(SQL_C_TYPE_TIME, SQL_TYPE_TIME, &time), "TIME '07:05:03'");
+  SQL_TIMESTAMP_STRUCT ts = {2024, 12, 31, 23, 59, 58, 120000000};
+  EXPECT_EQ(render(SQL_C_TYPE_TIMESTAMP, SQL_TYPE_TIMESTAMP, &ts),
+            "TIMESTAMP '2024-12-31 23:59:58.12'");
+}
+
+TEST(ParameterToLiteralTest, Guid) {
+  SQLGUID guid = {0x01234567, 0x89ab, 0xcdef, {1, 2, 3, 4, 5, 6, 7, 8}};
+  EXPECT_EQ(render(SQL_C_GUID, SQL_GUID, &guid),
+            "UUID '01234567-89ab-cdef-0102-030405060708'");
+}
+
+TEST(ParameterToLiteralTest, Binary) {
+  unsigned char bytes[] = {0xCA, 0xFE, 0x00, 0x27};
+  SQLLEN length         = sizeof(bytes);
+  EXPECT_EQ(render(SQL_C_BINARY, SQL_VARBINARY, bytes, length, &length),
+            "X'CAFE0027'");
+
+  // Bytes bound to a character type aren't text, and aren't sent as it.
+  std::pmr::string literal;
+  EXPECT_FALSE(parameterToLiteral(
+      SQL_C_BINARY, SQL_VARCHAR, bytes, length, &length, literal));
+  SQLLEN indicator = SQL_NULL_DATA;
+  EXPECT_EQ(render(SQL_C_BINARY, SQL_VARCHAR, nullptr, 0, &indicator), "NULL");
+}
+
+TEST(ParameterToLiteralTest, StaysInItsMemoryResource) {
+  // An arena that can't grow, so anything built elsewhere and copied in
+  // would still work, but anything allocated outside of it would throw.
+  std::array<std::byte, 1024> buffer;
+  std::pmr::monotonic_buffer_resource arena(
+      buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+  std::pmr::string literal(&arena);
+  SQL_TIMESTAMP_STRUCT ts = {2024, 12, 31, 23, 59, 58, 120000000};
+  EXPECT_TRUE(parameterToLiteral(
+      SQL_C_TYPE_TIMESTAMP, SQL_TYPE_TIMESTAMP, &ts, 0, nullptr, literal));
+  EXPECT_EQ(literal, "TIMESTAMP '2024-12-31 23:59:58.12'");
+  std::string text(100, 'x');
+  SQLLEN length = static_cast<SQLLEN>(text.size());
+  EXPECT_TRUE(parameterToLiteral(
+      SQL_C_CHAR, SQL_VARCHAR, text.data(), length, &length, literal));
+  EXPECT_EQ(std::string(literal), "'" + text + "'");
+}
+
+TEST(ParameterToLiteralTest, Unsupported) {
+  std::pmr::string literal;
+  SQLINTEGER value       = 1;
+  SQLLEN dataAtExecution = SQL_DATA_AT_EXEC;
+  EXPECT_FALSE(parameterToLiteral(
+      SQL_C_CHAR, SQL_VARCHAR, "x", 2, &dataAtExecution, literal));
+  EXPECT_FALSE(parameterToLiteral(
+      SQL_C_DEFAULT, SQL_INTEGER, &value, 0, nullptr, literal));
+}
+
+TEST(ParameterToLiteralTest, CDataTypeSizes) {
+  EXPECT_EQ(cDataTypeSize(SQL_C_CHAR), 0);
+  EXPECT_EQ(cDataTypeSize(SQL_C_SLONG), 4);
+  EXPECT_EQ(cDataTypeSize(SQL_C_SBIGINT), 8);
+  EXPECT_EQ(cDataTypeSize(SQL_C_TYPE_TIMESTAMP), sizeof(SQL_TIMESTAMP_STRUCT));
+}
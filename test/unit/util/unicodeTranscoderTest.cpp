@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include <string>
+
+#include "../../../src/util/unicodeTranscoder.hpp"
+
+TEST(UnicodeTranscoderTest, EmptyString) {
+  EXPECT_EQ(utf8ToUtf16(std::string("")), u"");
+  EXPECT_EQ(utf16ToUtf8(u"", 0), "");
+}
+
+TEST(UnicodeTranscoderTest, ShortAscii) {
+  EXPECT_EQ(utf8ToUtf16(std::string("abc")), u"abc");
+}
+
+TEST(UnicodeTranscoderTest, LongAscii) {
+  // Long enough to go through the vectorized path more than once,
+  // with a remainder for the scalar path.
+  std::string input = "SELECT column_name FROM system.jdbc.columns";
+  std::u16string expected(input.begin(), input.end());
+  EXPECT_EQ(utf8ToUtf16(input), expected);
+  EXPECT_EQ(utf16ToUtf8(expected.data(), expected.size()), input);
+}
+
+TEST(UnicodeTranscoderTest, MultiByte) {
+  // Two byte (e acute) and three byte (euro sign) sequences surrounded by ASCII runs.
+  std::string input = "caf\xC3\xA9 costs 5\xE2\x82\xAC, please pay at the till";
+  std::u16string expected = u"caf\u00E9 costs 5\u20AC, please pay at the till";
+  EXPECT_EQ(utf8ToUtf16(input), expected);
+  EXPECT_EQ(utf16ToUtf8(expected.data(), expected.size()), input);
+}
+
+TEST(UnicodeTranscoderTest, SurrogatePair) {
+  // U+1F600 needs four bytes in UTF-8 and a surrogate pair in UTF-16.
+  std::string input       = "\xF0\x9F\x98\x80";
+  std::u16string expected = u"\xD83D\xDE00";
+  EXPECT_EQ(utf8ToUtf16(input), expected);
+  EXPECT_EQ(utf16ToUtf8(expected.data(), expected.size()), input);
+}
+
+TEST(UnicodeTranscoderTest, InvalidUtf8IsReplaced) {
+  // A lone continuation byte, an overlong encoding, and a truncated
+  // sequence at the end of the input.
+  EXPECT_EQ(utf8ToUtf16(std::string("a\x80z")), u"a\uFFFDz");
+  EXPECT_EQ(utf8ToUtf16(std::string("\xC0\xAF")), u"\uFFFD\uFFFD");
+  EXPECT_EQ(utf8ToUtf16(std::string("ab\xE2\x82")), u"ab\uFFFD\uFFFD");
+}
+
+TEST(UnicodeTranscoderTest, UnpairedSurrogateIsReplaced) {
+  std::u16string input = u"a";
+  input.push_back(static_cast<char16_t>(0xD800));
+  input.push_back(u'b');
+  EXPECT_EQ(utf16ToUtf8(input.data(), input.size()), "a\xEF\xBF\xBD" "b");
+}
+
+TEST(UnicodeTranscoderTest, MeasureWithoutOutput) {
+  std::string input = "\xF0\x9F\x98\x80 and some more ascii text";
+  size_t required   = utf8ToUtf16(input.data(), input.size(), nullptr, 0);
+  EXPECT_EQ(required, utf8ToUtf16(input).size());
+}
+
+TEST(UnicodeTranscoderTest, TruncatedOutputReportsFullLength) {
+  std::string input = "0123456789abcdefghijklmnopqrstuvwxyz";
+  char16_t output[10];
+  size_t required = utf8ToUtf16(input.data(), input.size(), output, 10);
+  EXPECT_EQ(required, input.size());
+  EXPECT_EQ(std::u16string(output, 10), u"0123456789");
+}